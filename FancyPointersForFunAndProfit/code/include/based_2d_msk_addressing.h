@@ -50,6 +50,8 @@ class alignas(sizeof(std::uint64_t)) based_2d_msk_addressing_model
     based_2d_msk_addressing_model&  operator =(std::nullptr_t) noexcept;
 
     void*       address() const noexcept;
+    template<class PIN>
+    void*       address(PIN const& pin) const noexcept;
     size_type   offset() const noexcept;
     size_type   segment() const noexcept;
 
@@ -125,6 +127,16 @@ based_2d_msk_addressing_model<SM>::address() const noexcept
     return SM::segment_address(m_bits.m_segment) + (m_addr & offset_mask);
 }
 
+//- Resolves the address using a segment_pin<SM> snapshot of the segment table.
+//
+template<typename SM>
+template<class PIN> inline
+void*
+based_2d_msk_addressing_model<SM>::address(PIN const& pin) const noexcept
+{
+    return pin.segment_address(m_bits.m_segment) + (m_addr & offset_mask);
+}
+
 //------
 //
 template<typename SM> inline
@@ -212,30 +224,15 @@ based_2d_msk_addressing_model<SM>::less_than(based_2d_msk_addressing_model const
 
 //------
 //
-template<typename SM>
+template<typename SM> inline
 void
 based_2d_msk_addressing_model<SM>::assign_from(void const* p)
 {
-    char const*     pdata = static_cast<char const*>(p);
+    char const*     pdata   = static_cast<char const*>(p);
+    size_type       segment = SM::segment_index(p);
 
-    for (size_type i = SM::first_segment_index();  i <= SM::last_segment_index();  ++i)
-    {
-        char const*     pbottom = SM::segment_address(i);
-
-        if (pbottom != nullptr)
-        {
-            char const*     ptop = pbottom + SM::segment_size(i);
-
-            if (pbottom <= pdata  &&  pdata < ptop)
-            {
-                m_addr           = pdata - pbottom;
-                m_bits.m_segment = static_cast<uint16_t>(i);
-                return;
-            }
-        }
-    }
-
-    m_addr = pdata - static_cast<char const*>(nullptr);
+    m_addr           = pdata - static_cast<char const*>(SM::segment_address(segment));
+    m_bits.m_segment = static_cast<uint16_t>(segment);
 }
 
 //------
@@ -48,6 +48,8 @@ class alignas(2*sizeof(std::uint64_t)) based_2d_xl_addressing_model
     based_2d_xl_addressing_model&  operator =(std::nullptr_t) noexcept;
 
     void*       address() const noexcept;
+    template<class PIN>
+    void*       address(PIN const& pin) const noexcept;
     size_type   offset() const noexcept;
     size_type   segment() const noexcept;
 
@@ -106,6 +108,16 @@ based_2d_xl_addressing_model<SM>::address() const noexcept
     return SM::segment_address(m_segment) + m_offset;
 }
 
+//- Resolves the address using a segment_pin<SM> snapshot of the segment table.
+//
+template<typename SM>
+template<class PIN> inline
+void*
+based_2d_xl_addressing_model<SM>::address(PIN const& pin) const noexcept
+{
+    return pin.segment_address(m_segment) + m_offset;
+}
+
 //------
 //
 template<typename SM> inline
@@ -193,30 +205,18 @@ based_2d_xl_addressing_model<SM>::less_than(based_2d_xl_addressing_model const&
 
 //------
 //
-template<typename SM>
+template<typename SM> inline
 void
 based_2d_xl_addressing_model<SM>::assign_from(void const* p)
 {
-    char const*     pdata = static_cast<char const*>(p);
-
-    for (size_type segment_index = SM::first_segment_index();  segment_index <= SM::last_segment_index();  ++segment_index)
-    {
-        char const*     pbottom = SM::segment_address(segment_index);
-
-        if (pbottom != nullptr)
-        {
-            char const*     ptop = pbottom + SM::segment_size(segment_index);
-
-            if (pbottom <= pdata  &&  pdata < ptop)
-            {
-                m_offset  = pdata - pbottom;
-                m_segment = segment_index;
-                return;
-            }
-        }
-    }
-    m_segment = 0;
-    m_offset  = pdata - static_cast<char const*>(nullptr);
+    char const*     pdata   = static_cast<char const*>(p);
+    size_type       segment = SM::segment_index(p);
+
+    //- Segment 0 has a null base address, so a pointer that is not in any segment is stored
+    //  unchanged as an offset from null.
+    //
+    m_offset  = pdata - static_cast<char const*>(SM::segment_address(segment));
+    m_segment = segment;
 }
 
 //------
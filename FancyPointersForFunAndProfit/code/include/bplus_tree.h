@@ -0,0 +1,713 @@
+//==================================================================================================
+//  File:
+//      bplus_tree.h
+//
+//  Summary:
+//      Defines an ordered map, implemented as a B+tree with wide nodes linked by synthetic
+//      pointers, for use with the relocatable allocation strategies.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef BPLUS_TREE_H_DEFINED
+#define BPLUS_TREE_H_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#include "rhx_allocator.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      bplus_key_search<K, Compare>
+//
+//  Summary:
+//      This class template counts the keys in a node's sorted key array that are less than, or
+//      not greater than, a given key.  The count is the index of the slot or child to visit, and
+//      is computed without branching on the comparisons, so that a search costs the same no
+//      matter where the key falls.
+//
+//      For 64-bit integer keys ordered by std::less, the keys are compared several at a time:
+//      four to a register with AVX2, and otherwise two to a register with SSE2, which lacks a
+//      64-bit compare and so synthesizes one from 32-bit compares.  The vector loops may read up
+//      to three keys past the end of the array; the node layouts place other members there.
+//--------------------------------------------------------------------------------------------------
+//
+template<class K, class Compare>
+class bplus_key_search
+{
+  public:
+    using size_type = std::size_t;
+
+#if defined(__SSE2__)
+    static constexpr bool   vectorized = std::is_integral<K>::value  &&  sizeof(K) == 8  &&
+                                         std::is_same<Compare, std::less<K>>::value;
+#else
+    static constexpr bool   vectorized = false;
+#endif
+
+    static  size_type   count_less(K const* keys, size_type n, K const& key, Compare const& cmp) noexcept;
+    static  size_type   count_not_greater(K const* keys, size_type n, K const& key, Compare const& cmp) noexcept;
+
+  private:
+    template<bool Less>
+    static  size_type   vector_count(K const* keys, size_type n, K const& key) noexcept;
+};
+
+//------
+//
+template<class K, class C> inline
+typename bplus_key_search<K, C>::size_type
+bplus_key_search<K, C>::count_less(K const* keys, size_type n, K const& key, C const& cmp) noexcept
+{
+    if constexpr (vectorized)
+    {
+        return vector_count<true>(keys, n, key);
+    }
+    else
+    {
+        size_type   count = 0;
+
+        for (size_type i = 0;  i < n;  ++i)
+        {
+            count += cmp(keys[i], key) ? 1 : 0;
+        }
+        return count;
+    }
+}
+
+template<class K, class C> inline
+typename bplus_key_search<K, C>::size_type
+bplus_key_search<K, C>::count_not_greater(K const* keys, size_type n, K const& key, C const& cmp) noexcept
+{
+    if constexpr (vectorized)
+    {
+        return vector_count<false>(keys, n, key);
+    }
+    else
+    {
+        size_type   count = 0;
+
+        for (size_type i = 0;  i < n;  ++i)
+        {
+            count += cmp(key, keys[i]) ? 0 : 1;
+        }
+        return count;
+    }
+}
+
+//------
+//- Compares key with every key in the array, collecting a bit per lane that is set where the
+//  array's key is less than key (Less) or greater than key (!Less); the bits for lanes at or
+//  beyond n are masked off at the end, and n is always less than 64.
+//
+template<class K, class C>
+template<bool Less> inline
+typename bplus_key_search<K, C>::size_type
+bplus_key_search<K, C>::vector_count(K const* keys, size_type n, K const& key) noexcept
+{
+#if defined(__AVX2__)
+    //- Unsigned keys are biased by 2^63, so that the signed compare orders them correctly.
+    //
+    std::uint64_t const     bias  = std::is_signed<K>::value ? 0 : 0x8000'0000'0000'0000u;
+    __m256i const           vbias = _mm256_set1_epi64x((long long) bias);
+    __m256i const           vkey  = _mm256_set1_epi64x((long long)((std::uint64_t) key ^ bias));
+    std::uint64_t           bits  = 0;
+
+    for (size_type i = 0;  i < n;  i += 4)
+    {
+        __m256i     vk = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(keys + i)), vbias);
+        __m256i     gt = Less ? _mm256_cmpgt_epi64(vkey, vk) : _mm256_cmpgt_epi64(vk, vkey);
+
+        bits |= (std::uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(gt)) << i;
+    }
+#elif defined(__SSE2__)
+    //- A 64-bit a > b is (a.hi > b.hi) | (a.hi == b.hi & a.lo > b.lo), where the high halves are
+    //  compared signed or unsigned as K is, and the low halves are always compared unsigned.  The
+    //  bias makes every 32-bit compare that should be unsigned into a signed one.
+    //
+    std::uint64_t const     bias  = std::is_signed<K>::value ? 0x0000'0000'8000'0000u : 0x8000'0000'8000'0000u;
+    __m128i const           vbias = _mm_set1_epi64x((long long) bias);
+    __m128i const           vkey  = _mm_set1_epi64x((long long)((std::uint64_t) key ^ bias));
+    std::uint64_t           bits  = 0;
+
+    for (size_type i = 0;  i < n;  i += 2)
+    {
+        __m128i     vk = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(keys + i)), vbias);
+        __m128i     a  = Less ? vkey : vk;
+        __m128i     b  = Less ? vk : vkey;
+        __m128i     g  = _mm_cmpgt_epi32(a, b);
+        __m128i     e  = _mm_cmpeq_epi32(a, b);
+        __m128i     gt = _mm_or_si128(_mm_shuffle_epi32(g, _MM_SHUFFLE(3, 3, 1, 1)),
+                                      _mm_and_si128(_mm_shuffle_epi32(e, _MM_SHUFFLE(3, 3, 1, 1)),
+                                                    _mm_shuffle_epi32(g, _MM_SHUFFLE(2, 2, 0, 0))));
+
+        bits |= (std::uint64_t) _mm_movemask_pd(_mm_castsi128_pd(gt)) << i;
+    }
+#else
+    //- Not reached (vectorized is false), but the body must still compile without SSE2.
+    //
+    std::uint64_t   bits = 0;
+
+    for (size_type i = 0;  i < n;  ++i)
+    {
+        bits |= (std::uint64_t) (Less ? (keys[i] < key) : (key < keys[i])) << i;
+    }
+#endif
+    //- The keys are sorted, so the set bits form a run at the bottom (Less) or at the top (!Less)
+    //  of the first n bits; the index of the first key not in the run is a single bit scan.
+    //
+    bits &= ((std::uint64_t) 1 << n) - 1;
+    bits  = Less ? ~bits : (bits | ((std::uint64_t) 1 << n));
+
+#if defined(_MSC_VER)
+    unsigned long   bit;
+
+    if (!_BitScanForward(&bit, (unsigned long) bits))
+    {
+        _BitScanForward(&bit, (unsigned long) (bits >> 32));
+        bit += 32;
+    }
+    return (size_type) bit;
+#else
+    return (size_type) __builtin_ctzll(bits);
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      bplus_tree<K, V, AS, Compare, NodeBytes>
+//
+//  Summary:
+//      This class template implements an ordered map from K to V as a B+tree whose nodes are
+//      allocated by allocation strategy AS, through rhx_allocator, and linked by AS's synthetic
+//      pointers.  Every node is at most NodeBytes long, so that with the default a node spans
+//      eight cache lines and holds some thirty keys, where a red-black tree would hold one key
+//      and three pointers per node.  A search therefore visits a few nodes rather than a few
+//      dozen, resolves one synthetic pointer per level, and requests all of a node's cache
+//      lines together.
+//
+//      Inner nodes hold sorted separator keys and one more child than keys; a separator is the
+//      smallest key in the subtree to its right.  Leaves hold sorted keys and their values, in
+//      separate arrays so that the keys may be searched with vector compares, and are linked in
+//      key order for range scans.  The height of the tree is kept in the tree object, so that
+//      nodes need not record whether they are leaves.
+//
+//      Keys and values must be trivially copyable, since they are moved within and between
+//      nodes with memmove().  Erasure removes the entry from its leaf but does not merge
+//      underfull leaves, which suits indexes that rarely shrink; the tree remains correct, and
+//      emptied leaves are reused by later insertions into their key range.
+//
+//      find() returns a native pointer to the value, or null; like any native pointer into the
+//      segments, it is invalidated by relocation, and also by any insertion.
+//--------------------------------------------------------------------------------------------------
+//
+template<class K, class V, class AS, class Compare = std::less<K>, std::size_t NodeBytes = 512>
+class bplus_tree
+{
+  public:
+    using key_type      = K;
+    using mapped_type   = V;
+    using key_compare   = Compare;
+    using size_type     = std::size_t;
+
+  public:
+    ~bplus_tree();
+
+    bplus_tree();
+    bplus_tree(bplus_tree const&) = delete;
+    bplus_tree&     operator =(bplus_tree const&) = delete;
+
+    size_type   size() const noexcept;
+    size_type   height() const noexcept;
+    bool        empty() const noexcept;
+
+    V*          find(K const& key);
+    V const*    find(K const& key) const;
+    bool        contains(K const& key) const;
+
+    template<class... Args>
+    bool        try_emplace(K const& key, Args&&... args);
+    V&          operator [](K const& key);
+    bool        erase(K const& key);
+
+    void        clear();
+
+    template<class F>
+    void        for_each(F&& f) const;
+    template<class F>
+    void        for_each_in(K const& first, K const& last, F&& f) const;
+
+  private:
+    static_assert(std::is_trivially_copyable<K>::value  &&  std::is_trivially_copyable<V>::value,
+                  "bplus_tree keys and values must be trivially copyable");
+
+    using void_pointer = typename AS::void_pointer;
+    using search       = bplus_key_search<K, Compare>;
+
+    struct leaf_node;
+    struct inner_node;
+
+    using leaf_pointer  = typename AS::template rebind_pointer<leaf_node>;
+    using inner_pointer = typename AS::template rebind_pointer<inner_node>;
+
+    enum : size_type
+    {
+        leaf_capacity  = (NodeBytes - 2 * sizeof(void_pointer)) / (sizeof(K) + sizeof(V)),
+        inner_capacity = (NodeBytes - sizeof(K) - sizeof(void_pointer)) / (sizeof(K) + sizeof(void_pointer)),
+        max_height     = 32
+    };
+
+    struct leaf_node
+    {
+        std::uint32_t   m_count;
+        leaf_pointer    m_next;
+        K               m_keys[leaf_capacity];
+        V               m_values[leaf_capacity];
+    };
+
+    struct inner_node
+    {
+        std::uint32_t   m_count;            //- Number of keys; there is one more child
+        K               m_keys[inner_capacity];
+        void_pointer    m_children[inner_capacity + 1];
+    };
+
+    static_assert(sizeof(leaf_node) <= NodeBytes  &&  sizeof(inner_node) <= NodeBytes,
+                  "bplus_tree node layout exceeds NodeBytes");
+    static_assert(leaf_capacity >= 4  &&  inner_capacity >= 4  &&  leaf_capacity < 64  &&  inner_capacity < 64,
+                  "bplus_tree NodeBytes gives too few or too many keys per node");
+    static_assert(!search::vectorized  ||  (leaf_capacity * sizeof(V) >= 24  &&  (inner_capacity + 1) * sizeof(void_pointer) >= 24),
+                  "bplus_tree vector search would read beyond a node");
+
+    void_pointer    mp_root;
+    leaf_pointer    mp_first;
+    size_type       m_size;
+    size_type       m_height;       //- Zero when empty, one when the root is a leaf
+    Compare         m_cmp;
+
+    static  void    prefetch(void const* p) noexcept;
+
+    leaf_node*      find_leaf(K const& key) const;
+    leaf_pointer    new_leaf();
+    inner_pointer   new_inner();
+    void            insert_into_parents(inner_node** path, size_type const* slots, size_type depth,
+                                        K sep, void_pointer right);
+    void            destroy(void_pointer p, size_type height) noexcept;
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Facility:   bplus_tree<K, V, AS, Compare, NodeBytes> implementation
+//--------------------------------------------------------------------------------------------------
+//
+template<class K, class V, class AS, class C, std::size_t NB> inline
+bplus_tree<K, V, AS, C, NB>::~bplus_tree()
+{
+    clear();
+}
+
+template<class K, class V, class AS, class C, std::size_t NB> inline
+bplus_tree<K, V, AS, C, NB>::bplus_tree()
+:   mp_root(nullptr)
+,   mp_first(nullptr)
+,   m_size(0)
+,   m_height(0)
+,   m_cmp()
+{}
+
+//------
+//
+template<class K, class V, class AS, class C, std::size_t NB> inline
+typename bplus_tree<K, V, AS, C, NB>::size_type
+bplus_tree<K, V, AS, C, NB>::size() const noexcept
+{
+    return m_size;
+}
+
+template<class K, class V, class AS, class C, std::size_t NB> inline
+typename bplus_tree<K, V, AS, C, NB>::size_type
+bplus_tree<K, V, AS, C, NB>::height() const noexcept
+{
+    return m_height;
+}
+
+template<class K, class V, class AS, class C, std::size_t NB> inline
+bool
+bplus_tree<K, V, AS, C, NB>::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+//------
+//
+template<class K, class V, class AS, class C, std::size_t NB> inline
+V*
+bplus_tree<K, V, AS, C, NB>::find(K const& key)
+{
+    return const_cast<V*>(static_cast<bplus_tree const*>(this)->find(key));
+}
+
+template<class K, class V, class AS, class C, std::size_t NB> inline
+V const*
+bplus_tree<K, V, AS, C, NB>::find(K const& key) const
+{
+    if (leaf_node const* leaf = find_leaf(key);  leaf != nullptr)
+    {
+        size_type   i = search::count_less(leaf->m_keys, leaf->m_count, key, m_cmp);
+
+        if (i < leaf->m_count  &&  !m_cmp(key, leaf->m_keys[i]))
+        {
+            return &leaf->m_values[i];
+        }
+    }
+    return nullptr;
+}
+
+template<class K, class V, class AS, class C, std::size_t NB> inline
+bool
+bplus_tree<K, V, AS, C, NB>::contains(K const& key) const
+{
+    return find(key) != nullptr;
+}
+
+//------
+//- Inserts a value constructed from args, unless the key is already present; returns whether
+//  the insertion took place.  The path from the root is recorded on the way down, so that
+//  splits can be propagated upward without parent pointers.
+//
+template<class K, class V, class AS, class C, std::size_t NB>
+template<class... Args>
+bool
+bplus_tree<K, V, AS, C, NB>::try_emplace(K const& key, Args&&... args)
+{
+    if (m_height == 0)
+    {
+        mp_first = new_leaf();
+        mp_root  = mp_first;
+        m_height = 1;
+    }
+
+    inner_node*     path[max_height];
+    size_type       slots[max_height];
+    size_type       depth = 0;
+    void*           p     = static_cast<void*>(mp_root);
+
+    for (size_type h = m_height;  h > 1;  --h, ++depth)
+    {
+        inner_node*     n = static_cast<inner_node*>(p);
+        size_type       i = search::count_not_greater(n->m_keys, n->m_count, key, m_cmp);
+
+        path[depth]  = n;
+        slots[depth] = i;
+        p = static_cast<void*>(n->m_children[i]);
+    }
+
+    leaf_node*  leaf = static_cast<leaf_node*>(p);
+    size_type   i    = search::count_less(leaf->m_keys, leaf->m_count, key, m_cmp);
+
+    if (i < leaf->m_count  &&  !m_cmp(key, leaf->m_keys[i]))
+    {
+        return false;
+    }
+
+    V   value(std::forward<Args>(args)...);
+
+    if (leaf->m_count == leaf_capacity)
+    {
+        //- Move the upper half of the full leaf into a new one, link it in after the old one,
+        //  and pass its first key up as a separator.
+        //
+        leaf_pointer    pright = new_leaf();
+        leaf_node*      right  = to_address(pright);
+        size_type const keep   = (leaf_capacity + 1) / 2;
+        size_type const move   = leaf_capacity - keep;
+
+        std::memcpy(right->m_keys, leaf->m_keys + keep, move * sizeof(K));
+        std::memcpy(right->m_values, leaf->m_values + keep, move * sizeof(V));
+        right->m_count = (std::uint32_t) move;
+        right->m_next  = leaf->m_next;
+        leaf->m_count  = (std::uint32_t) keep;
+        leaf->m_next   = pright;
+
+        if (i > keep)
+        {
+            i   -= keep;
+            leaf = right;
+        }
+        insert_into_parents(path, slots, depth, right->m_keys[0], pright);
+    }
+
+    std::memmove(leaf->m_keys + i + 1, leaf->m_keys + i, (leaf->m_count - i) * sizeof(K));
+    std::memmove(leaf->m_values + i + 1, leaf->m_values + i, (leaf->m_count - i) * sizeof(V));
+    leaf->m_keys[i]   = key;
+    leaf->m_values[i] = value;
+    ++leaf->m_count;
+    ++m_size;
+    return true;
+}
+
+template<class K, class V, class AS, class C, std::size_t NB>
+V&
+bplus_tree<K, V, AS, C, NB>::operator [](K const& key)
+{
+    if (V* pval = find(key);  pval != nullptr)
+    {
+        return *pval;
+    }
+    try_emplace(key);
+    return *find(key);
+}
+
+template<class K, class V, class AS, class C, std::size_t NB>
+bool
+bplus_tree<K, V, AS, C, NB>::erase(K const& key)
+{
+    leaf_node*  leaf = find_leaf(key);
+
+    if (leaf == nullptr)
+    {
+        return false;
+    }
+
+    size_type   i = search::count_less(leaf->m_keys, leaf->m_count, key, m_cmp);
+
+    if (i == leaf->m_count  ||  m_cmp(key, leaf->m_keys[i]))
+    {
+        return false;
+    }
+    std::memmove(leaf->m_keys + i, leaf->m_keys + i + 1, (leaf->m_count - i - 1) * sizeof(K));
+    std::memmove(leaf->m_values + i, leaf->m_values + i + 1, (leaf->m_count - i - 1) * sizeof(V));
+    --leaf->m_count;
+    --m_size;
+    return true;
+}
+
+//------
+//
+template<class K, class V, class AS, class C, std::size_t NB>
+void
+bplus_tree<K, V, AS, C, NB>::clear()
+{
+    if (m_height != 0)
+    {
+        destroy(mp_root, m_height);
+        mp_root  = nullptr;
+        mp_first = nullptr;
+        m_size   = 0;
+        m_height = 0;
+    }
+}
+
+//------
+//- Calls f(key, value) for every entry, in key order.
+//
+template<class K, class V, class AS, class C, std::size_t NB>
+template<class F>
+void
+bplus_tree<K, V, AS, C, NB>::for_each(F&& f) const
+{
+    for (leaf_node const* leaf = to_address(mp_first);  leaf != nullptr;  leaf = to_address(leaf->m_next))
+    {
+        for (size_type i = 0;  i < leaf->m_count;  ++i)
+        {
+            f(leaf->m_keys[i], leaf->m_values[i]);
+        }
+    }
+}
+
+//- Calls f(key, value) for every entry whose key is in [first, last), in key order.
+//
+template<class K, class V, class AS, class C, std::size_t NB>
+template<class F>
+void
+bplus_tree<K, V, AS, C, NB>::for_each_in(K const& first, K const& last, F&& f) const
+{
+    leaf_node const*    leaf = find_leaf(first);
+    size_type           i    = (leaf != nullptr) ? search::count_less(leaf->m_keys, leaf->m_count, first, m_cmp) : 0;
+
+    for (;  leaf != nullptr;  leaf = to_address(leaf->m_next), i = 0)
+    {
+        for (;  i < leaf->m_count;  ++i)
+        {
+            if (!m_cmp(leaf->m_keys[i], last))
+            {
+                return;
+            }
+            f(leaf->m_keys[i], leaf->m_values[i]);
+        }
+    }
+}
+
+//------
+//- Requests every cache line of a node at once, so that the misses on a node's later lines
+//  overlap with the miss on its first line, instead of following it as the search proceeds.
+//
+template<class K, class V, class AS, class C, std::size_t NB> inline
+void
+bplus_tree<K, V, AS, C, NB>::prefetch(void const* p) noexcept
+{
+    for (size_type i = 64;  i < NB;  i += 64)
+    {
+#if defined(_MSC_VER)
+        _mm_prefetch(static_cast<char const*>(p) + i, _MM_HINT_T0);
+#else
+        __builtin_prefetch(static_cast<char const*>(p) + i);
+#endif
+    }
+}
+
+//- Returns the leaf whose key range includes key, or null if the tree is empty.  Each level
+//  resolves one synthetic pointer, and then searches the node through native pointers.
+//
+template<class K, class V, class AS, class C, std::size_t NB> inline
+typename bplus_tree<K, V, AS, C, NB>::leaf_node*
+bplus_tree<K, V, AS, C, NB>::find_leaf(K const& key) const
+{
+    void*   p = static_cast<void*>(mp_root);
+
+    for (size_type h = m_height;  h > 1;  --h)
+    {
+        inner_node const*   n = static_cast<inner_node const*>(p);
+
+        prefetch(n);
+        p = static_cast<void*>(n->m_children[search::count_not_greater(n->m_keys, n->m_count, key, m_cmp)]);
+    }
+    prefetch(p);
+    return static_cast<leaf_node*>(p);
+}
+
+template<class K, class V, class AS, class C, std::size_t NB> inline
+typename bplus_tree<K, V, AS, C, NB>::leaf_pointer
+bplus_tree<K, V, AS, C, NB>::new_leaf()
+{
+    leaf_pointer    p = rhx_allocator<leaf_node, AS>().allocate(1);
+
+    ::new (static_cast<void*>(to_address(p))) leaf_node();
+    p->m_count = 0;
+    p->m_next  = nullptr;
+    return p;
+}
+
+template<class K, class V, class AS, class C, std::size_t NB> inline
+typename bplus_tree<K, V, AS, C, NB>::inner_pointer
+bplus_tree<K, V, AS, C, NB>::new_inner()
+{
+    inner_pointer   p = rhx_allocator<inner_node, AS>().allocate(1);
+
+    ::new (static_cast<void*>(to_address(p))) inner_node();
+    p->m_count = 0;
+    return p;
+}
+
+//------
+//- Inserts separator sep and its right-hand child into the inner node at path[depth - 1], at
+//  the position recorded in slots.  A full node is split around its middle key, which is then
+//  inserted into the next node up in turn; a split root is replaced by a new root.
+//
+template<class K, class V, class AS, class C, std::size_t NB>
+void
+bplus_tree<K, V, AS, C, NB>::insert_into_parents(inner_node** path, size_type const* slots,
+                                                 size_type depth, K sep, void_pointer right)
+{
+    while (depth > 0)
+    {
+        --depth;
+
+        inner_node*     n = path[depth];
+        size_type       i = slots[depth];
+
+        if (n->m_count < inner_capacity)
+        {
+            std::memmove(n->m_keys + i + 1, n->m_keys + i, (n->m_count - i) * sizeof(K));
+            for (size_type j = n->m_count + 1;  j > i + 1;  --j)
+            {
+                n->m_children[j] = n->m_children[j - 1];
+            }
+            n->m_keys[i]         = sep;
+            n->m_children[i + 1] = right;
+            ++n->m_count;
+            return;
+        }
+
+        //- Gather the keys and children, with the new ones in place, and then deal them out
+        //  between the old node and a new one, passing up the middle key.
+        //
+        K               keys[inner_capacity + 1];
+        void_pointer    children[inner_capacity + 2];
+
+        std::memcpy(keys, n->m_keys, i * sizeof(K));
+        keys[i] = sep;
+        std::memcpy(keys + i + 1, n->m_keys + i, (inner_capacity - i) * sizeof(K));
+
+        for (size_type j = 0, k = 0;  j <= inner_capacity + 1;  ++j)
+        {
+            children[j] = (j == i + 1) ? right : n->m_children[k++];
+        }
+
+        inner_pointer   pnew = new_inner();
+        inner_node*     r    = to_address(pnew);
+        size_type const mid  = (inner_capacity + 1) / 2;
+        size_type const rcnt = inner_capacity - mid;
+
+        std::memcpy(n->m_keys, keys, mid * sizeof(K));
+        std::memcpy(r->m_keys, keys + mid + 1, rcnt * sizeof(K));
+        for (size_type j = 0;  j <= mid;  ++j)
+        {
+            n->m_children[j] = children[j];
+        }
+        for (size_type j = 0;  j <= rcnt;  ++j)
+        {
+            r->m_children[j] = children[mid + 1 + j];
+        }
+        n->m_count = (std::uint32_t) mid;
+        r->m_count = (std::uint32_t) rcnt;
+
+        sep   = keys[mid];
+        right = pnew;
+    }
+
+    inner_pointer   proot = new_inner();
+
+    proot->m_count       = 1;
+    proot->m_keys[0]     = sep;
+    proot->m_children[0] = mp_root;
+    proot->m_children[1] = right;
+    mp_root = proot;
+    ++m_height;
+}
+
+template<class K, class V, class AS, class C, std::size_t NB>
+void
+bplus_tree<K, V, AS, C, NB>::destroy(void_pointer p, size_type height) noexcept
+{
+    if (height > 1)
+    {
+        inner_pointer   n = static_cast<inner_pointer>(p);
+
+        for (size_type i = 0;  i <= n->m_count;  ++i)
+        {
+            destroy(n->m_children[i], height - 1);
+        }
+        rhx_allocator<inner_node, AS>().deallocate(n, 1);
+    }
+    else
+    {
+        rhx_allocator<leaf_node, AS>().deallocate(static_cast<leaf_pointer>(p), 1);
+    }
+}
+
+#endif  //- BPLUS_TREE_H_DEFINED
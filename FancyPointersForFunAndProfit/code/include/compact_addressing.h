@@ -0,0 +1,254 @@
+//==================================================================================================
+//  File:
+//      compact_addressing.h
+//
+//  Summary:
+//      Defines a two-dimensional based addressing model whose representation is a single 32-bit
+//      word.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef COMPACT_ADDRESSING_H_DEFINED
+#define COMPACT_ADDRESSING_H_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      compact_addressing_model<SM>
+//
+//  Summary:
+//      This class template implements a based (segment:offset) addressing model packed into
+//      32 bits, half the size of a native pointer:
+//
+//        bits 31..27       segment index
+//        bits 26..0        offset
+//
+//      The 27-bit offset spans a whole segment of the storage model, at byte granularity, so
+//      pointers of this type may refer to objects of any alignment, including characters.  The
+//      remaining five bits limit the segment index to 31.  An offset equal to the segment size
+//      does not fit, so the storage model keeps the last byte of each segment unused; a pointer
+//      one past the end of any object is then always inside that object's segment.
+//
+//      Unlike the other based models, this one cannot represent a pointer to memory outside the
+//      segments, as there is no room left over to hold a native address.  Such pointers are
+//      rejected by assign_from() with std::out_of_range, as are pointers into segments whose
+//      index exceeds max_segment.  The model is therefore meant for data structures whose nodes,
+//      and whose root objects, all live in the segments.
+//
+//      A self-relative form (a scaled 32-bit distance from the pointer's own address) would
+//      reach further, but would make the value of a pointer depend on where it is stored, so
+//      that every copy would have to be re-encoded, and copies held on the stack would usually
+//      be out of range.
+//--------------------------------------------------------------------------------------------------
+//
+template<typename SM>
+class alignas(sizeof(std::uint32_t)) compact_addressing_model
+{
+  public:
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    enum : std::uint32_t
+    {
+        offset_bits     = 27,
+        segment_shift   = offset_bits,
+        offset_mask     = (std::uint32_t(1) << offset_bits) - 1,
+        max_segment     = (std::uint32_t(1) << (32 - offset_bits)) - 1
+    };
+
+  public:
+    ~compact_addressing_model() = default;
+
+    compact_addressing_model() noexcept = default;
+    compact_addressing_model(compact_addressing_model&&) noexcept = default;
+    compact_addressing_model(compact_addressing_model const&) noexcept = default;
+    compact_addressing_model(std::nullptr_t) noexcept;
+    compact_addressing_model(size_type segment, size_type offset) noexcept;
+
+    compact_addressing_model&   operator =(compact_addressing_model&&) noexcept = default;
+    compact_addressing_model&   operator =(compact_addressing_model const&) noexcept = default;
+    compact_addressing_model&   operator =(std::nullptr_t) noexcept;
+
+    void*       address() const noexcept;
+    size_type   offset() const noexcept;
+    size_type   segment() const noexcept;
+
+    bool        equals(std::nullptr_t) const noexcept;
+    bool        equals(void const* p) const noexcept;
+    bool        equals(compact_addressing_model const& other) const noexcept;
+
+    bool        greater_than(std::nullptr_t) const noexcept;
+    bool        greater_than(void const* p) const noexcept;
+    bool        greater_than(compact_addressing_model const& other) const noexcept;
+
+    bool        less_than(std::nullptr_t) const noexcept;
+    bool        less_than(void const* p) const noexcept;
+    bool        less_than(compact_addressing_model const& other) const noexcept;
+
+    void        assign_from(void const* p);
+
+    void        decrement(difference_type dec) noexcept;
+    void        increment(difference_type inc) noexcept;
+
+  private:
+    std::uint32_t   m_addr;
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Facility:   compact_addressing_model<SM> implementation
+//--------------------------------------------------------------------------------------------------
+//
+template<typename SM> inline
+compact_addressing_model<SM>::compact_addressing_model(std::nullptr_t) noexcept
+:   m_addr{0u}
+{}
+
+template<typename SM> inline
+compact_addressing_model<SM>::compact_addressing_model(size_type seg, size_type off) noexcept
+:   m_addr{(std::uint32_t)((seg << segment_shift) | off)}
+{}
+
+template<typename SM> inline
+compact_addressing_model<SM>&
+compact_addressing_model<SM>::operator =(std::nullptr_t) noexcept
+{
+    m_addr = 0u;
+    return *this;
+}
+
+//------
+//
+template<typename SM> inline
+void*
+compact_addressing_model<SM>::address() const noexcept
+{
+    return SM::segment_address(m_addr >> segment_shift) + (m_addr & offset_mask);
+}
+
+template<typename SM> inline
+typename compact_addressing_model<SM>::size_type
+compact_addressing_model<SM>::offset() const noexcept
+{
+    return m_addr & offset_mask;
+}
+
+template<typename SM> inline
+typename compact_addressing_model<SM>::size_type
+compact_addressing_model<SM>::segment() const noexcept
+{
+    return m_addr >> segment_shift;
+}
+
+//------
+//- Every representable address lies in a segment, so two pointers refer to the same place
+//  exactly when their representations are equal.
+//
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::equals(std::nullptr_t) const noexcept
+{
+    return m_addr == 0u;
+}
+
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::equals(void const* p) const noexcept
+{
+    return address() == p;
+}
+
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::equals(compact_addressing_model const& other) const noexcept
+{
+    return m_addr == other.m_addr;
+}
+
+//------
+//
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::greater_than(std::nullptr_t) const noexcept
+{
+    return m_addr != 0u;
+}
+
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::greater_than(void const* p) const noexcept
+{
+    return address() > p;
+}
+
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::greater_than(compact_addressing_model const& other) const noexcept
+{
+    return address() > other.address();
+}
+
+//------
+//
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::less_than(std::nullptr_t) const noexcept
+{
+    return false;
+}
+
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::less_than(void const* p) const noexcept
+{
+    return address() < p;
+}
+
+template<typename SM> inline
+bool
+compact_addressing_model<SM>::less_than(compact_addressing_model const& other) const noexcept
+{
+    return address() < other.address();
+}
+
+//------
+//
+template<typename SM> inline
+void
+compact_addressing_model<SM>::assign_from(void const* p)
+{
+    char const*     pdata   = static_cast<char const*>(p);
+    size_type       segment = SM::segment_index(p);
+
+    if (segment == 0  &&  p != nullptr)
+    {
+        throw std::out_of_range("compact_addressing_model: address is not in a segment");
+    }
+    if (segment > max_segment)
+    {
+        throw std::out_of_range("compact_addressing_model: segment index is too large");
+    }
+    m_addr = (std::uint32_t)((segment << segment_shift) |
+                             (size_type)(pdata - static_cast<char const*>(SM::segment_address(segment))));
+}
+
+//------
+//
+template<typename SM> inline
+void
+compact_addressing_model<SM>::decrement(difference_type dec) noexcept
+{
+    m_addr -= (std::uint32_t) dec;
+}
+
+template<typename SM> inline
+void
+compact_addressing_model<SM>::increment(difference_type inc) noexcept
+{
+    m_addr += (std::uint32_t) inc;
+}
+
+#endif  //- COMPACT_ADDRESSING_H_DEFINED
@@ -0,0 +1,95 @@
+//==================================================================================================
+//  File:
+//      compact_storage.h
+//
+//  Summary:
+//      Defines a storage model that uses the 32-bit compact addressing model.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef COMPACT_STORAGE_H_DEFINED
+#define COMPACT_STORAGE_H_DEFINED
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage_base.h"
+#include "compact_addressing.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      compact_storage_model
+//
+//  Summary:
+//      This class implements a based 2D storage model using the facilities provided by the
+//      "storage_model_base" base class, with 4-byte synthetic pointers.  The compact pointer
+//      has room for only 5-bit segment indices, so set_segment_count() is limited accordingly.
+//
+//      Because the segment table is shared with the other models, the count can also be raised
+//      through storage_model_base::set_segment_count().  last_segment_index() is therefore
+//      clamped to the largest index a compact pointer can hold, and allocate_segment() throws
+//      std::out_of_range for any index above it.
+//
+//      The 27-bit offset cannot hold the size of a whole segment, so a pointer one past the end
+//      of an object ending exactly at the end of a segment could not be represented.  The last
+//      byte of each segment is therefore withheld: segment_size() reports one byte less, and
+//      the allocation strategies, which fill a segment only up to its segment_size(), never
+//      hand that byte out.  Every end pointer then lies inside its segment, at an offset that
+//      fits.
+//--------------------------------------------------------------------------------------------------
+//
+class compact_storage_model : public storage_model_base
+{
+  public:
+    using addressing_model = compact_addressing_model<compact_storage_model>;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset=0);
+
+    static  void        allocate_segment(size_type segment, size_type size = max_size);
+    static  size_type   segment_size(size_type segment) noexcept;
+    static  size_type   last_segment_index() noexcept;
+    static  bool        set_segment_count(size_type count);
+};
+
+static_assert(compact_storage_model::max_size == (1u << compact_storage_model::addressing_model::offset_bits),
+              "the compact offset field must span exactly one segment");
+
+//------
+//
+inline compact_storage_model::addressing_model
+compact_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment, offset};
+}
+
+inline void
+compact_storage_model::allocate_segment(size_type segment, size_type size)
+{
+    if (segment > addressing_model::max_segment)
+    {
+        throw std::out_of_range("compact_storage_model: segment index does not fit in 5 bits");
+    }
+    storage_model_base::allocate_segment(segment, size);
+}
+
+inline compact_storage_model::size_type
+compact_storage_model::segment_size(size_type segment) noexcept
+{
+    return std::min<size_type>(storage_model_base::segment_size(segment), addressing_model::offset_mask);
+}
+
+inline compact_storage_model::size_type
+compact_storage_model::last_segment_index() noexcept
+{
+    return std::min<size_type>(storage_model_base::last_segment_index(), addressing_model::max_segment);
+}
+
+inline bool
+compact_storage_model::set_segment_count(size_type count)
+{
+    return (count + first_segment_index() - 1) <= addressing_model::max_segment  &&
+           storage_model_base::set_segment_count(count);
+}
+
+#endif  //- COMPACT_STORAGE_H_DEFINED
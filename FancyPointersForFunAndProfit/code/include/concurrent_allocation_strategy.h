@@ -0,0 +1,405 @@
+//==================================================================================================
+//  File:
+//      concurrent_allocation_strategy.h
+//
+//  Summary:
+//      Defines thread-safe variants of the monotonic allocation strategy: one that bumps a
+//      single shared position atomically, and one that bumps thread-local slabs carved out of
+//      the shared segments.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef CONCURRENT_ALLOCATION_STRATEGY_H_DEFINED
+#define CONCURRENT_ALLOCATION_STRATEGY_H_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "synthetic_pointer.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      concurrent_monotonic_allocation_strategy<SM>
+//
+//  Summary:
+//      This class implements the same leaky allocation policy as monotonic_allocation_strategy,
+//      but may be used from any number of threads at once.
+//
+//      The current segment and offset are packed into a single atomic word, with the segment
+//      index in the upper 32 bits, so that a chunk is claimed by one compare-and-swap.  A swap
+//      is only attempted when the chunk fits in the rest of the segment (whose size may be less
+//      than max_segment_size()), so the offset never passes the segment size, and can never
+//      carry into the segment index.  The first thread
+//      whose chunk does not fit performs the rollover: it marks the position as rolling over,
+//      allocates the next segment, and then stores a new position at its start.  Other threads
+//      wait while the mark is present.  Lazy initialization of the segments is guarded by a
+//      mutex, using double-checked locking.
+//
+//      As with monotonic_allocation_strategy, segments after the first are allocated on demand,
+//      and running out of segments is reported by throwing std::bad_alloc.  A failed rollover
+//      marks the position as exhausted, so that every thread, including those waiting on the
+//      rollover, throws std::bad_alloc until the segments are reset.
+//
+//      The rollover thread's allocate_segment() writes the storage model's tables for the new
+//      segment while other threads are converting pointers into the older ones.  Those writes
+//      happen before the release store of the new position, and other threads only reach the
+//      new segment through an acquire of it, so they see the tables complete.  A pointer that
+//      one thread passes to another must likewise be passed through a release/acquire pair (a
+//      mutex, a queue, an atomic) before the receiving thread converts it.
+//--------------------------------------------------------------------------------------------------
+//
+template<class SM>
+class concurrent_monotonic_allocation_strategy
+{
+  public:
+    using storage_model         = SM;
+    using addressing_model      = typename SM::addressing_model;
+    using difference_type       = typename SM::difference_type;
+    using size_type             = typename SM::size_type;
+    using void_pointer          = syn_ptr<void, addressing_model>;
+    using const_void_pointer    = syn_ptr<void const, addressing_model>;
+
+    template<class T>
+    using rebind_pointer        = syn_ptr<T, addressing_model>;
+
+  public:
+    size_type       max_size() const;
+
+    void_pointer    allocate(size_type n);
+    void            deallocate(void_pointer p);
+
+    static  void    claim(size_type n, size_type& segment, size_type& offset);
+    static  size_type   generation();
+
+    static  void    reset_segments();
+    static  void    swap_segments();
+
+  private:
+    enum : std::uint64_t
+    {
+        offset_mask   = 0xFFFF'FFFFu,
+        segment_shift = 32,
+        first_offset  = 64,
+        rolling_over  = 0xFFFF'FFFFu,       //- Offsets marking the state of a rollover
+        exhausted     = 0xFFFF'FFFEu
+    };
+
+    static_assert((std::uint64_t) SM::max_size < (std::uint64_t) exhausted,
+                  "segment offsets must not collide with the rollover marks");
+
+    static  void    init();
+    static  size_type   round_up(size_type x, size_type r);
+
+    static  std::atomic<std::uint64_t>  sm_position;
+    static  std::atomic<size_type>      sm_generation;
+    static  std::atomic<bool>           sm_initialized;
+    static  std::mutex                  sm_init_mutex;
+};
+
+//------
+//
+template<class SM>  std::atomic<std::uint64_t>
+concurrent_monotonic_allocation_strategy<SM>::sm_position{0};
+
+template<class SM>  std::atomic<typename concurrent_monotonic_allocation_strategy<SM>::size_type>
+concurrent_monotonic_allocation_strategy<SM>::sm_generation{0};
+
+template<class SM>  std::atomic<bool>
+concurrent_monotonic_allocation_strategy<SM>::sm_initialized{false};
+
+template<class SM>  std::mutex
+concurrent_monotonic_allocation_strategy<SM>::sm_init_mutex;
+
+//------
+//
+template<class SM> inline
+typename concurrent_monotonic_allocation_strategy<SM>::size_type
+concurrent_monotonic_allocation_strategy<SM>::max_size() const
+{
+    return storage_model::max_segment_size() - first_offset;
+}
+
+//------
+//
+template<class SM> inline
+typename concurrent_monotonic_allocation_strategy<SM>::void_pointer
+concurrent_monotonic_allocation_strategy<SM>::allocate(size_type n)
+{
+    size_type   segment, offset;
+
+    claim(n, segment, offset);
+    return storage_model::segment_pointer(segment, offset);
+}
+
+template<class SM> inline
+void
+concurrent_monotonic_allocation_strategy<SM>::deallocate(void_pointer)
+{}
+
+//------
+//- Claims a chunk of at least n bytes, returning its location as a segment index and offset.
+//  This is the building block for allocate(), and for strategies (such as the per-thread arena
+//  strategy below) that sub-allocate from larger chunks.
+//
+template<class SM>
+void
+concurrent_monotonic_allocation_strategy<SM>::claim(size_type n, size_type& segment, size_type& offset)
+{
+    size_type const     chunk_size = round_up((n == 0) ? 1 : n, 16u);
+
+    if (chunk_size > storage_model::max_segment_size() - first_offset)
+    {
+        throw std::bad_alloc();
+    }
+    if (!sm_initialized.load(std::memory_order_acquire))
+    {
+        init();
+    }
+
+    for (;;)
+    {
+        std::uint64_t   pos = sm_position.load(std::memory_order_acquire);
+        size_type       seg = (size_type)(pos >> segment_shift);
+        size_type       off = (size_type)(pos & offset_mask);
+
+        if (off == exhausted)
+        {
+            throw std::bad_alloc();
+        }
+        else if (off == rolling_over)
+        {
+            //- Some other thread is rolling over; wait for it and try again.
+            //
+            std::this_thread::yield();
+        }
+        else if (off + chunk_size <= storage_model::segment_size(seg))
+        {
+            if (sm_position.compare_exchange_weak(pos, pos + chunk_size, std::memory_order_acq_rel))
+            {
+                segment = seg;
+                offset  = off;
+                return;
+            }
+        }
+        else if (sm_position.compare_exchange_weak(pos, ((std::uint64_t) seg << segment_shift) | rolling_over,
+                                                   std::memory_order_acq_rel))
+        {
+            //- This thread's chunk does not fit in the rest of the segment, and this thread is
+            //  the one that marked the segment as rolling over, so it is responsible for moving
+            //  to the next segment, allocating it if necessary.  The new position accounts for
+            //  this thread's chunk, which is placed at the start of that segment, and its release
+            //  publishes the new segment to the other threads.  If that fails, the exhausted mark
+            //  is published instead, and every thread gives up.
+            //
+            bool    okay = false;
+
+            try
+            {
+                if (seg < storage_model::last_segment_index())
+                {
+                    storage_model::allocate_segment(seg + 1);
+                    okay = storage_model::segment_address(seg + 1) != nullptr;
+                }
+            }
+            catch (...)
+            {
+            }
+            if (!okay)
+            {
+                sm_position.store(((std::uint64_t) seg << segment_shift) | exhausted, std::memory_order_release);
+                throw std::bad_alloc();
+            }
+            if (first_offset + chunk_size > storage_model::segment_size(seg + 1))
+            {
+                //- The new segment is too small for this chunk, but not for others.
+                //
+                sm_position.store(((std::uint64_t)(seg + 1) << segment_shift) | first_offset,
+                                  std::memory_order_release);
+                throw std::bad_alloc();
+            }
+            sm_position.store(((std::uint64_t)(seg + 1) << segment_shift) | (first_offset + chunk_size),
+                              std::memory_order_release);
+            segment = seg + 1;
+            offset  = first_offset;
+            return;
+        }
+    }
+}
+
+//- Returns a counter that changes every time the segments are reset, so that clients caching
+//  parts of the segments (such as thread-local slabs) can tell when their caches are stale.
+//
+template<class SM> inline
+typename concurrent_monotonic_allocation_strategy<SM>::size_type
+concurrent_monotonic_allocation_strategy<SM>::generation()
+{
+    return sm_generation.load(std::memory_order_acquire);
+}
+
+//------
+//- These must not be called while other threads are allocating.
+//
+template<class SM> inline
+void
+concurrent_monotonic_allocation_strategy<SM>::reset_segments()
+{
+    std::lock_guard<std::mutex>     lock(sm_init_mutex);
+
+    storage_model::reset_segments();
+    sm_position.store(((std::uint64_t) storage_model::first_segment_index() << segment_shift) | first_offset);
+    sm_generation.fetch_add(1, std::memory_order_release);
+}
+
+template<class SM> inline
+void
+concurrent_monotonic_allocation_strategy<SM>::swap_segments()
+{
+    storage_model::swap_segments();
+}
+
+//------
+//
+template<class SM>
+void
+concurrent_monotonic_allocation_strategy<SM>::init()
+{
+    std::lock_guard<std::mutex>     lock(sm_init_mutex);
+
+    if (!sm_initialized.load(std::memory_order_relaxed))
+    {
+        storage_model::init_segments();
+        sm_position.store(((std::uint64_t) storage_model::first_segment_index() << segment_shift) | first_offset);
+        sm_initialized.store(true, std::memory_order_release);
+    }
+}
+
+template<class SM> inline
+typename concurrent_monotonic_allocation_strategy<SM>::size_type
+concurrent_monotonic_allocation_strategy<SM>::round_up(size_type x, size_type r)
+{
+    return (x % r) ? (x + r - (x % r)) : x;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      thread_arena_allocation_strategy<SM>
+//
+//  Summary:
+//      This class implements a leaky allocation strategy in which each thread bump-allocates,
+//      without any synchronization, from its own slab.  Slabs are claimed from the shared
+//      segments through concurrent_monotonic_allocation_strategy<SM>, so the only contended
+//      operation is taking a new slab, once per slab_size bytes.  Requests larger than a
+//      quarter of a slab bypass the slab and are claimed directly.
+//
+//      A slab is abandoned (and its unused remainder wasted) when it cannot satisfy a request,
+//      and when the segments are reset.
+//--------------------------------------------------------------------------------------------------
+//
+template<class SM>
+class thread_arena_allocation_strategy
+{
+  public:
+    using storage_model         = SM;
+    using shared_strategy       = concurrent_monotonic_allocation_strategy<SM>;
+    using addressing_model      = typename SM::addressing_model;
+    using difference_type       = typename SM::difference_type;
+    using size_type             = typename SM::size_type;
+    using void_pointer          = syn_ptr<void, addressing_model>;
+    using const_void_pointer    = syn_ptr<void const, addressing_model>;
+
+    template<class T>
+    using rebind_pointer        = syn_ptr<T, addressing_model>;
+
+    enum : size_type
+    {
+        slab_size = 1u << 20        //- 1 MB per slab
+    };
+
+  public:
+    size_type       max_size() const;
+
+    void_pointer    allocate(size_type n);
+    void            deallocate(void_pointer p);
+
+    static  void    reset_segments();
+    static  void    swap_segments();
+
+  private:
+    struct slab
+    {
+        size_type   m_segment;
+        size_type   m_offset;
+        size_type   m_end;
+        size_type   m_generation;
+    };
+
+    static  thread_local slab   tl_slab;
+};
+
+//------
+//
+template<class SM>  thread_local typename thread_arena_allocation_strategy<SM>::slab
+thread_arena_allocation_strategy<SM>::tl_slab{0, 0, 0, 0};
+
+//------
+//
+template<class SM> inline
+typename thread_arena_allocation_strategy<SM>::size_type
+thread_arena_allocation_strategy<SM>::max_size() const
+{
+    return shared_strategy().max_size();
+}
+
+template<class SM>
+typename thread_arena_allocation_strategy<SM>::void_pointer
+thread_arena_allocation_strategy<SM>::allocate(size_type n)
+{
+    size_type   chunk_size = (n == 0) ? 16 : ((n + 15) & ~(size_type) 15);
+    slab&       s          = tl_slab;
+
+    if (chunk_size > slab_size / 4)
+    {
+        return shared_strategy().allocate(chunk_size);
+    }
+
+    if (s.m_offset + chunk_size > s.m_end  ||  s.m_generation != shared_strategy::generation())
+    {
+        s.m_generation = shared_strategy::generation();
+        shared_strategy::claim(slab_size, s.m_segment, s.m_offset);
+        s.m_end = s.m_offset + slab_size;
+    }
+
+    size_type   offset = s.m_offset;
+
+    s.m_offset += chunk_size;
+    return storage_model::segment_pointer(s.m_segment, offset);
+}
+
+template<class SM> inline
+void
+thread_arena_allocation_strategy<SM>::deallocate(void_pointer)
+{}
+
+//------
+//
+template<class SM> inline
+void
+thread_arena_allocation_strategy<SM>::reset_segments()
+{
+    shared_strategy::reset_segments();
+}
+
+template<class SM> inline
+void
+thread_arena_allocation_strategy<SM>::swap_segments()
+{
+    shared_strategy::swap_segments();
+}
+
+#endif  //- CONCURRENT_ALLOCATION_STRATEGY_H_DEFINED
@@ -0,0 +1,604 @@
+//==================================================================================================
+//  File:
+//      flat_hash_map.h
+//
+//  Summary:
+//      Defines an open-addressing hash map whose storage is a single block obtained from an
+//      allocator, and so may be reached through a synthetic pointer.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef FLAT_HASH_MAP_H_DEFINED
+#define FLAT_HASH_MAP_H_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#include "synthetic_pointer.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      flat_hash_group
+//
+//  Summary:
+//      This class is a window onto a group of consecutive control bytes of a flat_hash_map,
+//      which it compares all at once: with SSE2, as sixteen bytes in a vector register, and
+//      otherwise as eight bytes in a 64-bit word.  The match functions return bit masks with
+//      one bit (SSE2) or one byte (otherwise) per control byte; index_of() maps the lowest set
+//      bit of such a mask back to a control byte index.
+//
+//      A control byte is either a full slot's 7-bit hash fragment (0..127), or one of the two
+//      negative values below.  The portable match() can report false positives, which are
+//      harmless because every candidate slot's key is compared anyway.
+//--------------------------------------------------------------------------------------------------
+//
+class flat_hash_group
+{
+  public:
+    enum : std::int8_t
+    {
+        empty   = -128,     //- 0b1000'0000
+        deleted = -2        //- 0b1111'1110
+    };
+
+#if defined(__SSE2__)
+    using mask_type = std::uint32_t;
+
+    enum : std::size_t
+    {
+        width      = 16,
+        mask_shift = 0
+    };
+
+    explicit    flat_hash_group(std::int8_t const* pctrl) noexcept
+                :   m_ctrl{_mm_loadu_si128(reinterpret_cast<__m128i const*>(pctrl))}
+                {}
+
+    mask_type   match(std::int8_t h2) const noexcept
+                {
+                    return (mask_type) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl));
+                }
+    mask_type   match_empty() const noexcept
+                {
+                    return match(empty);
+                }
+    mask_type   match_empty_or_deleted() const noexcept
+                {
+                    return (mask_type) _mm_movemask_epi8(m_ctrl);
+                }
+
+  private:
+    __m128i     m_ctrl;
+#else
+    using mask_type = std::uint64_t;
+
+    enum : std::size_t
+    {
+        width      = 8,
+        mask_shift = 3
+    };
+
+    explicit    flat_hash_group(std::int8_t const* pctrl) noexcept
+                {
+                    std::memcpy(&m_ctrl, pctrl, sizeof(m_ctrl));
+                }
+
+    mask_type   match(std::int8_t h2) const noexcept
+                {
+                    std::uint64_t   x = m_ctrl ^ (lsbs * (std::uint8_t) h2);
+                    return (x - lsbs) & ~x & msbs;
+                }
+    mask_type   match_empty() const noexcept
+                {
+                    return m_ctrl & (~m_ctrl << 6) & msbs;
+                }
+    mask_type   match_empty_or_deleted() const noexcept
+                {
+                    return m_ctrl & msbs;
+                }
+
+  private:
+    static constexpr std::uint64_t  lsbs = 0x0101'0101'0101'0101u;
+    static constexpr std::uint64_t  msbs = 0x8080'8080'8080'8080u;
+
+    std::uint64_t   m_ctrl;     //- Byte order is assumed to be little-endian
+#endif
+
+  public:
+    static  std::size_t index_of(mask_type mask) noexcept
+                        {
+#if defined(_MSC_VER)
+                            //- Two 32-bit scans, so that 32-bit targets are covered too.
+                            //
+                            unsigned long   bit;
+
+                            if (!_BitScanForward(&bit, (unsigned long) mask))
+                            {
+                                _BitScanForward(&bit, (unsigned long) ((std::uint64_t) mask >> 32));
+                                bit += 32;
+                            }
+                            return (std::size_t) bit >> mask_shift;
+#else
+                            return (std::size_t) __builtin_ctzll(mask) >> mask_shift;
+#endif
+                        }
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      flat_hash_map<K, V, Hash, Eq, Alloc>
+//
+//  Summary:
+//      This class template implements a hash map in the style of the "Swiss table": slots are
+//      held in one flat array, alongside an array of one-byte control codes that is searched a
+//      group of bytes at a time, so that a lookup usually inspects a single group and then
+//      compares a single key.
+//
+//      The control bytes and the slots share one block, allocated through Alloc rebound to
+//      char, and held by the allocator's pointer type.  With rhx_allocator, the map is
+//      therefore as relocatable as its allocation strategy's synthetic pointers: the block is
+//      resolved to a native address once per operation, and everything within it is reached
+//      by native pointer arithmetic.  The map object itself may live in the segments (as in
+//      the tests), or anywhere the pointer type allows.
+//
+//      The capacity is a power of two, no smaller than a group.  The first group's worth of
+//      control bytes is cloned after the last, so that a group may be loaded at any position
+//      without wrapping.  Probing visits groups in triangular-number steps, which with a
+//      power-of-two capacity eventually covers every slot.  At most 7/8 of the slots are used,
+//      counting tombstones left by erasure, before the table is rebuilt.
+//
+//      The interface is deliberately small.  find() returns a native pointer to the value, or
+//      null; like any native pointer into the segments, it is invalidated by relocation, and
+//      also by any insertion.  Allocation failure is not reported through a return value: the
+//      allocation strategies throw std::bad_alloc, which propagates from whichever insertion
+//      or reserve() needed a larger block, and leaves the map as it was.
+//--------------------------------------------------------------------------------------------------
+//
+template<class K, class V, class Hash = std::hash<K>, class Eq = std::equal_to<K>,
+         class Alloc = std::allocator<std::pair<K const, V>>>
+class flat_hash_map
+{
+  public:
+    using key_type       = K;
+    using mapped_type    = V;
+    using hasher         = Hash;
+    using key_equal      = Eq;
+    using allocator_type = Alloc;
+    using size_type      = std::size_t;
+
+  public:
+    ~flat_hash_map();
+
+    flat_hash_map(allocator_type const& alloc = allocator_type());
+    flat_hash_map(flat_hash_map const&) = delete;
+    flat_hash_map&  operator =(flat_hash_map const&) = delete;
+
+    size_type   size() const noexcept;
+    size_type   capacity() const noexcept;
+    bool        empty() const noexcept;
+
+    V*          find(K const& key);
+    V const*    find(K const& key) const;
+    bool        contains(K const& key) const;
+
+    template<class... Args>
+    bool        try_emplace(K const& key, Args&&... args);
+    V&          operator [](K const& key);
+    bool        erase(K const& key);
+
+    void        clear();
+    void        reserve(size_type count);
+
+    template<class F>
+    void        for_each(F&& f) const;
+
+  private:
+    struct slot
+    {
+        K   m_key;
+        V   m_value;
+    };
+
+    using group          = flat_hash_group;
+    using char_alloc     = typename std::allocator_traits<Alloc>::template rebind_alloc<char>;
+    using char_pointer   = typename std::allocator_traits<char_alloc>::pointer;
+
+    static_assert(alignof(slot) <= 16, "flat_hash_map slots must not need more than 16-byte alignment");
+
+    enum : size_type
+    {
+        min_capacity = ((size_type) group::width < 16) ? 16 : (size_type) group::width
+    };
+
+    char_pointer    mp_block;
+    size_type       m_capacity;
+    size_type       m_size;
+    size_type       m_growth_left;
+    char_alloc      m_alloc;
+    Hash            m_hash;
+    Eq              m_eq;
+
+    static  size_type   mix(size_type h) noexcept;
+    static  size_type   slots_offset(size_type capacity) noexcept;
+    static  size_type   block_size(size_type capacity) noexcept;
+
+    std::int8_t*    ctrl() const noexcept;
+    slot*           slots() const noexcept;
+
+    size_type       find_index(K const& key, size_type hash) const;
+    size_type       find_insert_index(size_type hash) const noexcept;
+    void            set_ctrl(std::int8_t* pctrl, size_type i, std::int8_t h) const noexcept;
+    void            rehash(size_type new_capacity);
+    void            destroy_slots() noexcept;
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Facility:   flat_hash_map<K, V, Hash, Eq, Alloc> implementation
+//--------------------------------------------------------------------------------------------------
+//
+template<class K, class V, class H, class E, class A> inline
+flat_hash_map<K, V, H, E, A>::~flat_hash_map()
+{
+    if (mp_block != nullptr)
+    {
+        destroy_slots();
+        m_alloc.deallocate(mp_block, block_size(m_capacity));
+    }
+}
+
+template<class K, class V, class H, class E, class A> inline
+flat_hash_map<K, V, H, E, A>::flat_hash_map(allocator_type const& alloc)
+:   mp_block(nullptr)
+,   m_capacity(0)
+,   m_size(0)
+,   m_growth_left(0)
+,   m_alloc(alloc)
+,   m_hash()
+,   m_eq()
+{}
+
+//------
+//
+template<class K, class V, class H, class E, class A> inline
+typename flat_hash_map<K, V, H, E, A>::size_type
+flat_hash_map<K, V, H, E, A>::size() const noexcept
+{
+    return m_size;
+}
+
+template<class K, class V, class H, class E, class A> inline
+typename flat_hash_map<K, V, H, E, A>::size_type
+flat_hash_map<K, V, H, E, A>::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+template<class K, class V, class H, class E, class A> inline
+bool
+flat_hash_map<K, V, H, E, A>::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+//------
+//
+template<class K, class V, class H, class E, class A> inline
+V*
+flat_hash_map<K, V, H, E, A>::find(K const& key)
+{
+    size_type   i = find_index(key, mix(m_hash(key)));
+    return (i < m_capacity) ? &slots()[i].m_value : nullptr;
+}
+
+template<class K, class V, class H, class E, class A> inline
+V const*
+flat_hash_map<K, V, H, E, A>::find(K const& key) const
+{
+    size_type   i = find_index(key, mix(m_hash(key)));
+    return (i < m_capacity) ? &slots()[i].m_value : nullptr;
+}
+
+template<class K, class V, class H, class E, class A> inline
+bool
+flat_hash_map<K, V, H, E, A>::contains(K const& key) const
+{
+    return find_index(key, mix(m_hash(key))) < m_capacity;
+}
+
+//------
+//- Inserts a value constructed from args, unless the key is already present; returns whether
+//  the insertion took place.  A false return means only that the key was present; a failure to
+//  allocate a larger block is thrown, before anything is changed.
+//
+template<class K, class V, class H, class E, class A>
+template<class... Args>
+bool
+flat_hash_map<K, V, H, E, A>::try_emplace(K const& key, Args&&... args)
+{
+    size_type const     hash = mix(m_hash(key));
+
+    if (find_index(key, hash) < m_capacity)
+    {
+        return false;
+    }
+    if (m_growth_left == 0)
+    {
+        //- Tombstones count against the growth limit, so rebuild at the same capacity if they
+        //  account for a good part of the load, and at twice the capacity otherwise.
+        //
+        rehash((m_size + 1 > m_capacity * 7 / 16) ? std::max<size_type>(m_capacity * 2, min_capacity)
+                                                   : m_capacity);
+    }
+
+    std::int8_t*    pctrl = ctrl();
+    size_type       i     = find_insert_index(hash);
+
+    ::new (static_cast<void*>(&slots()[i])) slot{key, V(std::forward<Args>(args)...)};
+    m_growth_left -= (pctrl[i] == group::empty) ? 1 : 0;
+    set_ctrl(pctrl, i, (std::int8_t)(hash & 0x7F));
+    ++m_size;
+    return true;
+}
+
+template<class K, class V, class H, class E, class A>
+V&
+flat_hash_map<K, V, H, E, A>::operator [](K const& key)
+{
+    if (V* pval = find(key);  pval != nullptr)
+    {
+        return *pval;
+    }
+    try_emplace(key);
+    return *find(key);
+}
+
+template<class K, class V, class H, class E, class A>
+bool
+flat_hash_map<K, V, H, E, A>::erase(K const& key)
+{
+    size_type   i = find_index(key, mix(m_hash(key)));
+
+    if (i >= m_capacity)
+    {
+        return false;
+    }
+    slots()[i].~slot();
+    set_ctrl(ctrl(), i, group::deleted);
+    --m_size;
+    return true;
+}
+
+//------
+//
+template<class K, class V, class H, class E, class A>
+void
+flat_hash_map<K, V, H, E, A>::clear()
+{
+    if (mp_block != nullptr)
+    {
+        destroy_slots();
+        std::memset(ctrl(), group::empty, m_capacity + group::width);
+        m_size        = 0;
+        m_growth_left = m_capacity - m_capacity / 8;
+    }
+}
+
+template<class K, class V, class H, class E, class A>
+void
+flat_hash_map<K, V, H, E, A>::reserve(size_type count)
+{
+    size_type   new_capacity = min_capacity;
+
+    while (new_capacity - new_capacity / 8 < count)
+    {
+        new_capacity *= 2;
+    }
+    if (new_capacity > m_capacity)
+    {
+        rehash(new_capacity);
+    }
+}
+
+template<class K, class V, class H, class E, class A>
+template<class F>
+void
+flat_hash_map<K, V, H, E, A>::for_each(F&& f) const
+{
+    std::int8_t const*  pctrl  = ctrl();
+    slot const*         pslots = slots();
+
+    for (size_type i = 0;  i < m_capacity;  ++i)
+    {
+        if (pctrl[i] >= 0)
+        {
+            f(pslots[i].m_key, pslots[i].m_value);
+        }
+    }
+}
+
+//------
+//- A finalizing mix, so that hashers which return their argument (as std::hash does for
+//  integers in libstdc++) still spread their values over both the index bits and the 7-bit
+//  fragment kept in the control bytes.
+//
+template<class K, class V, class H, class E, class A> inline
+typename flat_hash_map<K, V, H, E, A>::size_type
+flat_hash_map<K, V, H, E, A>::mix(size_type h) noexcept
+{
+    std::uint64_t   x = (std::uint64_t) h * 0x9E37'79B9'7F4A'7C15u;
+    return (size_type)(x ^ (x >> 32));
+}
+
+template<class K, class V, class H, class E, class A> inline
+typename flat_hash_map<K, V, H, E, A>::size_type
+flat_hash_map<K, V, H, E, A>::slots_offset(size_type capacity) noexcept
+{
+    return (capacity + group::width + 15) & ~(size_type) 15;
+}
+
+template<class K, class V, class H, class E, class A> inline
+typename flat_hash_map<K, V, H, E, A>::size_type
+flat_hash_map<K, V, H, E, A>::block_size(size_type capacity) noexcept
+{
+    return slots_offset(capacity) + capacity * sizeof(slot);
+}
+
+template<class K, class V, class H, class E, class A> inline
+std::int8_t*
+flat_hash_map<K, V, H, E, A>::ctrl() const noexcept
+{
+    return reinterpret_cast<std::int8_t*>(to_address(mp_block));
+}
+
+template<class K, class V, class H, class E, class A> inline
+typename flat_hash_map<K, V, H, E, A>::slot*
+flat_hash_map<K, V, H, E, A>::slots() const noexcept
+{
+    return reinterpret_cast<slot*>(to_address(mp_block) + slots_offset(m_capacity));
+}
+
+//------
+//- Returns the index of the slot holding key, or m_capacity if there is none.  The block is
+//  resolved to native pointers once, on entry.
+//
+template<class K, class V, class H, class E, class A>
+typename flat_hash_map<K, V, H, E, A>::size_type
+flat_hash_map<K, V, H, E, A>::find_index(K const& key, size_type hash) const
+{
+    if (m_size == 0)
+    {
+        return m_capacity;
+    }
+
+    std::int8_t const*  pctrl  = ctrl();
+    slot const*         pslots = slots();
+    size_type const     mask   = m_capacity - 1;
+    std::int8_t const   h2     = (std::int8_t)(hash & 0x7F);
+    size_type           pos    = (hash >> 7) & mask;
+
+    for (size_type step = group::width;  ;  step += group::width)
+    {
+        group   g(pctrl + pos);
+
+        for (auto m = g.match(h2);  m != 0;  m &= m - 1)
+        {
+            size_type   i = (pos + group::index_of(m)) & mask;
+
+            if (m_eq(pslots[i].m_key, key))
+            {
+                return i;
+            }
+        }
+        if (g.match_empty() != 0)
+        {
+            return m_capacity;
+        }
+        pos = (pos + step) & mask;
+    }
+}
+
+//- Returns the index of the first empty or deleted slot on the probe sequence for hash; one
+//  always exists, because the table is never allowed to fill.
+//
+template<class K, class V, class H, class E, class A>
+typename flat_hash_map<K, V, H, E, A>::size_type
+flat_hash_map<K, V, H, E, A>::find_insert_index(size_type hash) const noexcept
+{
+    std::int8_t const*  pctrl = ctrl();
+    size_type const     mask  = m_capacity - 1;
+    size_type           pos   = (hash >> 7) & mask;
+
+    for (size_type step = group::width;  ;  step += group::width)
+    {
+        if (auto m = group(pctrl + pos).match_empty_or_deleted();  m != 0)
+        {
+            return (pos + group::index_of(m)) & mask;
+        }
+        pos = (pos + step) & mask;
+    }
+}
+
+//- Sets a control byte, and its clone if it is one of the first group's worth.
+//
+template<class K, class V, class H, class E, class A> inline
+void
+flat_hash_map<K, V, H, E, A>::set_ctrl(std::int8_t* pctrl, size_type i, std::int8_t h) const noexcept
+{
+    pctrl[i] = h;
+    if (i < group::width)
+    {
+        pctrl[m_capacity + i] = h;
+    }
+}
+
+//------
+//- The new block is allocated before any member is changed, so that if the allocator throws,
+//  the map is left intact.
+//
+template<class K, class V, class H, class E, class A>
+void
+flat_hash_map<K, V, H, E, A>::rehash(size_type new_capacity)
+{
+    char_pointer    old_block    = mp_block;
+    size_type       old_capacity = m_capacity;
+    std::int8_t*    old_ctrl     = (old_block != nullptr) ? ctrl() : nullptr;
+    slot*           old_slots    = (old_block != nullptr) ? slots() : nullptr;
+
+    mp_block      = m_alloc.allocate(block_size(new_capacity));
+    m_capacity    = new_capacity;
+    m_growth_left = new_capacity - new_capacity / 8 - m_size;
+    std::memset(ctrl(), group::empty, new_capacity + group::width);
+
+    std::int8_t*    pctrl  = ctrl();
+    slot*           pslots = slots();
+
+    for (size_type i = 0;  i < old_capacity;  ++i)
+    {
+        if (old_ctrl[i] >= 0)
+        {
+            size_type const     hash = mix(m_hash(old_slots[i].m_key));
+            size_type const     j    = find_insert_index(hash);
+
+            ::new (static_cast<void*>(&pslots[j])) slot(std::move(old_slots[i]));
+            old_slots[i].~slot();
+            set_ctrl(pctrl, j, (std::int8_t)(hash & 0x7F));
+        }
+    }
+
+    if (old_block != nullptr)
+    {
+        m_alloc.deallocate(old_block, block_size(old_capacity));
+    }
+}
+
+template<class K, class V, class H, class E, class A>
+void
+flat_hash_map<K, V, H, E, A>::destroy_slots() noexcept
+{
+    std::int8_t const*  pctrl  = ctrl();
+    slot*               pslots = slots();
+
+    for (size_type i = 0;  i < m_capacity;  ++i)
+    {
+        if (pctrl[i] >= 0)
+        {
+            pslots[i].~slot();
+        }
+    }
+}
+
+#endif  //- FLAT_HASH_MAP_H_DEFINED
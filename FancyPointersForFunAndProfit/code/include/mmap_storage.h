@@ -0,0 +1,265 @@
+//==================================================================================================
+//  File:
+//      mmap_storage.h
+//
+//  Summary:
+//      Defines a file-backed, persistent storage model whose segments are memory-mapped from
+//      disk, along with derived storage models for each of the position-independent addressing
+//      models (based 2D and offset).
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef MMAP_STORAGE_H_DEFINED
+#define MMAP_STORAGE_H_DEFINED
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "based_2d_msk_addressing.h"
+#include "based_2d_sm_addressing.h"
+#include "based_2d_xl_addressing.h"
+#include "offset_addressing.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      mmap_storage_model
+//
+//  Summary:
+//      This base class implements a segmented storage model where each segment is a file that is
+//      mapped into the process's address space with MAP_SHARED.  It provides the same static
+//      interface as storage_model_base, but keeps its own segment table, so that persistent and
+//      heap-based segments can coexist in one process.
+//
+//      A set of segment files is created once by create_segments() and filled by allocating
+//      through any of the derived models; after close_segments() the files hold the complete
+//      object graph.  A later call to open_segments(), in the same process or another one, maps
+//      the files back at whatever addresses the kernel chooses.  Because the based 2D and offset
+//      addressing models store segment-relative values, the object graph is usable immediately,
+//      with no deserialization and no pointer fix-ups.
+//
+//      The first 64 bytes of the first segment hold a header (see segment_header) describing
+//      the segment set.  This is the same region that monotonic_allocation_strategy skips when
+//      it begins allocating from a segment, so the first object allocated after creation (the
+//      root object) always lives at offset 64 in the first segment.
+//
+//      If init_segments() is called without a prior create/open, the segments are mapped from
+//      anonymous memory instead, and the model behaves like storage_model_base.
+//
+//      The segment table is shared by all models derived from this class (including the shared
+//      memory models in shm_storage.h), so only one set of segments can be attached at a time.
+//--------------------------------------------------------------------------------------------------
+//
+class mmap_storage_model
+{
+  public:
+    using difference_type = std::ptrdiff_t;
+    using size_type       = std::size_t;
+
+    enum : size_type
+    {
+        max_segments = 3,           //- Fixed; every segment file is created at once
+        max_size     = 1u << 27,    //- 128 MB segments
+        header_size  = 64           //- Bytes reserved at the start of the first segment
+    };
+
+    struct segment_header
+    {
+        std::uint64_t   m_magic;
+        std::uint64_t   m_segment_count;
+        std::uint64_t   m_segment_size;
+        std::uint64_t   m_next_segment;     //- Saved allocation position, for resuming
+        std::uint64_t   m_next_offset;
+        std::uint64_t   m_reserved[2];
+        std::uint64_t   m_directory;        //- Location of the root directory (root_directory.h)
+    };
+
+  public:
+    static  bool        create_segments(char const* path_prefix, size_type size = max_size);
+    static  bool        open_segments(char const* path_prefix);
+    static  void        close_segments();
+    static  void        sync_segments();
+
+    static  segment_header*     header() noexcept;
+    static  std::string         segment_name(char const* prefix, size_type segment,
+                                             bool shared_memory);
+
+    static  void        allocate_segment(size_type segment, size_type size = max_size);
+    static  void        clear_segments();
+    static  void        init_segments();
+    static  void        reset_segments();
+    static  void        swap_segments();
+
+    static  char*       segment_address(size_type segment) noexcept;
+    static  size_type   segment_size(size_type segment) noexcept;
+    static  size_type   segment_index(void const* p) noexcept;
+
+    static  constexpr   size_type   first_segment_index();
+    static  constexpr   size_type   last_segment_index();
+    static  constexpr   size_type   top_segment_index();
+    static  constexpr   size_type   max_segment_count();
+    static  constexpr   size_type   max_segment_size();
+
+  protected:
+    static  bool        attach_segments(char const* prefix, bool shared_memory, bool create,
+                                        size_type size);
+
+  protected:
+    static  char*       sm_segment_ptrs[max_segments + 2];
+    static  size_type   sm_segment_size[max_segments + 2];
+    static  std::array<int, max_segments + 2>   sm_segment_fds;     //- -1 if not open
+    static  bool        sm_ready;
+};
+
+//------
+//
+inline mmap_storage_model::segment_header*
+mmap_storage_model::header() noexcept
+{
+    return reinterpret_cast<segment_header*>(sm_segment_ptrs[first_segment_index()]);
+}
+
+//------
+//
+inline char*
+mmap_storage_model::segment_address(size_type segment) noexcept
+{
+    return sm_segment_ptrs[segment];
+}
+
+inline mmap_storage_model::size_type
+mmap_storage_model::segment_size(size_type segment) noexcept
+{
+    return sm_segment_size[segment];
+}
+
+//- Returns the index of the segment containing the address p, or zero if there is no such
+//  segment.  These segments are not aligned for a table lookup as storage_model_base's are;
+//  with at most max_segments of them, a scan costs about as much.
+//
+inline mmap_storage_model::size_type
+mmap_storage_model::segment_index(void const* p) noexcept
+{
+    std::uintptr_t const    addr = reinterpret_cast<std::uintptr_t>(p);
+
+    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    {
+        if (addr - reinterpret_cast<std::uintptr_t>(sm_segment_ptrs[i]) < sm_segment_size[i])
+        {
+            return i;
+        }
+    }
+    return 0;
+}
+
+//------
+//
+constexpr inline mmap_storage_model::size_type
+mmap_storage_model::first_segment_index()
+{
+    return 2;
+}
+
+constexpr inline mmap_storage_model::size_type
+mmap_storage_model::last_segment_index()
+{
+    return max_segments + 1;
+}
+
+constexpr inline mmap_storage_model::size_type
+mmap_storage_model::top_segment_index()
+{
+    return max_segments + 1;
+}
+
+constexpr inline mmap_storage_model::size_type
+mmap_storage_model::max_segment_count()
+{
+    return max_segments;
+}
+
+constexpr inline mmap_storage_model::size_type
+mmap_storage_model::max_segment_size()
+{
+    return max_size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+//  Classes:
+//      mmap_based_2d_xl_storage_model
+//      mmap_based_2d_sm_storage_model
+//      mmap_based_2d_msk_storage_model
+//      mmap_offset_storage_model
+//
+//  Summary:
+//      These classes pair the file-backed segments of mmap_storage_model with each of the
+//      position-independent addressing models.  (The wrapper addressing model stores ordinary
+//      pointers, and so cannot be used with persistent segments.)
+//--------------------------------------------------------------------------------------------------
+//
+class mmap_based_2d_xl_storage_model : public mmap_storage_model
+{
+  public:
+    using addressing_model = based_2d_xl_addressing_model<mmap_based_2d_xl_storage_model>;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset=0);
+};
+
+inline mmap_based_2d_xl_storage_model::addressing_model
+mmap_based_2d_xl_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment, offset};
+}
+
+//------
+//
+class mmap_based_2d_sm_storage_model : public mmap_storage_model
+{
+  public:
+    using addressing_model = based_2d_sm_addressing_model<mmap_based_2d_sm_storage_model>;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset=0);
+};
+
+inline mmap_based_2d_sm_storage_model::addressing_model
+mmap_based_2d_sm_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment, offset};
+}
+
+//------
+//
+class mmap_based_2d_msk_storage_model : public mmap_storage_model
+{
+  public:
+    using addressing_model = based_2d_msk_addressing_model<mmap_based_2d_msk_storage_model>;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset=0);
+};
+
+inline mmap_based_2d_msk_storage_model::addressing_model
+mmap_based_2d_msk_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment, offset};
+}
+
+//------
+//
+class mmap_offset_storage_model : public mmap_storage_model
+{
+  public:
+    using addressing_model = offset_addressing_model;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset);
+};
+
+inline mmap_offset_storage_model::addressing_model
+mmap_offset_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment_address(segment) + offset};
+}
+
+#endif  //- MMAP_STORAGE_H_DEFINED
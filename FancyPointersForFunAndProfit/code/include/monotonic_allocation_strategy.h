@@ -13,6 +13,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <new>
 
 #include "synthetic_pointer.h"
 
@@ -44,10 +46,15 @@ class monotonic_allocation_strategy
 
     void_pointer    allocate(size_type n);
     void            deallocate(void_pointer p);
+    bool            try_extend(void_pointer p, size_type n, size_type new_n);
+    void_pointer    reallocate(void_pointer p, size_type n, size_type new_n);
 
     static  void    reset_segments();
     static  void    swap_segments();
 
+    static  void    get_position(size_type& segment, size_type& offset);
+    static  void    set_position(size_type segment, size_type offset);
+
   private:
     static  difference_type     round_up(difference_type x, difference_type r);
 
@@ -93,11 +100,34 @@ monotonic_allocation_strategy<SM>::allocate(size_type n)
     size_type   chunk_size   = round_up(n, 16u);
     size_type   chunk_offset = sm_curr_offset;
 
-    if ((chunk_offset + chunk_size) > storage_model::max_segment_size())
+    if (chunk_size > storage_model::max_segment_size() - 64)
+    {
+        throw std::bad_alloc();
+    }
+
+    //- Segments after the first are allocated on demand, when the current one is exhausted.
+    //  Segments may be smaller than max_segment_size() (persistent ones, for example, are as
+    //  large as their files), so each is filled only up to its own size.
+    //  The position moves to the new segment only once it is known to exist, so that a failure
+    //  (or an exception from allocate_segment()) leaves the strategy as it was.
+    //
+    if ((chunk_offset + chunk_size) > storage_model::segment_size(sm_curr_segment))
     {
-        ++sm_curr_segment;
-        chunk_offset   = 64;
-        sm_curr_offset = chunk_offset + chunk_size;
+        size_type const     next = sm_curr_segment + 1;
+
+        if (sm_curr_segment >= storage_model::last_segment_index())
+        {
+            throw std::bad_alloc();
+        }
+        storage_model::allocate_segment(next);
+        if (storage_model::segment_address(next) == nullptr  ||
+            (64 + chunk_size) > storage_model::segment_size(next))
+        {
+            throw std::bad_alloc();
+        }
+        chunk_offset    = 64;
+        sm_curr_segment = next;
+        sm_curr_offset  = chunk_offset + chunk_size;
     }
     else
     {
@@ -112,6 +142,57 @@ void
 monotonic_allocation_strategy<SM>::deallocate(void_pointer)
 {}
 
+//------
+//- Changes the size of the chunk at p, which was allocated with size n, to new_n, if that chunk
+//  is the last one handed out and the current segment has room for the new size.  Returns
+//  whether the chunk was resized; if not, nothing has changed.  This lets a container grow its
+//  most recent buffer in place, rather than copying it to a new chunk and leaking the old one.
+//
+template<class SM>
+bool
+monotonic_allocation_strategy<SM>::try_extend(void_pointer p, size_type n, size_type new_n)
+{
+    if (!sm_initialized  ||  p == nullptr)
+    {
+        return false;
+    }
+
+    size_type   old_size = round_up(n, 16u);
+    size_type   new_size = round_up(new_n, 16u);
+    char*       pend     = static_cast<char*>(p) + old_size;
+    char*       ptop     = storage_model::segment_address(sm_curr_segment) + sm_curr_offset;
+
+    if (pend != ptop  ||
+        (sm_curr_offset - old_size + new_size) > storage_model::segment_size(sm_curr_segment))
+    {
+        return false;
+    }
+    sm_curr_offset = sm_curr_offset - old_size + new_size;
+    return true;
+}
+
+//- Resizes the chunk at p, which was allocated with size n, to new_n: in place if possible, and
+//  otherwise by copying the first min(n, new_n) bytes to a new chunk.  Returns the resized chunk.
+//
+template<class SM>
+typename monotonic_allocation_strategy<SM>::void_pointer
+monotonic_allocation_strategy<SM>::reallocate(void_pointer p, size_type n, size_type new_n)
+{
+    if (try_extend(p, n, new_n))
+    {
+        return p;
+    }
+
+    void_pointer    q = allocate(new_n);
+
+    if (p != nullptr)
+    {
+        std::memcpy(static_cast<void*>(q), static_cast<void*>(p), (n < new_n) ? n : new_n);
+        deallocate(p);
+    }
+    return q;
+}
+
 //------
 //
 template<class SM> inline
@@ -130,6 +211,33 @@ monotonic_allocation_strategy<SM>::swap_segments()
     storage_model::swap_segments();
 }
 
+//------
+//- These two functions allow the current allocation position to be saved alongside persistent
+//  segments, and restored when those segments are reopened, so that allocation resumes after
+//  the last chunk handed out instead of overwriting the existing objects.
+//
+template<class SM> inline
+void
+monotonic_allocation_strategy<SM>::get_position(size_type& segment, size_type& offset)
+{
+    segment = sm_curr_segment;
+    offset  = sm_curr_offset;
+}
+
+template<class SM> inline
+void
+monotonic_allocation_strategy<SM>::set_position(size_type segment, size_type offset)
+{
+    storage_model::init_segments();
+    for (size_type i = storage_model::first_segment_index();  i <= segment;  ++i)
+    {
+        storage_model::allocate_segment(i);
+    }
+    sm_curr_segment = segment;
+    sm_curr_offset  = offset;
+    sm_initialized  = true;
+}
+
 //------
 //
 template<class SM> inline
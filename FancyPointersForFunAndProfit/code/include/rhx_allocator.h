@@ -11,9 +11,32 @@
 #ifndef RHX_ALLOCATOR_H_DEFINED
 #define RHX_ALLOCATOR_H_DEFINED
 
+#include <cstring>
 #include <type_traits>
 #include <memory>
 
+//--------------------------------------------------------------------------------------------------
+//  Class Template:
+//      has_try_extend<X, P>
+//
+//  Summary:
+//      This trait detects whether an allocation strategy or allocator X can resize its most
+//      recent allocation in place, through a member function try_extend(P p, size_type n,
+//      size_type new_n), where P is a pointer type accepted by X (by default, its void_pointer).
+//--------------------------------------------------------------------------------------------------
+//
+template<class X, class P = typename X::void_pointer, class = void>
+struct has_try_extend : std::false_type
+{};
+
+template<class X, class P>
+struct has_try_extend<X, P, std::void_t<decltype(std::declval<X&>().try_extend(
+                                                     std::declval<P>(),
+                                                     std::declval<typename X::size_type>(),
+                                                     std::declval<typename X::size_type>()))>>
+    : std::true_type
+{};
+
 //--------------------------------------------------------------------------------------------------
 //  Class Template:
 //      rhx_allocator<T,HT>
@@ -66,6 +89,9 @@ class rhx_allocator
     pointer     allocate(size_type n, const_void_pointer p);
     void        deallocate(pointer p, size_type n);
 
+    bool        try_extend(pointer p, size_type n, size_type new_n);
+    pointer     reallocate(pointer p, size_type n, size_type new_n);
+
     template<class U, class... Args>
     void        construct(U* p, Args&&... args);
 
@@ -184,6 +210,49 @@ rhx_allocator<T, HT>::deallocate(pointer p, size_type)
     m_heap.deallocate(p);
 }
 
+//- Resizes the array of n objects at p to hold new_n objects without moving it, if the heap
+//  supports that (see has_try_extend) and p is its most recent allocation.  Returns whether the
+//  array was resized.
+//
+template<class T, class HT> inline
+bool
+rhx_allocator<T, HT>::try_extend(pointer p, size_type n, size_type new_n)
+{
+    if constexpr (has_try_extend<HT>::value)
+    {
+        return m_heap.try_extend(p, n * sizeof(T), new_n * sizeof(T));
+    }
+    else
+    {
+        return false;
+    }
+}
+
+//- Resizes the array of n objects at p to hold new_n objects, in place if possible, and
+//  otherwise by copying the first min(n, new_n) objects' bytes to a new array and freeing the
+//  old one.  Returns a pointer to the resized array.  For trivially copyable T only.
+//
+template<class T, class HT>
+typename rhx_allocator<T, HT>::pointer
+rhx_allocator<T, HT>::reallocate(pointer p, size_type n, size_type new_n)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "reallocate() requires trivially copyable T");
+
+    if (p != nullptr  &&  try_extend(p, n, new_n))
+    {
+        return p;
+    }
+
+    pointer     q = allocate(new_n);
+
+    if (p != nullptr)
+    {
+        std::memcpy(static_cast<T*>(q), static_cast<T*>(p), ((n < new_n) ? n : new_n) * sizeof(T));
+        deallocate(p, n);
+    }
+    return q;
+}
+
 template<class T, class HT>
 template<class U, class... Args> inline
 void
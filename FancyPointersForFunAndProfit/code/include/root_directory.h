@@ -0,0 +1,364 @@
+//==================================================================================================
+//  File:
+//      root_directory.h
+//
+//  Summary:
+//      Defines a directory of named root objects, kept in the segments themselves, so that the
+//      objects can be found again after the segments are relocated, reopened, or attached by
+//      another process.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef ROOT_DIRECTORY_H_DEFINED
+#define ROOT_DIRECTORY_H_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      root_directory<AS>
+//
+//  Summary:
+//      This class template maps names to objects allocated from allocation strategy AS.  Each
+//      name is bound to an AS::void_pointer, so the directory is exactly as position-independent
+//      as AS's pointers are.
+//
+//      The directory is an open-addressed hash table, with linear probing and names of up to
+//      max_name characters held inline in its entries, so a lookup hashes the name once and
+//      usually reads a single entry.  The table is allocated from AS, and is doubled (and the
+//      old one deallocated) when it becomes three-quarters full.
+//
+//      The table's location is recorded as a (segment, offset) pair in the last eight bytes of
+//      the 64 bytes that the allocation strategies reserve at the start of the first segment
+//      (and that mmap_storage_model's segment_header leaves unused).  Given only the segments,
+//      then, the directory can be found at once, wherever they happen to be mapped.  Clearing
+//      or resetting the segments zeroes the location, which leaves the directory empty.
+//
+//      Like the monotonic strategy, the directory is not synchronized; concurrent binds (or a
+//      bind concurrent with lookups) must be serialized by the caller.
+//--------------------------------------------------------------------------------------------------
+//
+template<class AS>
+class root_directory
+{
+  public:
+    using void_pointer = typename AS::void_pointer;
+    using size_type    = std::size_t;
+
+    template<class T>
+    using rebind_pointer = typename AS::template rebind_pointer<T>;
+
+    enum : size_type
+    {
+        header_offset = 56,     //- Location of the table's address in the first segment
+        max_name      = 47,     //- Longest name that can be bound
+        min_capacity  = 16
+    };
+
+  public:
+    static  bool            bind(std::string_view name, void_pointer p);
+    static  bool            unbind(std::string_view name);
+    static  void_pointer    find(std::string_view name);
+    template<class T>
+    static  rebind_pointer<T>   find(std::string_view name);
+    static  size_type       size();
+
+  private:
+    using storage_model = typename AS::storage_model;
+
+    struct location
+    {
+        std::uint32_t   m_segment;      //- Zero if there is no table
+        std::uint32_t   m_offset;
+    };
+
+    struct entry
+    {
+        std::uint64_t   m_hash;         //- Zero if the entry is empty
+        void_pointer    m_object;
+        char            m_name[max_name + 1];
+    };
+
+    struct table
+    {
+        std::uint32_t   m_count;
+        std::uint32_t   m_capacity;     //- A power of two
+        std::uint64_t   m_reserved;
+
+        entry*  entries() noexcept      { return reinterpret_cast<entry*>(this + 1); }
+    };
+
+    static_assert(sizeof(table) % alignof(entry) == 0, "root_directory entries are misaligned");
+
+    static  location*       slot() noexcept;
+    static  table*          get_table() noexcept;
+    static  table*          make_table(size_type capacity);
+    static  void            set_table(table* ptable) noexcept;
+    static  bool            grow();
+
+    static  entry*          probe(table* ptable, std::uint64_t hash, std::string_view name) noexcept;
+    static  std::uint64_t   hash_name(std::string_view name) noexcept;
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Facility:   root_directory<AS> implementation
+//--------------------------------------------------------------------------------------------------
+//
+//- Binds name to p, replacing any previous binding.  Returns false if the name is empty or too
+//  long, or if the table could not be allocated.
+//
+template<class AS>
+bool
+root_directory<AS>::bind(std::string_view name, void_pointer p)
+{
+    if (name.empty()  ||  name.size() > max_name)
+    {
+        return false;
+    }
+
+    table*  ptable = get_table();
+
+    if (ptable == nullptr  ||  4 * (ptable->m_count + 1) > 3 * ptable->m_capacity)
+    {
+        if (!grow())
+        {
+            return false;
+        }
+        ptable = get_table();
+    }
+
+    std::uint64_t const     hash = hash_name(name);
+    entry*                  pent = probe(ptable, hash, name);
+
+    if (pent->m_hash == 0)
+    {
+        pent->m_hash = hash;
+        std::memcpy(pent->m_name, name.data(), name.size());
+        pent->m_name[name.size()] = '\0';
+        ++ptable->m_count;
+    }
+    pent->m_object = p;
+    return true;
+}
+
+//- Removes the binding for name, if there is one.  The entries that follow it in its probe
+//  sequence are shifted back, so that no tombstones are needed.
+//
+template<class AS>
+bool
+root_directory<AS>::unbind(std::string_view name)
+{
+    table*  ptable = get_table();
+
+    if (ptable == nullptr)
+    {
+        return false;
+    }
+
+    entry*  pents = ptable->entries();
+    entry*  pent  = probe(ptable, hash_name(name), name);
+
+    if (pent->m_hash == 0)
+    {
+        return false;
+    }
+
+    size_type const     mask = ptable->m_capacity - 1;
+    size_type           hole = pent - pents;
+
+    for (size_type i = (hole + 1) & mask;  pents[i].m_hash != 0;  i = (i + 1) & mask)
+    {
+        size_type const     home = pents[i].m_hash & mask;
+
+        //- An entry may fill the hole only if the hole lies cyclically in [home, i).
+        //
+        if (((i - home) & mask) >= ((i - hole) & mask))
+        {
+            pents[hole] = pents[i];
+            hole        = i;
+        }
+    }
+    pents[hole].m_hash   = 0;
+    pents[hole].m_object = nullptr;
+    --ptable->m_count;
+    return true;
+}
+
+//- Returns the object bound to name, or null if there is none.
+//
+template<class AS>
+typename root_directory<AS>::void_pointer
+root_directory<AS>::find(std::string_view name)
+{
+    table*  ptable = get_table();
+
+    if (ptable == nullptr  ||  name.size() > max_name)
+    {
+        return nullptr;
+    }
+    return probe(ptable, hash_name(name), name)->m_object;
+}
+
+template<class AS>
+template<class T> inline
+typename root_directory<AS>::template rebind_pointer<T>
+root_directory<AS>::find(std::string_view name)
+{
+    return static_cast<rebind_pointer<T>>(find(name));
+}
+
+template<class AS>
+typename root_directory<AS>::size_type
+root_directory<AS>::size()
+{
+    table*  ptable = get_table();
+
+    return (ptable != nullptr) ? ptable->m_count : 0;
+}
+
+//------
+//
+template<class AS> inline
+typename root_directory<AS>::location*
+root_directory<AS>::slot() noexcept
+{
+    char*   pbase = storage_model::segment_address(storage_model::first_segment_index());
+
+    return (pbase != nullptr) ? reinterpret_cast<location*>(pbase + header_offset) : nullptr;
+}
+
+template<class AS> inline
+typename root_directory<AS>::table*
+root_directory<AS>::get_table() noexcept
+{
+    location*   ploc = slot();
+
+    if (ploc == nullptr  ||  ploc->m_segment == 0)
+    {
+        return nullptr;
+    }
+
+    char*   pseg = storage_model::segment_address(ploc->m_segment);
+
+    return (pseg != nullptr) ? reinterpret_cast<table*>(pseg + ploc->m_offset) : nullptr;
+}
+
+//- Allocates and initializes an empty table.  The allocation strategies report exhaustion by
+//  throwing std::bad_alloc; that is caught here, and reported as a null result, so that bind()
+//  can return false as documented.
+//
+template<class AS>
+typename root_directory<AS>::table*
+root_directory<AS>::make_table(size_type capacity)
+{
+    void_pointer    vp;
+
+    try
+    {
+        vp = AS().allocate(sizeof(table) + capacity * sizeof(entry));
+    }
+    catch (std::bad_alloc const&)
+    {
+        return nullptr;
+    }
+
+    table*  ptable = ::new (static_cast<void*>(vp)) table{0, static_cast<std::uint32_t>(capacity), 0};
+    entry*  pents  = ptable->entries();
+
+    for (size_type i = 0;  i < capacity;  ++i)
+    {
+        ::new (static_cast<void*>(pents + i)) entry{0, nullptr, {}};
+    }
+    return ptable;
+}
+
+template<class AS> inline
+void
+root_directory<AS>::set_table(table* ptable) noexcept
+{
+    location*   ploc    = slot();
+    size_type   segment = storage_model::segment_index(ptable);
+
+    ploc->m_segment = static_cast<std::uint32_t>(segment);
+    ploc->m_offset  = static_cast<std::uint32_t>(reinterpret_cast<char*>(ptable) -
+                                                 storage_model::segment_address(segment));
+}
+
+//- Replaces the table with one twice its size (or creates the first one), and rehashes the
+//  entries into it.  Returns false, leaving the old table in place, if the new one could not
+//  be allocated.
+//
+template<class AS>
+bool
+root_directory<AS>::grow()
+{
+    table*      pold = get_table();
+    size_type   cap  = (pold != nullptr) ? 2 * pold->m_capacity : (size_type) min_capacity;
+    table*      pnew = make_table(cap);
+
+    if (pnew == nullptr)
+    {
+        return false;
+    }
+    if (pold != nullptr)
+    {
+        entry*  pents = pold->entries();
+
+        for (size_type i = 0;  i < pold->m_capacity;  ++i)
+        {
+            if (pents[i].m_hash != 0)
+            {
+                *probe(pnew, pents[i].m_hash, pents[i].m_name) = pents[i];
+                ++pnew->m_count;
+            }
+        }
+        AS().deallocate(void_pointer(static_cast<void*>(pold)));
+    }
+    set_table(pnew);
+    return true;
+}
+
+//------
+//- Returns the entry holding name, or else the empty entry that ends its probe sequence.  The
+//  table is never full, so there always is one.
+//
+template<class AS> inline
+typename root_directory<AS>::entry*
+root_directory<AS>::probe(table* ptable, std::uint64_t hash, std::string_view name) noexcept
+{
+    entry*              pents = ptable->entries();
+    size_type const     mask  = ptable->m_capacity - 1;
+
+    for (size_type i = hash & mask;  ;  i = (i + 1) & mask)
+    {
+        if (pents[i].m_hash == 0  ||
+            (pents[i].m_hash == hash  &&  name == std::string_view(pents[i].m_name)))
+        {
+            return pents + i;
+        }
+    }
+}
+
+//- FNV-1a, with a final mix so that the low bits (which pick the home entry) depend on every
+//  character.  Zero marks an empty entry, so it is never returned.
+//
+template<class AS> inline
+std::uint64_t
+root_directory<AS>::hash_name(std::string_view name) noexcept
+{
+    std::uint64_t   h = 0xCBF29CE484222325ull;
+
+    for (char c : name)
+    {
+        h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+    }
+    h ^= h >> 32;
+    return (h != 0) ? h : 1;
+}
+
+#endif  //- ROOT_DIRECTORY_H_DEFINED
@@ -0,0 +1,403 @@
+//==================================================================================================
+//  File:
+//      seg_vector.h
+//
+//  Summary:
+//      Defines a vector-like sequence container for the relocatable allocation strategies, which
+//      grows in place where it can, and otherwise in fixed-size chunks.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef SEG_VECTOR_H_DEFINED
+#define SEG_VECTOR_H_DEFINED
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "rhx_allocator.h"
+#include "synthetic_pointer.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      seg_vector<T, AS, ChunkBytes>
+//
+//  Summary:
+//      This class template implements a sequence of T whose elements live in storage obtained
+//      from allocation strategy AS, and are reached through AS's synthetic pointers.
+//
+//      The elements are held in chunks of a fixed capacity, a power of two no larger than
+//      ChunkBytes, listed in a directory; element i is element i % C of chunk i / C.  Until the
+//      sequence outgrows one chunk, that chunk grows geometrically, and in place when AS
+//      provides try_extend() and the chunk is its most recent allocation; otherwise it is moved
+//      to a larger one.  After that, each chunk is allocated full-size and never moves.  An
+//      append therefore never copies more than one chunk, and with a leaky strategy such as
+//      monotonic_allocation_strategy, an outgrown buffer is never larger than one chunk either,
+//      where std::vector leaves behind every buffer it outgrows.
+//
+//      Element access resolves two synthetic pointers, the directory and the chunk.  For fast
+//      traversal, for_each_chunk() presents each chunk as a native span.
+//--------------------------------------------------------------------------------------------------
+//
+template<class T, class AS, std::size_t ChunkBytes = (1u << 18)>
+class seg_vector
+{
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = T&;
+    using const_reference = T const&;
+
+  public:
+    ~seg_vector();
+
+    seg_vector();
+    seg_vector(seg_vector const&) = delete;
+    seg_vector&     operator =(seg_vector const&) = delete;
+
+    size_type       size() const noexcept;
+    size_type       capacity() const noexcept;
+    size_type       chunk_count() const noexcept;
+    bool            empty() const noexcept;
+
+    reference       operator [](size_type i) noexcept;
+    const_reference operator [](size_type i) const noexcept;
+    reference       back() noexcept;
+    const_reference back() const noexcept;
+
+    void            push_back(T const& value);
+    void            push_back(T&& value);
+    template<class... Args>
+    reference       emplace_back(Args&&... args);
+    void            pop_back() noexcept;
+    void            clear() noexcept;
+
+    template<class F>
+    void            for_each_chunk(F&& f) const;
+
+  private:
+    using chunk_pointer = typename AS::template rebind_pointer<T>;
+    using dir_pointer   = typename AS::template rebind_pointer<chunk_pointer>;
+
+    static constexpr size_type  floor_log2(size_type n) noexcept
+                                {
+                                    return (n > 1) ? 1 + floor_log2(n / 2) : 0;
+                                }
+
+    enum : size_type
+    {
+        chunk_shift    = floor_log2((ChunkBytes / sizeof(T) > 0) ? ChunkBytes / sizeof(T) : 1),
+        chunk_capacity = size_type(1) << chunk_shift,
+        chunk_mask     = chunk_capacity - 1,
+        first_capacity = (chunk_capacity < 16) ? chunk_capacity : 16,
+        first_dir_size = 8
+    };
+
+    dir_pointer     mp_dir;
+    size_type       m_size;
+    size_type       m_capacity;         //- Total capacity of the chunks
+    size_type       m_chunks;
+    size_type       m_dir_capacity;
+    AS              m_heap;
+
+    chunk_pointer*  dir() const noexcept;
+    T*              slot(size_type i) const noexcept;
+
+    void            grow();
+    void            grow_first_chunk();
+    void            grow_directory();
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Facility:   seg_vector<T, AS, ChunkBytes> implementation
+//--------------------------------------------------------------------------------------------------
+//
+template<class T, class AS, std::size_t CB> inline
+seg_vector<T, AS, CB>::~seg_vector()
+{
+    clear();
+
+    chunk_pointer*  pdir = dir();
+
+    for (size_type k = 0;  k < m_chunks;  ++k)
+    {
+        m_heap.deallocate(pdir[k]);
+        pdir[k].~chunk_pointer();
+    }
+    if (mp_dir != nullptr)
+    {
+        m_heap.deallocate(mp_dir);
+    }
+}
+
+template<class T, class AS, std::size_t CB> inline
+seg_vector<T, AS, CB>::seg_vector()
+:   mp_dir(nullptr)
+,   m_size(0)
+,   m_capacity(0)
+,   m_chunks(0)
+,   m_dir_capacity(0)
+,   m_heap()
+{}
+
+//------
+//
+template<class T, class AS, std::size_t CB> inline
+typename seg_vector<T, AS, CB>::size_type
+seg_vector<T, AS, CB>::size() const noexcept
+{
+    return m_size;
+}
+
+template<class T, class AS, std::size_t CB> inline
+typename seg_vector<T, AS, CB>::size_type
+seg_vector<T, AS, CB>::capacity() const noexcept
+{
+    return m_capacity;
+}
+
+template<class T, class AS, std::size_t CB> inline
+typename seg_vector<T, AS, CB>::size_type
+seg_vector<T, AS, CB>::chunk_count() const noexcept
+{
+    return m_chunks;
+}
+
+template<class T, class AS, std::size_t CB> inline
+bool
+seg_vector<T, AS, CB>::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+//------
+//
+template<class T, class AS, std::size_t CB> inline
+typename seg_vector<T, AS, CB>::reference
+seg_vector<T, AS, CB>::operator [](size_type i) noexcept
+{
+    return *slot(i);
+}
+
+template<class T, class AS, std::size_t CB> inline
+typename seg_vector<T, AS, CB>::const_reference
+seg_vector<T, AS, CB>::operator [](size_type i) const noexcept
+{
+    return *slot(i);
+}
+
+template<class T, class AS, std::size_t CB> inline
+typename seg_vector<T, AS, CB>::reference
+seg_vector<T, AS, CB>::back() noexcept
+{
+    return *slot(m_size - 1);
+}
+
+template<class T, class AS, std::size_t CB> inline
+typename seg_vector<T, AS, CB>::const_reference
+seg_vector<T, AS, CB>::back() const noexcept
+{
+    return *slot(m_size - 1);
+}
+
+//------
+//
+template<class T, class AS, std::size_t CB> inline
+void
+seg_vector<T, AS, CB>::push_back(T const& value)
+{
+    emplace_back(value);
+}
+
+template<class T, class AS, std::size_t CB> inline
+void
+seg_vector<T, AS, CB>::push_back(T&& value)
+{
+    emplace_back(std::move(value));
+}
+
+template<class T, class AS, std::size_t CB>
+template<class... Args> inline
+typename seg_vector<T, AS, CB>::reference
+seg_vector<T, AS, CB>::emplace_back(Args&&... args)
+{
+    if (m_size == m_capacity)
+    {
+        grow();
+    }
+
+    T*  p = ::new (static_cast<void*>(slot(m_size))) T(std::forward<Args>(args)...);
+
+    ++m_size;
+    return *p;
+}
+
+template<class T, class AS, std::size_t CB> inline
+void
+seg_vector<T, AS, CB>::pop_back() noexcept
+{
+    slot(--m_size)->~T();
+}
+
+//- Destroys the elements, but keeps the chunks for reuse.
+//
+template<class T, class AS, std::size_t CB>
+void
+seg_vector<T, AS, CB>::clear() noexcept
+{
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+        for_each_chunk([](raw_span<T> chunk)
+        {
+            for (T& elem : chunk)
+            {
+                elem.~T();
+            }
+        });
+    }
+    m_size = 0;
+}
+
+//------
+//- Calls f(raw_span<T>) for each chunk's elements, in order.  Each chunk is resolved once.
+//
+template<class T, class AS, std::size_t CB>
+template<class F>
+void
+seg_vector<T, AS, CB>::for_each_chunk(F&& f) const
+{
+    chunk_pointer const*    pdir = dir();
+
+    for (size_type k = 0, first = 0;  first < m_size;  ++k, first += chunk_capacity)
+    {
+        size_type   n = (m_size - first < chunk_capacity) ? m_size - first : chunk_capacity;
+
+        f(to_span(pdir[k], pdir[k] + n));
+    }
+}
+
+//------
+//
+template<class T, class AS, std::size_t CB> inline
+typename seg_vector<T, AS, CB>::chunk_pointer*
+seg_vector<T, AS, CB>::dir() const noexcept
+{
+    return to_address(mp_dir);
+}
+
+template<class T, class AS, std::size_t CB> inline
+T*
+seg_vector<T, AS, CB>::slot(size_type i) const noexcept
+{
+    return to_address(dir()[i >> chunk_shift]) + (i & chunk_mask);
+}
+
+//------
+//
+template<class T, class AS, std::size_t CB>
+void
+seg_vector<T, AS, CB>::grow()
+{
+    if (m_capacity < chunk_capacity)
+    {
+        grow_first_chunk();
+    }
+    else
+    {
+        if (m_chunks == m_dir_capacity)
+        {
+            grow_directory();
+        }
+
+        chunk_pointer   p = static_cast<chunk_pointer>(m_heap.allocate(chunk_capacity * sizeof(T)));
+
+        ::new (static_cast<void*>(dir() + m_chunks)) chunk_pointer(p);
+        ++m_chunks;
+        m_capacity += chunk_capacity;
+    }
+}
+
+//- Doubles the capacity of the first (and only) chunk, in place if the strategy allows, and
+//  otherwise by moving the elements to a new chunk.  The capacity never exceeds one chunk.
+//
+template<class T, class AS, std::size_t CB>
+void
+seg_vector<T, AS, CB>::grow_first_chunk()
+{
+    size_type   new_capacity = (m_capacity == 0) ? first_capacity : 2 * m_capacity;
+
+    if (m_chunks == 0)
+    {
+        grow_directory();
+
+        chunk_pointer   p = static_cast<chunk_pointer>(m_heap.allocate(new_capacity * sizeof(T)));
+
+        ::new (static_cast<void*>(dir())) chunk_pointer(p);
+        m_chunks   = 1;
+        m_capacity = new_capacity;
+        return;
+    }
+
+    chunk_pointer&  first = dir()[0];
+
+    if constexpr (has_try_extend<AS>::value)
+    {
+        if (m_heap.try_extend(first, m_capacity * sizeof(T), new_capacity * sizeof(T)))
+        {
+            m_capacity = new_capacity;
+            return;
+        }
+    }
+
+    chunk_pointer   p   = static_cast<chunk_pointer>(m_heap.allocate(new_capacity * sizeof(T)));
+    T*              src = to_address(first);
+    T*              dst = to_address(p);
+
+    for (size_type i = 0;  i < m_size;  ++i)
+    {
+        ::new (static_cast<void*>(dst + i)) T(std::move_if_noexcept(src[i]));
+        src[i].~T();
+    }
+    m_heap.deallocate(first);
+    first      = p;
+    m_capacity = new_capacity;
+}
+
+//- Doubles the capacity of the chunk directory, in place if the strategy allows, and otherwise
+//  by copying the chunk pointers to a new directory.
+//
+template<class T, class AS, std::size_t CB>
+void
+seg_vector<T, AS, CB>::grow_directory()
+{
+    size_type   new_capacity = (m_dir_capacity == 0) ? first_dir_size : 2 * m_dir_capacity;
+
+    if constexpr (has_try_extend<AS>::value)
+    {
+        if (m_heap.try_extend(mp_dir, m_dir_capacity * sizeof(chunk_pointer), new_capacity * sizeof(chunk_pointer)))
+        {
+            m_dir_capacity = new_capacity;
+            return;
+        }
+    }
+
+    dir_pointer     p   = static_cast<dir_pointer>(m_heap.allocate(new_capacity * sizeof(chunk_pointer)));
+    chunk_pointer*  src = dir();
+    chunk_pointer*  dst = to_address(p);
+
+    for (size_type k = 0;  k < m_chunks;  ++k)
+    {
+        ::new (static_cast<void*>(dst + k)) chunk_pointer(src[k]);
+        src[k].~chunk_pointer();
+    }
+    if (mp_dir != nullptr)
+    {
+        m_heap.deallocate(mp_dir);
+    }
+    mp_dir         = p;
+    m_dir_capacity = new_capacity;
+}
+
+#endif  //- SEG_VECTOR_H_DEFINED
@@ -0,0 +1,93 @@
+//==================================================================================================
+//  File:
+//      segment_pin.h
+//
+//  Summary:
+//      Defines a scope guard that takes a local snapshot of a storage model's segment table, for
+//      use by the based addressing models in tight loops.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef SEGMENT_PIN_H_DEFINED
+#define SEGMENT_PIN_H_DEFINED
+
+#include <cstddef>
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      segment_pin<SM>
+//
+//  Summary:
+//      This class template copies the base addresses of storage model SM's segments into an
+//      array of its own when it is constructed.  The based addressing models provide overloads
+//      of address() that take a pin and read the base address from it, instead of from the
+//      storage model's static table.
+//
+//      The static table may be changed through any char pointer, so the compiler must reload
+//      it after every store made through a resolved pointer.  A pin that lives on the stack,
+//      and whose address does not escape, cannot be aliased in that way.  The base address of
+//      the first segment, where small data sets live entirely, is also kept apart from the
+//      array, so that it can stay in a register; resolving a pointer into that segment then
+//      costs a compare and an add, rather than a load that the next node hop must wait for.
+//
+//      The snapshot is taken once, so while a pin is in scope, segments must be neither
+//      relocated (swap_segments()) nor allocated, and the pin is best suited to read-mostly
+//      traversals.  Segment indices beyond the snapshot capacity fall back to the table.
+//--------------------------------------------------------------------------------------------------
+//
+template<class SM>
+class segment_pin
+{
+  public:
+    using size_type = std::size_t;
+
+    enum : size_type
+    {
+        capacity = 64
+    };
+
+  public:
+    segment_pin() noexcept;
+    segment_pin(segment_pin const&) = delete;
+    segment_pin&    operator =(segment_pin const&) = delete;
+
+    char*   segment_address(size_type segment) const noexcept;
+
+  private:
+    size_type   m_first;
+    char*       m_first_base;
+    size_type   m_count;
+    char*       m_bases[capacity];
+};
+
+//------
+//
+template<class SM> inline
+segment_pin<SM>::segment_pin() noexcept
+:   m_first{SM::first_segment_index()}
+,   m_first_base{SM::segment_address(SM::first_segment_index())}
+,   m_count{0}
+{
+    size_type   top = SM::top_segment_index() + 1;
+
+    m_count = (top < capacity) ? top : capacity;
+
+    for (size_type i = 0;  i < m_count;  ++i)
+    {
+        m_bases[i] = SM::segment_address(i);
+    }
+}
+
+template<class SM> inline
+char*
+segment_pin<SM>::segment_address(size_type segment) const noexcept
+{
+    if (segment == m_first)
+    {
+        return m_first_base;
+    }
+    return (segment < m_count) ? m_bases[segment] : SM::segment_address(segment);
+}
+
+#endif  //- SEGMENT_PIN_H_DEFINED
@@ -0,0 +1,313 @@
+//==================================================================================================
+//  File:
+//      segregated_fit_allocation_strategy.h
+//
+//  Summary:
+//      Defines an allocation strategy class that reclaims deallocated memory, using free lists
+//      segregated by size class and stored in the segments themselves.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef SEGREGATED_FIT_ALLOCATION_STRATEGY_H_DEFINED
+#define SEGREGATED_FIT_ALLOCATION_STRATEGY_H_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "synthetic_pointer.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      segregated_fit_allocation_strategy<SM>
+//
+//  Summary:
+//      This class implements an allocation strategy with constant-time allocation and
+//      deallocation.  Requests are rounded up to one of a fixed set of size classes: multiples of
+//      16 bytes up to 1 KB, and powers of two above that.  Each size class has a singly-linked
+//      list of free blocks; allocation pops the head of the list for the request's class, or, if
+//      the list is empty, carves a new block from the current segment with a bump pointer.
+//      Deallocation pushes the block onto the head of its class's list.
+//
+//      Every block is preceded by a 16-byte header recording its size class, so deallocate()
+//      does not need to be told the size.  The free list links are synthetic pointers stored in
+//      the free blocks, and the list heads and bump position live in a control block at the
+//      start of the first segment.  The allocator's entire state is therefore inside the
+//      segments, and is relocated, persisted, or shared along with them.
+//
+//      As with monotonic_allocation_strategy, this class is not thread-safe.
+//--------------------------------------------------------------------------------------------------
+//
+template<class SM>
+class segregated_fit_allocation_strategy
+{
+  public:
+    using storage_model         = SM;
+    using addressing_model      = typename SM::addressing_model;
+    using difference_type       = typename SM::difference_type;
+    using size_type             = typename SM::size_type;
+    using void_pointer          = syn_ptr<void, addressing_model>;
+    using const_void_pointer    = syn_ptr<void const, addressing_model>;
+
+    template<class T>
+    using rebind_pointer        = syn_ptr<T, addressing_model>;
+
+    enum : size_type
+    {
+        small_class_count = 64,         //- 16, 32, ..., 1024 bytes
+        large_class_count = 16,         //- 2 KB, 4 KB, ..., 64 MB
+        class_count       = small_class_count + large_class_count,
+        small_limit       = 16 * small_class_count,
+        header_size       = 16
+    };
+
+  public:
+    size_type       max_size() const;
+
+    void_pointer    allocate(size_type n);
+    void            deallocate(void_pointer p);
+
+    static  void    get_position(size_type& segment, size_type& offset);
+    static  void    reset_segments();
+    static  void    swap_segments();
+
+    static  size_type   size_class(size_type n) noexcept;
+    static  size_type   class_size(size_type c) noexcept;
+
+  private:
+    struct free_block;
+    using free_pointer = syn_ptr<free_block, addressing_model>;
+
+    struct free_block
+    {
+        free_pointer    m_next;
+    };
+
+    struct block_header
+    {
+        std::uint32_t   m_class;
+        std::uint32_t   m_magic;
+        std::uint64_t   m_reserved;
+    };
+
+    struct control_block
+    {
+        std::uint64_t   m_magic;
+        std::uint64_t   m_segment;
+        std::uint64_t   m_offset;
+        free_pointer    m_heads[class_count];
+    };
+
+    enum : std::uint32_t
+    {
+        control_magic = 0x5346'4153u,   //- "SAFS"
+        block_magic   = 0x4B4C'4253u    //- "SBLK"
+    };
+
+    static  control_block*  control();
+    static  void            init_control(control_block* pcb);
+    static  size_type       round_up(size_type x, size_type r);
+
+    static  bool    sm_initialized;
+};
+
+//------
+//
+template<class SM>  bool
+segregated_fit_allocation_strategy<SM>::sm_initialized = false;
+
+//------
+//
+template<class SM> inline
+typename segregated_fit_allocation_strategy<SM>::size_type
+segregated_fit_allocation_strategy<SM>::max_size() const
+{
+    return class_size(class_count - 1);
+}
+
+//------
+//
+template<class SM>
+typename segregated_fit_allocation_strategy<SM>::void_pointer
+segregated_fit_allocation_strategy<SM>::allocate(size_type n)
+{
+    control_block*  pcb = control();
+    size_type       c   = size_class(n);
+
+    if (c >= class_count)
+    {
+        throw std::bad_alloc();
+    }
+
+    //- Reuse a free block of the right class, if there is one.
+    //
+    if (free_pointer pfree = pcb->m_heads[c];  pfree != nullptr)
+    {
+        pcb->m_heads[c] = pfree->m_next;
+        return static_cast<void_pointer>(pfree);
+    }
+
+    //- Otherwise, carve a new block (header included) from the current segment, which may be
+    //  smaller than max_segment_size().  The control block persists with the segments, so it
+    //  moves on to a new segment only once that segment is known to exist.
+    //
+    size_type   block_size = class_size(c) + header_size;
+    size_type   offset     = pcb->m_offset;
+
+    if (offset + block_size > storage_model::segment_size(pcb->m_segment))
+    {
+        size_type const     next = pcb->m_segment + 1;
+
+        if (pcb->m_segment >= storage_model::last_segment_index())
+        {
+            throw std::bad_alloc();
+        }
+        storage_model::allocate_segment(next);
+        if (storage_model::segment_address(next) == nullptr  ||
+            (64 + block_size) > storage_model::segment_size(next))
+        {
+            throw std::bad_alloc();
+        }
+        pcb->m_segment = next;
+        offset         = 64;
+    }
+    pcb->m_offset = offset + block_size;
+
+    block_header*   phdr = reinterpret_cast<block_header*>(storage_model::segment_address(pcb->m_segment) + offset);
+
+    phdr->m_class = static_cast<std::uint32_t>(c);
+    phdr->m_magic = block_magic;
+
+    return storage_model::segment_pointer(pcb->m_segment, offset + header_size);
+}
+
+template<class SM>
+void
+segregated_fit_allocation_strategy<SM>::deallocate(void_pointer p)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+
+    char*           pdata = static_cast<char*>(static_cast<void*>(p));
+    block_header*   phdr  = reinterpret_cast<block_header*>(pdata - header_size);
+
+    if (phdr->m_magic == block_magic  &&  phdr->m_class < class_count)
+    {
+        control_block*  pcb    = control();
+        free_block*     pblock = ::new (pdata) free_block;
+
+        pblock->m_next = pcb->m_heads[phdr->m_class];
+        pcb->m_heads[phdr->m_class] = pblock;
+    }
+}
+
+//------
+//
+template<class SM> inline
+void
+segregated_fit_allocation_strategy<SM>::get_position(size_type& segment, size_type& offset)
+{
+    control_block*  pcb = control();
+
+    segment = pcb->m_segment;
+    offset  = pcb->m_offset;
+}
+
+template<class SM> inline
+void
+segregated_fit_allocation_strategy<SM>::reset_segments()
+{
+    //- Zeroing the segments also zeroes the control block, which is then rebuilt on next use.
+    //
+    storage_model::reset_segments();
+}
+
+template<class SM> inline
+void
+segregated_fit_allocation_strategy<SM>::swap_segments()
+{
+    storage_model::swap_segments();
+}
+
+//------
+//
+template<class SM> inline
+typename segregated_fit_allocation_strategy<SM>::size_type
+segregated_fit_allocation_strategy<SM>::size_class(size_type n) noexcept
+{
+    if (n <= small_limit)
+    {
+        return (n == 0) ? 0 : ((n + 15) / 16) - 1;
+    }
+    else
+    {
+        size_type   c = small_class_count;
+
+        for (size_type sz = 2 * small_limit;  sz < n;  sz <<= 1)
+        {
+            ++c;
+        }
+        return c;
+    }
+}
+
+template<class SM> inline
+typename segregated_fit_allocation_strategy<SM>::size_type
+segregated_fit_allocation_strategy<SM>::class_size(size_type c) noexcept
+{
+    return (c < small_class_count) ? 16 * (c + 1)
+                                   : (size_type) (2 * small_limit) << (c - small_class_count);
+}
+
+//------
+//- The control block sits at the start of the first segment, just past the 64 bytes reserved
+//  there.  It is found by address every time, rather than cached, so that it follows the
+//  segment if it moves.
+//
+template<class SM> inline
+typename segregated_fit_allocation_strategy<SM>::control_block*
+segregated_fit_allocation_strategy<SM>::control()
+{
+    if (!sm_initialized)
+    {
+        storage_model::init_segments();
+        sm_initialized = true;
+    }
+
+    char*           pseg = storage_model::segment_address(storage_model::first_segment_index());
+    control_block*  pcb  = reinterpret_cast<control_block*>(pseg + 64);
+
+    if (pcb->m_magic != control_magic)
+    {
+        init_control(pcb);
+    }
+    return pcb;
+}
+
+template<class SM>
+void
+segregated_fit_allocation_strategy<SM>::init_control(control_block* pcb)
+{
+    ::new (pcb) control_block;
+
+    pcb->m_magic   = control_magic;
+    pcb->m_segment = storage_model::first_segment_index();
+    pcb->m_offset  = round_up(64 + sizeof(control_block), 16u);
+
+    for (auto& head : pcb->m_heads)
+    {
+        head = nullptr;
+    }
+}
+
+template<class SM> inline
+typename segregated_fit_allocation_strategy<SM>::size_type
+segregated_fit_allocation_strategy<SM>::round_up(size_type x, size_type r)
+{
+    return (x % r) ? (x + r - (x % r)) : x;
+}
+
+#endif  //- SEGREGATED_FIT_ALLOCATION_STRATEGY_H_DEFINED
@@ -0,0 +1,120 @@
+//==================================================================================================
+//  File:
+//      shm_storage.h
+//
+//  Summary:
+//      Defines a storage model whose segments are POSIX shared memory objects, so that several
+//      processes can map the same segments, along with derived storage models for each of the
+//      position-independent addressing models.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef SHM_STORAGE_H_DEFINED
+#define SHM_STORAGE_H_DEFINED
+
+#include "mmap_storage.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      shm_storage_model
+//
+//  Summary:
+//      This base class implements a segmented storage model where each segment is a shared
+//      memory object created with shm_open() and mapped with MAP_SHARED.  It differs from its
+//      file-backed base class only in where the segments come from; segment names are formed
+//      from a prefix, as in "/<prefix>.<segment index>".
+//
+//      One process creates the segments and builds its containers in them; any number of other
+//      processes may then open the segments by name.  Each process maps the segments wherever
+//      its kernel chooses and records those addresses in its own copy of the segment table, so
+//      segment_address() resolves per-process while the pages themselves exist only once.
+//
+//      Shared memory objects persist until they are unlinked (or the system restarts), so the
+//      creating process should call unlink_segments() once it is no longer needed.
+//--------------------------------------------------------------------------------------------------
+//
+class shm_storage_model : public mmap_storage_model
+{
+  public:
+    static  bool    create_segments(char const* name_prefix, size_type size = max_size);
+    static  bool    open_segments(char const* name_prefix);
+    static  void    unlink_segments(char const* name_prefix);
+};
+
+
+//--------------------------------------------------------------------------------------------------
+//  Classes:
+//      shm_based_2d_xl_storage_model
+//      shm_based_2d_sm_storage_model
+//      shm_based_2d_msk_storage_model
+//      shm_offset_storage_model
+//
+//  Summary:
+//      These classes pair the shared memory segments of shm_storage_model with each of the
+//      position-independent addressing models.
+//--------------------------------------------------------------------------------------------------
+//
+class shm_based_2d_xl_storage_model : public shm_storage_model
+{
+  public:
+    using addressing_model = based_2d_xl_addressing_model<shm_based_2d_xl_storage_model>;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset=0);
+};
+
+inline shm_based_2d_xl_storage_model::addressing_model
+shm_based_2d_xl_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment, offset};
+}
+
+//------
+//
+class shm_based_2d_sm_storage_model : public shm_storage_model
+{
+  public:
+    using addressing_model = based_2d_sm_addressing_model<shm_based_2d_sm_storage_model>;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset=0);
+};
+
+inline shm_based_2d_sm_storage_model::addressing_model
+shm_based_2d_sm_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment, offset};
+}
+
+//------
+//
+class shm_based_2d_msk_storage_model : public shm_storage_model
+{
+  public:
+    using addressing_model = based_2d_msk_addressing_model<shm_based_2d_msk_storage_model>;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset=0);
+};
+
+inline shm_based_2d_msk_storage_model::addressing_model
+shm_based_2d_msk_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment, offset};
+}
+
+//------
+//
+class shm_offset_storage_model : public shm_storage_model
+{
+  public:
+    using addressing_model = offset_addressing_model;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset);
+};
+
+inline shm_offset_storage_model::addressing_model
+shm_offset_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment_address(segment) + offset};
+}
+
+#endif  //- SHM_STORAGE_H_DEFINED
@@ -12,6 +12,7 @@
 #ifndef STORAGE_MODEL_BASE_H_DEFINED
 #define STORAGE_MODEL_BASE_H_DEFINED
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -21,9 +22,42 @@
 //
 //  Summary:
 //      This base class implements a simple, segmented storage model where segments are allocated
-//      from the process's own heap (i.e., its private address space).  It is intended to be used
-//      by derived classes to implement a small number of alternative storage models - wrapper,
-//      based 2D, and offset.
+//      from the process's own address space.  It is intended to be used by derived classes to
+//      implement a small number of alternative storage models - wrapper, based 2D, and offset.
+//
+//      The number of segments may be set at run time, up to max_segments (the largest count
+//      whose segment indices still fit in the 16-bit segment field of the based_2d_msk
+//      addressing model).  Only the first segment is allocated by init_segments(); the
+//      allocation strategies allocate the others on demand, as each one is needed.  Segments
+//      are reserved as anonymous, zero-filled virtual memory, so physical pages are committed
+//      only as they are first touched rather than all being written up front.
+//
+//      On Linux, swap_segments() relocates each segment with mremap(), which moves its pages to
+//      a new address by updating page tables, so the cost does not depend on the segment's
+//      contents.  Elsewhere (or if mremap() fails) a segment is copied to a shadow buffer.
+//      Shadows are only needed for that, so they are not created until the first copy, and the
+//      pages left behind by each copy are released.
+//
+//      Every segment (and shadow) is placed at an address aligned to max_size, so that each
+//      max_size-aligned slot of the address space holds at most one segment.  A table indexed by
+//      slot number maps addresses back to segment indices, which lets segment_index() find the
+//      segment containing a pointer in constant time, no matter how many segments there are.
+//
+//      snapshot() writes the used part of every segment to a file, along with a table of root
+//      pointers, and restore() reads them back into freshly allocated segments, which are very
+//      likely to be at new addresses.  Only a graph whose pointers are position-independent
+//      (i.e., based or compact, but not wrapper, nor offset pointers that cross segments)
+//      survives the trip.  The roots are native pointers into the segments; they are written as
+//      (segment, offset) pairs and resolved again at the new addresses.  The extent of the used
+//      storage, which an allocation strategy needs in order to resume, is recorded as well.
+//
+//      allocate_segment() may run in one thread while others convert pointers into segments
+//      that already exist, as it does when concurrent_monotonic_allocation_strategy rolls over.
+//      It writes only the new segment's table entries and slot, which no other thread reads
+//      until it has been handed a pointer into that segment, and that hand-off must itself be
+//      a release/acquire pair (the concurrent strategy's position word is one).  The highest
+//      segment index, which segment_pin reads, is kept in an atomic for the same reason.  All
+//      the other functions that change the segments must not run concurrently with any use.
 //--------------------------------------------------------------------------------------------------
 //
 class storage_model_base
@@ -34,8 +68,11 @@ class storage_model_base
 
     enum : size_type
     {
-        max_segments = 3,           //- Don't need many for testing
-        max_size     = 1u << 27     //- 128 MB segments
+        max_segments     = 65534,       //- Indices 2..65535 fit in 16 bits
+        max_size         = 1u << 27,    //- 128 MB segments
+        default_segments = 3,           //- Don't need many for testing
+        slot_shift       = 27,          //- log2(max_size)
+        slot_count       = 1u << 20     //- Slots in a 47-bit user address space
     };
 
   public:
@@ -46,19 +83,35 @@ class storage_model_base
     static  void        reset_segments();
     static  void        swap_segments();
 
+    static  bool        set_segment_count(size_type count);
+
+    static  bool        snapshot(char const* path, size_type top_segment, size_type top_offset,
+                                 void* const* roots, size_type root_count);
+    static  bool        restore(char const* path, size_type& top_segment, size_type& top_offset,
+                                void** roots, size_type root_count);
+
     static  char*       segment_address(size_type segment) noexcept;
     static  size_type   segment_size(size_type segment) noexcept;
+    static  size_type   segment_index(void const* p) noexcept;
 
     static  constexpr   size_type   first_segment_index();
-    static  constexpr   size_type   last_segment_index();
-    static  constexpr   size_type   max_segment_count();
+    static  size_type   last_segment_index() noexcept;
+    static  size_type   top_segment_index() noexcept;
+    static  size_type   max_segment_count() noexcept;
     static  constexpr   size_type   max_segment_size();
 
   protected:
     static  char*       sm_segment_ptrs[max_segments + 2];
     static  size_type   sm_segment_size[max_segments + 2];
     static  char*       sm_shadow_ptrs[max_segments + 2];
+    static  size_type   sm_segment_count;
+    static  std::atomic<size_type>  sm_top_segment;
     static  bool        sm_ready;
+    static  std::uint16_t   sm_slot_segments[slot_count];
+
+  private:
+    static  void        bind_slot(size_type segment);
+    static  void        unbind_slot(size_type segment);
 };
 
 //------
@@ -75,6 +128,27 @@ storage_model_base::segment_size(size_type segment) noexcept
     return sm_segment_size[segment];
 }
 
+//- Returns the index of the segment containing the address p, or zero if there is no such
+//  segment.  The slot table yields the only candidate, and one unsigned comparison confirms it;
+//  an empty slot maps to segment zero, whose size is zero, so that comparison always fails.
+//
+inline storage_model_base::size_type
+storage_model_base::segment_index(void const* p) noexcept
+{
+    std::uintptr_t const    addr = reinterpret_cast<std::uintptr_t>(p);
+    std::uintptr_t const    slot = addr >> slot_shift;
+
+    if (slot >= slot_count)
+    {
+        return 0;
+    }
+
+    size_type const     segment = sm_slot_segments[slot];
+    std::uintptr_t const    base    = reinterpret_cast<std::uintptr_t>(sm_segment_ptrs[segment]);
+
+    return (addr - base < sm_segment_size[segment]) ? segment : 0;
+}
+
 //------
 //
 constexpr inline storage_model_base::size_type
@@ -83,16 +157,27 @@ storage_model_base::first_segment_index()
     return 2;
 }
 
-constexpr inline storage_model_base::size_type
-storage_model_base::last_segment_index()
+//- Returns the index of the last segment that may be allocated.
+//
+inline storage_model_base::size_type
+storage_model_base::last_segment_index() noexcept
 {
-    return max_segments + 1;
+    return sm_segment_count + 1;
 }
 
-constexpr inline storage_model_base::size_type
-storage_model_base::max_segment_count()
+//- Returns the index of the highest segment allocated so far, which bounds the segments that
+//  can hold any object.
+//
+inline storage_model_base::size_type
+storage_model_base::top_segment_index() noexcept
+{
+    return sm_top_segment.load(std::memory_order_acquire);
+}
+
+inline storage_model_base::size_type
+storage_model_base::max_segment_count() noexcept
 {
-    return max_segments;
+    return sm_segment_count;
 }
 
 constexpr inline storage_model_base::size_type
@@ -57,6 +57,9 @@ class syn_ptr
     using reference         = get_type_or_void_t<T>; //typename std::conditional<std::is_void<T>::value, void, typename std::add_lvalue_reference<T>::type>::type;
     using pointer           = syn_ptr;
     using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus > 201703L
+    using iterator_concept  = std::contiguous_iterator_tag;
+#endif
 
   public:
     //- Special member functions - make intentions explicit.
@@ -118,11 +121,11 @@ class syn_ptr
     template<class U = T, enable_if_non_void_t<T, U> = true> 
     syn_ptr&        operator ++();
     template<class U = T, enable_if_non_void_t<T, U> = true> 
-    syn_ptr const   operator ++(int);
+    syn_ptr         operator ++(int);
     template<class U = T, enable_if_non_void_t<T, U> = true> 
     syn_ptr&        operator --();
     template<class U = T, enable_if_non_void_t<T, U> = true> 
-    syn_ptr const   operator --(int);
+    syn_ptr         operator --(int);
     template<class U = T, enable_if_non_void_t<T, U> = true> 
     syn_ptr&        operator +=(difference_type n);
     template<class U = T, enable_if_non_void_t<T, U> = true> 
@@ -133,6 +136,11 @@ class syn_ptr
     template<class U = T, enable_if_non_void_t<T, U> = true> 
     static  syn_ptr pointer_to(U& e);
 
+    //- Access to the addressing model, for models that carry more than an address (e.g., tags).
+    //
+    AM&         addrmodel() noexcept;
+    AM const&   addrmodel() const noexcept;
+
     //- Additional helper functions used to implement the comparison operators.
     //
     bool    equals(std::nullptr_t) const;
@@ -313,7 +321,7 @@ syn_ptr<T, AM>::operator ++()
 
 template<class T, class AM>
 template<class U, enable_if_non_void_t<T, U>> 
-inline syn_ptr<T, AM> const
+inline syn_ptr<T, AM>
 syn_ptr<T, AM>::operator ++(int)
 {
     syn_ptr   tmp{*this};
@@ -332,7 +340,7 @@ syn_ptr<T, AM>::operator --()
 
 template<class T, class AM>
 template<class U, enable_if_non_void_t<T, U>> 
-inline syn_ptr<T, AM> const
+inline syn_ptr<T, AM>
 syn_ptr<T, AM>::operator --(int)
 {
     syn_ptr   tmp{*this};
@@ -437,6 +445,163 @@ syn_ptr<T, AM>::pointer_to(U& e)
     return syn_ptr(&e);
 }
 
+//------
+//
+template<class T, class AM> inline
+AM&
+syn_ptr<T, AM>::addrmodel() noexcept
+{
+    return m_addrmodel;
+}
+
+template<class T, class AM> inline
+AM const&
+syn_ptr<T, AM>::addrmodel() const noexcept
+{
+    return m_addrmodel;
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Facility:   syn_ptr<T,AM> non-member arithmetic and address resolution
+//--------------------------------------------------------------------------------------------------
+//
+template<class T, class AM> inline syn_ptr<T, AM>
+operator +(typename syn_ptr<T, AM>::difference_type n, syn_ptr<T, AM> p)
+{
+    return p + n;
+}
+
+//- Returns the native address of a synthetic pointer's target, like C++20 std::to_address().
+//  Elements of a single allocation are contiguous in memory, so a synthetic range [first, last)
+//  within one allocation can be resolved once to the native range [to_address(first),
+//  to_address(first) + (last - first)), and then traversed at native speed by any algorithm.
+//  (Under C++20 std::to_address() also works, by way of operator->.)
+//
+template<class T, class AM> inline T*
+to_address(syn_ptr<T, AM> const& p) noexcept
+{
+    return static_cast<T*>(p.addrmodel().address());
+}
+
+template<class T> inline T*
+to_address(T* p) noexcept
+{
+    return p;
+}
+
+//- Resolves the address through a pinned snapshot of the segment table (see segment_pin.h),
+//  for addressing models that provide an address(pin) overload.
+//
+template<class T, class AM, class PIN> inline T*
+to_address(syn_ptr<T, AM> const& p, PIN const& pin) noexcept
+{
+    return static_cast<T*>(p.addrmodel().address(pin));
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      raw_span<T>
+//
+//  Summary:
+//      This class template is a minimal stand-in for C++20 std::span: a native pointer and an
+//      element count, describing a range that has been resolved from synthetic pointers.
+//--------------------------------------------------------------------------------------------------
+//
+template<class T>
+class raw_span
+{
+  public:
+    using element_type = T;
+    using size_type    = std::size_t;
+    using iterator     = T*;
+
+  public:
+    raw_span() noexcept = default;
+    raw_span(T* data, size_type size) noexcept;
+
+    T*          data() const noexcept;
+    size_type   size() const noexcept;
+    bool        empty() const noexcept;
+
+    iterator    begin() const noexcept;
+    iterator    end() const noexcept;
+    T&          operator [](size_type n) const noexcept;
+
+  private:
+    T*          mp_data = nullptr;
+    size_type   m_size  = 0;
+};
+
+//------
+//
+template<class T> inline
+raw_span<T>::raw_span(T* data, size_type size) noexcept
+:   mp_data{data}
+,   m_size{size}
+{}
+
+template<class T> inline
+T*
+raw_span<T>::data() const noexcept
+{
+    return mp_data;
+}
+
+template<class T> inline
+typename raw_span<T>::size_type
+raw_span<T>::size() const noexcept
+{
+    return m_size;
+}
+
+template<class T> inline
+bool
+raw_span<T>::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+template<class T> inline
+typename raw_span<T>::iterator
+raw_span<T>::begin() const noexcept
+{
+    return mp_data;
+}
+
+template<class T> inline
+typename raw_span<T>::iterator
+raw_span<T>::end() const noexcept
+{
+    return mp_data + m_size;
+}
+
+template<class T> inline
+T&
+raw_span<T>::operator [](size_type n) const noexcept
+{
+    return mp_data[n];
+}
+
+//------
+//- Resolves the range [first, last) to native pointers, with one call to the addressing model
+//  instead of one per element.  A range within a single allocation never crosses a segment
+//  boundary, because the allocation strategies carve each allocation out of a single segment,
+//  and each segment is mapped contiguously; so for every addressing model the whole range is
+//  one span.  The overload for native pointers lets generic code (e.g., containers using either
+//  std::allocator or rhx_allocator) resolve its ranges the same way.
+//
+template<class T, class AM> inline raw_span<T>
+to_span(syn_ptr<T, AM> first, syn_ptr<T, AM> last) noexcept
+{
+    return raw_span<T>(to_address(first), (std::size_t)(last - first));
+}
+
+template<class T> inline raw_span<T>
+to_span(T* first, T* last) noexcept
+{
+    return raw_span<T>(first, (std::size_t)(last - first));
+}
+
 //--------------------------------------------------------------------------------------------------
 //  Facility:   syn_ptr<T,AM> comparison operators
 //--------------------------------------------------------------------------------------------------
@@ -0,0 +1,296 @@
+//==================================================================================================
+//  File:
+//      tagged_addressing.h
+//
+//  Summary:
+//      Defines a two-dimensional based addressing model that reserves bits of its 64-bit
+//      representation for user-defined tags.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef TAGGED_ADDRESSING_H_DEFINED
+#define TAGGED_ADDRESSING_H_DEFINED
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      tagged_addressing_model<SM, LowBits, HighBits>
+//
+//  Summary:
+//      This class template implements a based (segment:offset) addressing model in a single
+//      64-bit word, like based_2d_msk_addressing_model, and in addition carries two tags that
+//      are not part of the address:
+//
+//        bits 63..64-HighBits      high tag (HighBits wide)
+//        bits 63-HighBits..48      segment index
+//        bits 47..LowBits          offset
+//        bits LowBits-1..0         low tag (LowBits wide)
+//
+//      The low tag occupies offset bits that are always zero in a pointer to an object aligned
+//      to 2^LowBits, so it costs nothing provided that every pointer of this type refers to such
+//      an object, and that pointer arithmetic moves in multiples of that alignment (as it does
+//      for any T with alignof(T) >= 2^LowBits).  The model is therefore meant for linked nodes,
+//      and not for byte-granular buffers such as strings.  The high tag is taken from the
+//      segment field, so only segment indices below 2^(16-HighBits) can be represented; a
+//      pointer into a higher segment is rejected by assign_from() with std::out_of_range.
+//
+//      The tags are masked out by address(), and so take no part in dereferencing or in
+//      comparisons.  They are copied along with the pointer, and cleared by assignment from a
+//      native pointer or nullptr.  Typical uses are the color bit of a red-black tree node,
+//      a mark bit for a collector, or a generation counter to defeat ABA in lock-free lists.
+//--------------------------------------------------------------------------------------------------
+//
+template<typename SM, unsigned LowBits = 3, unsigned HighBits = 4>
+class alignas(sizeof(std::uint64_t)) tagged_addressing_model
+{
+    static_assert(LowBits <= 4,  "at most 4 low tag bits are supported");
+    static_assert(HighBits <= 8, "at most 8 high tag bits are supported");
+
+  public:
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    enum : std::uint64_t
+    {
+        low_tag_bits    = LowBits,
+        high_tag_bits   = HighBits,
+        segment_shift   = 48,
+        high_tag_shift  = 64 - HighBits,
+        low_tag_mask    = (std::uint64_t(1) << LowBits) - 1,
+        segment_mask    = (std::uint64_t(1) << (16 - HighBits)) - 1,
+        offset_mask     = 0x0000'FFFF'FFFF'FFFF & ~low_tag_mask,
+        max_segment     = segment_mask
+    };
+
+  public:
+    ~tagged_addressing_model() = default;
+
+    tagged_addressing_model() noexcept = default;
+    tagged_addressing_model(tagged_addressing_model&&) noexcept = default;
+    tagged_addressing_model(tagged_addressing_model const&) noexcept = default;
+    tagged_addressing_model(std::nullptr_t) noexcept;
+    tagged_addressing_model(size_type segment, size_type offset) noexcept;
+
+    tagged_addressing_model&   operator =(tagged_addressing_model&&) noexcept = default;
+    tagged_addressing_model&   operator =(tagged_addressing_model const&) noexcept = default;
+    tagged_addressing_model&   operator =(std::nullptr_t) noexcept;
+
+    void*       address() const noexcept;
+    size_type   offset() const noexcept;
+    size_type   segment() const noexcept;
+
+    size_type   low_tag() const noexcept;
+    size_type   high_tag() const noexcept;
+    void        set_low_tag(size_type tag) noexcept;
+    void        set_high_tag(size_type tag) noexcept;
+
+    bool        equals(std::nullptr_t) const noexcept;
+    bool        equals(void const* p) const noexcept;
+    bool        equals(tagged_addressing_model const& other) const noexcept;
+
+    bool        greater_than(std::nullptr_t) const noexcept;
+    bool        greater_than(void const* p) const noexcept;
+    bool        greater_than(tagged_addressing_model const& other) const noexcept;
+
+    bool        less_than(std::nullptr_t) const noexcept;
+    bool        less_than(void const* p) const noexcept;
+    bool        less_than(tagged_addressing_model const& other) const noexcept;
+
+    void        assign_from(void const* p);
+
+    void        decrement(difference_type dec) noexcept;
+    void        increment(difference_type inc) noexcept;
+
+  private:
+    std::uint64_t   m_addr;
+};
+
+//--------------------------------------------------------------------------------------------------
+//  Facility:   tagged_addressing_model<SM, LowBits, HighBits> implementation
+//--------------------------------------------------------------------------------------------------
+//
+template<typename SM, unsigned LB, unsigned HB> inline
+tagged_addressing_model<SM, LB, HB>::tagged_addressing_model(std::nullptr_t) noexcept
+:   m_addr{0u}
+{}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+tagged_addressing_model<SM, LB, HB>::tagged_addressing_model(size_type seg, size_type off) noexcept
+:   m_addr{((std::uint64_t) seg << segment_shift) | off}
+{}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+tagged_addressing_model<SM, LB, HB>&
+tagged_addressing_model<SM, LB, HB>::operator =(std::nullptr_t) noexcept
+{
+    m_addr = 0u;
+    return *this;
+}
+
+//------
+//
+template<typename SM, unsigned LB, unsigned HB> inline
+void*
+tagged_addressing_model<SM, LB, HB>::address() const noexcept
+{
+    return SM::segment_address(segment()) + (m_addr & offset_mask);
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+typename tagged_addressing_model<SM, LB, HB>::size_type
+tagged_addressing_model<SM, LB, HB>::offset() const noexcept
+{
+    return m_addr & offset_mask;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+typename tagged_addressing_model<SM, LB, HB>::size_type
+tagged_addressing_model<SM, LB, HB>::segment() const noexcept
+{
+    return (m_addr >> segment_shift) & segment_mask;
+}
+
+//------
+//
+template<typename SM, unsigned LB, unsigned HB> inline
+typename tagged_addressing_model<SM, LB, HB>::size_type
+tagged_addressing_model<SM, LB, HB>::low_tag() const noexcept
+{
+    return m_addr & low_tag_mask;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+typename tagged_addressing_model<SM, LB, HB>::size_type
+tagged_addressing_model<SM, LB, HB>::high_tag() const noexcept
+{
+    return (HB == 0) ? 0 : (m_addr >> (high_tag_shift % 64));
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+void
+tagged_addressing_model<SM, LB, HB>::set_low_tag(size_type tag) noexcept
+{
+    m_addr = (m_addr & ~low_tag_mask) | (tag & low_tag_mask);
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+void
+tagged_addressing_model<SM, LB, HB>::set_high_tag(size_type tag) noexcept
+{
+    if (HB != 0)
+    {
+        std::uint64_t const     keep = (std::uint64_t(1) << (high_tag_shift % 64)) - 1;
+
+        m_addr = (m_addr & keep) | ((std::uint64_t) tag << (high_tag_shift % 64));
+    }
+}
+
+//------
+//
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::equals(std::nullptr_t) const noexcept
+{
+    return address() == nullptr;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::equals(void const* p) const noexcept
+{
+    return address() == p;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::equals(tagged_addressing_model const& other) const noexcept
+{
+    return address() == other.address();
+}
+
+//------
+//
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::greater_than(std::nullptr_t) const noexcept
+{
+    return address() != nullptr;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::greater_than(void const* p) const noexcept
+{
+    return address() > p;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::greater_than(tagged_addressing_model const& other) const noexcept
+{
+    return address() > other.address();
+}
+
+//------
+//
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::less_than(std::nullptr_t) const noexcept
+{
+    return false;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::less_than(void const* p) const noexcept
+{
+    return address() < p;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+bool
+tagged_addressing_model<SM, LB, HB>::less_than(tagged_addressing_model const& other) const noexcept
+{
+    return address() < other.address();
+}
+
+//------
+//- A pointer outside the segments is stored in segment 0 (whose base address is null) as its
+//  own address, which fits in the 48-bit offset field.
+//
+template<typename SM, unsigned LB, unsigned HB> inline
+void
+tagged_addressing_model<SM, LB, HB>::assign_from(void const* p)
+{
+    char const*     pdata   = static_cast<char const*>(p);
+    size_type       segment = SM::segment_index(p);
+
+    if (segment > max_segment)
+    {
+        throw std::out_of_range("tagged_addressing_model: segment index is too large");
+    }
+    m_addr = ((std::uint64_t) segment << segment_shift) |
+             (std::uint64_t) (pdata - static_cast<char const*>(SM::segment_address(segment)));
+}
+
+//------
+//
+template<typename SM, unsigned LB, unsigned HB> inline
+void
+tagged_addressing_model<SM, LB, HB>::decrement(difference_type dec) noexcept
+{
+    m_addr -= dec;
+}
+
+template<typename SM, unsigned LB, unsigned HB> inline
+void
+tagged_addressing_model<SM, LB, HB>::increment(difference_type inc) noexcept
+{
+    m_addr += inc;
+}
+
+#endif  //- TAGGED_ADDRESSING_H_DEFINED
@@ -0,0 +1,79 @@
+//==================================================================================================
+//  File:
+//      tagged_storage.h
+//
+//  Summary:
+//      Defines a storage model that uses the tagged addressing model.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef TAGGED_STORAGE_H_DEFINED
+#define TAGGED_STORAGE_H_DEFINED
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "storage_base.h"
+#include "tagged_addressing.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      tagged_storage_model
+//
+//  Summary:
+//      This class implements a based 2D storage model using the facilities provided by the
+//      "storage_model_base" base class, with three low tag bits (so pointees must be 8-byte
+//      aligned) and four high tag bits.  The high tag bits leave room for 12-bit segment
+//      indices, so set_segment_count() is limited accordingly.
+//
+//      The segment table is shared with the other models, so its count may still be raised
+//      through storage_model_base::set_segment_count().  The limit is therefore enforced again
+//      by last_segment_index(), which the allocation strategies consult, and by
+//      allocate_segment(), which throws std::out_of_range for an index that cannot be encoded.
+//--------------------------------------------------------------------------------------------------
+//
+class tagged_storage_model : public storage_model_base
+{
+  public:
+    using addressing_model = tagged_addressing_model<tagged_storage_model, 3, 4>;
+
+    static  addressing_model    segment_pointer(size_type segment, size_type offset=0);
+
+    static  void        allocate_segment(size_type segment, size_type size = max_size);
+    static  size_type   last_segment_index() noexcept;
+    static  bool        set_segment_count(size_type count);
+};
+
+//------
+//
+inline tagged_storage_model::addressing_model
+tagged_storage_model::segment_pointer(size_type segment, size_type offset)
+{
+    return addressing_model{segment, offset};
+}
+
+inline void
+tagged_storage_model::allocate_segment(size_type segment, size_type size)
+{
+    if (segment > addressing_model::max_segment)
+    {
+        throw std::out_of_range("tagged_storage_model: segment index does not fit in 12 bits");
+    }
+    storage_model_base::allocate_segment(segment, size);
+}
+
+inline tagged_storage_model::size_type
+tagged_storage_model::last_segment_index() noexcept
+{
+    return std::min<size_type>(storage_model_base::last_segment_index(), addressing_model::max_segment);
+}
+
+inline bool
+tagged_storage_model::set_segment_count(size_type count)
+{
+    return (count + first_segment_index() - 1) <= addressing_model::max_segment  &&
+           storage_model_base::set_segment_count(count);
+}
+
+#endif  //- TAGGED_STORAGE_H_DEFINED
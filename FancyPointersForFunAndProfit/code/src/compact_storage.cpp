@@ -0,0 +1,13 @@
+//==================================================================================================
+//  File:
+//      compact_storage.cpp
+//
+//  Summary:
+//      Instantiates the compact addressing model for the compact storage model.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include "compact_storage.h"
+
+template class compact_addressing_model<compact_storage_model>;
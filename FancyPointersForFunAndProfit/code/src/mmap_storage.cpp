@@ -0,0 +1,329 @@
+//==================================================================================================
+//  File:
+//      mmap_storage.cpp
+//
+//  Summary:
+//      Implements the file-backed, persistent storage model declared in mmap_storage.h.  This
+//      model relies on the POSIX mmap() family of functions.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mmap_storage.h"
+
+using size_type = mmap_storage_model::size_type;
+
+char*       mmap_storage_model::sm_segment_ptrs[max_segments + 2];
+size_type   mmap_storage_model::sm_segment_size[max_segments + 2];
+bool        mmap_storage_model::sm_ready = false;
+
+//- Every descriptor starts out closed, whatever max_segments is; zero would be taken for stdin.
+//
+std::array<int, mmap_storage_model::max_segments + 2>
+mmap_storage_model::sm_segment_fds = []
+{
+    std::array<int, max_segments + 2>   fds{};
+
+    for (int& fd : fds)
+    {
+        fd = -1;
+    }
+    return fds;
+}();
+
+namespace {
+
+constexpr std::uint64_t     header_magic = 0x5347'4553'4257'454Bu;     //- "KEWBSEGS"
+
+int
+open_segment(char const* prefix, size_type segment, bool shared_memory, bool create)
+{
+    int     flags = create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR;
+
+    std::string     name  = mmap_storage_model::segment_name(prefix, segment, shared_memory);
+
+    if (shared_memory)
+    {
+        return shm_open(name.c_str(), flags, 0600);
+    }
+    else
+    {
+        return open(name.c_str(), flags, 0644);
+    }
+}
+
+char*
+map_segment(int fd, size_type size)
+{
+    int     flags = (fd < 0) ? (MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE) : MAP_SHARED;
+    void*   addr  = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+
+    return (addr == MAP_FAILED) ? nullptr : static_cast<char*>(addr);
+}
+
+#ifdef __linux__
+//- Moves a mapping to a new address without copying its pages; see storage_base.cpp.
+//
+char*
+relocate_segment(char* addr, size_type size)
+{
+    void*   target = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (target == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    void*   moved = mremap(addr, size, size, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+
+    if (moved == MAP_FAILED)
+    {
+        munmap(target, size);
+        return nullptr;
+    }
+    return static_cast<char*>(moved);
+}
+#endif
+
+}   //- anonymous namespace
+
+//------
+//
+bool
+mmap_storage_model::create_segments(char const* path_prefix, size_type size)
+{
+    return attach_segments(path_prefix, false, true, size);
+}
+
+bool
+mmap_storage_model::open_segments(char const* path_prefix)
+{
+    return attach_segments(path_prefix, false, false, 0);
+}
+
+void
+mmap_storage_model::close_segments()
+{
+    sm_ready = false;
+
+    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    {
+        if (sm_segment_ptrs[i] != nullptr)
+        {
+            munmap(sm_segment_ptrs[i], sm_segment_size[i]);
+        }
+        if (sm_segment_fds[i] >= 0)
+        {
+            close(sm_segment_fds[i]);
+        }
+        sm_segment_ptrs[i] = nullptr;
+        sm_segment_size[i] = 0;
+        sm_segment_fds[i]  = -1;
+    }
+}
+
+void
+mmap_storage_model::sync_segments()
+{
+    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    {
+        if (sm_segment_ptrs[i] != nullptr  &&  sm_segment_fds[i] >= 0)
+        {
+            msync(sm_segment_ptrs[i], sm_segment_size[i], MS_SYNC);
+        }
+    }
+}
+
+//------
+//
+bool
+mmap_storage_model::attach_segments(char const* prefix, bool shared_memory, bool create,
+                                    size_type size)
+{
+    if (sm_ready  ||  (create  &&  (size <= header_size  ||  size > max_size)))
+    {
+        return false;
+    }
+
+    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    {
+        int             fd = open_segment(prefix, i, shared_memory, create);
+        struct stat     info;
+
+        //- Extending a new file with ftruncate() leaves it sparse, so the segment reads as zeros
+        //  without the cost of writing them.
+        //
+        if (fd >= 0  &&  create  &&  ftruncate(fd, (off_t) size) != 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+        if (fd < 0  ||  fstat(fd, &info) != 0  ||  (size_type) info.st_size <= header_size  ||
+            (size_type) info.st_size > max_size)
+        {
+            if (fd >= 0) close(fd);
+            close_segments();
+            return false;
+        }
+
+        sm_segment_fds[i]  = fd;
+        sm_segment_size[i] = (size_type) info.st_size;
+
+        if ((sm_segment_ptrs[i] = map_segment(fd, sm_segment_size[i])) == nullptr)
+        {
+            close_segments();
+            return false;
+        }
+    }
+
+    if (create)
+    {
+        reset_segments();
+    }
+    else if (header()->m_magic != header_magic  ||  header()->m_segment_count != max_segments)
+    {
+        close_segments();
+        return false;
+    }
+
+    sm_ready = true;
+    return true;
+}
+
+//- Segment files are named <prefix>.<segment index>.  POSIX shared memory object names must
+//  begin with a single slash and contain no others.
+//
+std::string
+mmap_storage_model::segment_name(char const* prefix, size_type segment, bool shared_memory)
+{
+    std::string     name(prefix);
+
+    if (shared_memory)
+    {
+        std::replace(name.begin(), name.end(), '/', '_');
+        name.insert(0, 1, '/');
+    }
+    return name + "." + std::to_string(segment);
+}
+
+//------
+//
+void
+mmap_storage_model::clear_segments()
+{
+    close_segments();
+}
+
+void
+mmap_storage_model::allocate_segment(size_type segment, size_type size)
+{
+    if (segment >= first_segment_index()  &&  segment <= last_segment_index()  &&
+        size <= max_size  &&  sm_segment_ptrs[segment] == nullptr)
+    {
+        sm_segment_fds[segment]  = -1;
+        sm_segment_ptrs[segment] = map_segment(-1, size);
+        sm_segment_size[segment] = (sm_segment_ptrs[segment] != nullptr) ? size : 0;
+    }
+}
+
+void
+mmap_storage_model::init_segments()
+{
+    if (!sm_ready)
+    {
+        //- As with storage_model_base, the allocation strategies map the other segments on
+        //  demand.
+        //
+        allocate_segment(first_segment_index());
+        reset_segments();
+        sm_ready = true;
+    }
+}
+
+void
+mmap_storage_model::reset_segments()
+{
+    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    {
+        if (sm_segment_ptrs[i] == nullptr)
+        {
+            continue;
+        }
+
+        //- Release the pages rather than writing zeros over them.  Truncating a file to zero
+        //  length and extending it again discards its contents; for anonymous private memory,
+        //  MADV_DONTNEED has the same effect.
+        //
+        if (sm_segment_fds[i] >= 0)
+        {
+            if (ftruncate(sm_segment_fds[i], 0) != 0  ||
+                ftruncate(sm_segment_fds[i], (off_t) sm_segment_size[i]) != 0)
+            {
+                memset(sm_segment_ptrs[i], 0, sm_segment_size[i]);
+            }
+        }
+        else
+        {
+            madvise(sm_segment_ptrs[i], sm_segment_size[i], MADV_DONTNEED);
+        }
+    }
+
+    if (segment_header* phdr = header();  phdr != nullptr)
+    {
+        phdr->m_magic         = header_magic;
+        phdr->m_segment_count = max_segments;
+        phdr->m_segment_size  = sm_segment_size[first_segment_index()];
+        phdr->m_next_segment  = first_segment_index();
+        phdr->m_next_offset   = header_size;
+    }
+}
+
+void
+mmap_storage_model::swap_segments()
+{
+    //- On Linux, relocate each segment by having mremap() move its pages to a new address.
+    //  Elsewhere, or should that fail, map it a second time (so that the new mapping is certain
+    //  to be at a different address) and then release the old mapping.  File-backed segments
+    //  share their pages between the two mappings; anonymous ones must be copied.
+    //
+    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    {
+        if (sm_segment_ptrs[i] != nullptr)
+        {
+#ifdef __linux__
+            if (char* pmoved = relocate_segment(sm_segment_ptrs[i], sm_segment_size[i]);  pmoved != nullptr)
+            {
+                sm_segment_ptrs[i] = pmoved;
+                continue;
+            }
+#endif
+
+            char*   pnew = map_segment(sm_segment_fds[i], sm_segment_size[i]);
+
+            if (pnew != nullptr)
+            {
+                if (sm_segment_fds[i] < 0)
+                {
+                    memcpy(pnew, sm_segment_ptrs[i], sm_segment_size[i]);
+                }
+                munmap(sm_segment_ptrs[i], sm_segment_size[i]);
+                sm_segment_ptrs[i] = pnew;
+            }
+        }
+    }
+}
+
+//------
+//
+template class based_2d_xl_addressing_model<mmap_based_2d_xl_storage_model>;
+template class based_2d_sm_addressing_model<mmap_based_2d_sm_storage_model>;
+template class based_2d_msk_addressing_model<mmap_based_2d_msk_storage_model>;
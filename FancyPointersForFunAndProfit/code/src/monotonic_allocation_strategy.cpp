@@ -15,6 +15,11 @@
 #include "wrapper_storage.h"
 #include "monotonic_allocation_strategy.h"
 
+#ifndef _WIN32
+    #include "mmap_storage.h"
+    #include "shm_storage.h"
+#endif
+
 #if 1
 template class monotonic_allocation_strategy<based_2d_msk_storage_model>;
 template class monotonic_allocation_strategy<based_2d_sm_storage_model>;
@@ -22,3 +27,14 @@ template class monotonic_allocation_strategy<based_2d_xl_storage_model>;
 template class monotonic_allocation_strategy<offset_storage_model>;
 template class monotonic_allocation_strategy<wrapper_storage_model>;
 #endif
+
+#ifndef _WIN32
+template class monotonic_allocation_strategy<mmap_based_2d_msk_storage_model>;
+template class monotonic_allocation_strategy<mmap_based_2d_sm_storage_model>;
+template class monotonic_allocation_strategy<mmap_based_2d_xl_storage_model>;
+template class monotonic_allocation_strategy<mmap_offset_storage_model>;
+template class monotonic_allocation_strategy<shm_based_2d_msk_storage_model>;
+template class monotonic_allocation_strategy<shm_based_2d_sm_storage_model>;
+template class monotonic_allocation_strategy<shm_based_2d_xl_storage_model>;
+template class monotonic_allocation_strategy<shm_offset_storage_model>;
+#endif
@@ -0,0 +1,40 @@
+//==================================================================================================
+//  File:
+//      shm_storage.cpp
+//
+//  Summary:
+//      Implements the shared memory storage model declared in shm_storage.h.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <sys/mman.h>
+
+#include "shm_storage.h"
+
+bool
+shm_storage_model::create_segments(char const* name_prefix, size_type size)
+{
+    return attach_segments(name_prefix, true, true, size);
+}
+
+bool
+shm_storage_model::open_segments(char const* name_prefix)
+{
+    return attach_segments(name_prefix, true, false, 0);
+}
+
+void
+shm_storage_model::unlink_segments(char const* name_prefix)
+{
+    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    {
+        shm_unlink(segment_name(name_prefix, i, true).c_str());
+    }
+}
+
+//------
+//
+template class based_2d_xl_addressing_model<shm_based_2d_xl_storage_model>;
+template class based_2d_sm_addressing_model<shm_based_2d_sm_storage_model>;
+template class based_2d_msk_addressing_model<shm_based_2d_msk_storage_model>;
@@ -9,30 +9,301 @@
 //  Copyright (c) 2018 Bob Steagall, KEWB Computing
 //==================================================================================================
 //
+#include <cerrno>
+#include <climits>
 #include <cstring>
 #include <utility>
+#include <vector>
 #include "storage_base.h"
 
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
 using size_type = storage_model_base::size_type;
 
 char*       storage_model_base::sm_segment_ptrs[max_segments + 2];
 size_type   storage_model_base::sm_segment_size[max_segments + 2];
 char*       storage_model_base::sm_shadow_ptrs[max_segments + 2];
+size_type   storage_model_base::sm_segment_count = default_segments;
+std::atomic<size_type>  storage_model_base::sm_top_segment{first_segment_index() - 1};
 bool        storage_model_base::sm_ready = false;
+uint16_t    storage_model_base::sm_slot_segments[slot_count];
+
+//------
+//- Helpers that reserve, release, and discard the contents of zero-filled virtual memory.
+//  Pages of a reserved region are committed by the OS only when first touched.
+//
+namespace {
+
+size_type const     alignment = storage_model_base::max_size;
+
+inline bool
+in_slot_range(char const* addr)
+{
+    return (reinterpret_cast<std::uintptr_t>(addr) >> storage_model_base::slot_shift) <
+            storage_model_base::slot_count;
+}
+
+inline char*
+align_up(char* addr)
+{
+    std::uintptr_t  bits = reinterpret_cast<std::uintptr_t>(addr);
+
+    return reinterpret_cast<char*>((bits + alignment - 1) & ~(std::uintptr_t)(alignment - 1));
+}
+
+//- Reserves size bytes at an address aligned to max_size.  On POSIX systems, an oversized
+//  region is mapped and the unaligned head and tail are trimmed off.  On Windows, a region
+//  cannot be partially released, so an oversized region is reserved only to find an aligned
+//  address, released, and then reserved again at that address; another thread may take the
+//  address in between, so this is retried a few times.
+//
+char*
+reserve_aligned(size_type size, bool accessible)
+{
+    char*   paligned = nullptr;
+
+#ifdef _WIN32
+    DWORD   type    = accessible ? (MEM_RESERVE | MEM_COMMIT) : MEM_RESERVE;
+    DWORD   protect = accessible ? PAGE_READWRITE : PAGE_NOACCESS;
+
+    for (int attempt = 0;  attempt < 8  &&  paligned == nullptr;  ++attempt)
+    {
+        char*   pspan = static_cast<char*>(VirtualAlloc(nullptr, size + alignment, MEM_RESERVE, PAGE_NOACCESS));
+
+        if (pspan == nullptr)
+        {
+            return nullptr;
+        }
+        VirtualFree(pspan, 0, MEM_RELEASE);
+        paligned = static_cast<char*>(VirtualAlloc(align_up(pspan), size, type, protect));
+    }
+#else
+    size_type const     page = 4096;
+    size_type const     span = size + alignment;
+    int const           prot = accessible ? (PROT_READ | PROT_WRITE) : PROT_NONE;
+    void*               addr = mmap(nullptr, span, prot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (addr == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    char*   pspan = static_cast<char*>(addr);
+    char*   ptail = nullptr;
+
+    paligned = align_up(pspan);
+    ptail    = paligned + ((size + page - 1) & ~(page - 1));
+
+    if (paligned != pspan)
+    {
+        munmap(pspan, paligned - pspan);
+    }
+    if (ptail != pspan + span)
+    {
+        munmap(ptail, (pspan + span) - ptail);
+    }
+#endif
+
+    //- Addresses beyond the reach of the slot table could not be found by segment_index().
+    //
+    if (paligned != nullptr  &&  !in_slot_range(paligned + size - 1))
+    {
+#ifdef _WIN32
+        VirtualFree(paligned, 0, MEM_RELEASE);
+#else
+        munmap(paligned, size);
+#endif
+        paligned = nullptr;
+    }
+    return paligned;
+}
+
+inline char*
+reserve_zeroed(size_type size)
+{
+    return reserve_aligned(size, true);
+}
+
+void
+release(char* addr, size_type size)
+{
+#ifdef _WIN32
+    VirtualFree(addr, 0, MEM_RELEASE);
+#else
+    munmap(addr, size);
+#endif
+}
+
+void
+discard(char* addr, size_type size)
+{
+#ifdef _WIN32
+    VirtualFree(addr, size, MEM_DECOMMIT);
+    VirtualAlloc(addr, size, MEM_COMMIT, PAGE_READWRITE);
+#else
+    madvise(addr, size, MADV_DONTNEED);     //- Subsequent reads see zero pages
+#endif
+}
 
+#ifdef __linux__
+//- Moves a segment's pages to a new address, without copying them, by reserving a fresh aligned
+//  range and having mremap() move the page table entries into it.  The old range is unmapped.
+//
+char*
+relocate(char* addr, size_type size)
+{
+    char*   target = reserve_aligned(size, false);
+
+    if (target == nullptr)
+    {
+        return nullptr;
+    }
+
+    void*   moved = mremap(addr, size, size, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+
+    if (moved == MAP_FAILED)
+    {
+        munmap(target, size);
+        return nullptr;
+    }
+    return static_cast<char*>(moved);
+}
+#endif
+
+//- Copies a segment's contents to a buffer that is known to be zero-filled, skipping source
+//  pages that are entirely zero.  Those pages need not be copied, and leaving them untouched
+//  in the destination keeps them uncommitted.
+//
+void
+copy_to_zeroed(char* dst, char const* src, size_type size)
+{
+    size_type const     page_size = 4096;
+
+    for (size_type offset = 0;  offset < size;  offset += page_size)
+    {
+        size_type const         count = (size - offset < page_size) ? (size - offset) : page_size;
+        std::uint64_t const*    pword = reinterpret_cast<std::uint64_t const*>(src + offset);
+        std::uint64_t const*    pend  = pword + count / sizeof(std::uint64_t);
+        std::uint64_t           bits  = 0;
+
+        while (pword != pend)
+        {
+            bits |= *pword++;
+        }
+        if (bits != 0  ||  (count % sizeof(std::uint64_t)) != 0)
+        {
+            memcpy(dst + offset, src + offset, count);
+        }
+    }
+}
+
+#ifndef _WIN32
+//------
+//- The layout of a snapshot file: a header, the number of bytes saved from each segment, the
+//  root table, and then the saved bytes of each segment in turn.
+//
+std::uint64_t const     snapshot_magic = 0x31544F4853504E53ull;     //- "SNPSHOT1"
+
+struct snapshot_header
+{
+    std::uint64_t   m_magic;
+    std::uint64_t   m_max_size;
+    std::uint64_t   m_segment_count;
+    std::uint64_t   m_top_segment;
+    std::uint64_t   m_top_offset;
+    std::uint64_t   m_root_count;
+};
+
+struct snapshot_root
+{
+    std::uint64_t   m_segment;          //- Zero for a null root
+    std::uint64_t   m_offset;
+};
+
+//- Writes all the buffers described by iov[0..count), in as few calls as possible.  writev() may
+//  write less than asked for, or be limited to IOV_MAX buffers, so this picks up where it left off.
+//
+bool
+write_all(int fd, iovec* iov, size_type count)
+{
+    while (count > 0)
+    {
+        ssize_t     n = writev(fd, iov, (count < IOV_MAX) ? (int) count : IOV_MAX);
+
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        while (count > 0  &&  (size_type) n >= iov->iov_len)
+        {
+            n -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0)
+        {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + n;
+            iov->iov_len -= n;
+        }
+    }
+    return true;
+}
+
+bool
+read_all(int fd, void* buf, size_type size)
+{
+    char*   pbuf = static_cast<char*>(buf);
+
+    while (size > 0)
+    {
+        ssize_t     n = read(fd, pbuf, size);
+
+        if (n <= 0)
+        {
+            if (n < 0  &&  errno == EINTR) continue;
+            return false;
+        }
+        pbuf += n;
+        size -= n;
+    }
+    return true;
+}
+#endif
+
+}   //- anonymous namespace
+
+//------
+//
 void
 storage_model_base::allocate_segment(size_type segment, size_type size)
 {
     if (segment >= first_segment_index()  &&  segment <= last_segment_index()  &&  
         size <= max_size  &&  sm_segment_ptrs[segment] == nullptr)
     {
-        sm_shadow_ptrs[segment] = new char[size];
-        memset(sm_shadow_ptrs[segment], 0, size);
+        char*   psegment = reserve_zeroed(size);
 
-        sm_segment_ptrs[segment] = new char[size];
-        memset(sm_segment_ptrs[segment], 0, size);
+        if (psegment == nullptr)
+        {
+            return;
+        }
 
+        sm_shadow_ptrs[segment]  = nullptr;       //- Created by swap_segments(), if ever needed
+        sm_segment_ptrs[segment] = psegment;
         sm_segment_size[segment] = size;
+        bind_slot(segment);
+
+        if (segment > sm_top_segment.load(std::memory_order_relaxed))
+        {
+            sm_top_segment.store(segment, std::memory_order_release);
+        }
     }
 }
 
@@ -41,10 +312,11 @@ storage_model_base::clear_segments()
 {
     sm_ready = false;
 
-    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    for (size_type i = first_segment_index();  i <= sm_top_segment;  ++i)
     {
         deallocate_segment(i);
     }
+    sm_top_segment = first_segment_index() - 1;
 }
 
 void
@@ -52,8 +324,12 @@ storage_model_base::deallocate_segment(size_type segment)
 {
     if (sm_segment_ptrs[segment] != nullptr)
     {
-        delete [] sm_segment_ptrs[segment];
-        delete [] sm_shadow_ptrs[segment];
+        unbind_slot(segment);
+        release(sm_segment_ptrs[segment], sm_segment_size[segment]);
+        if (sm_shadow_ptrs[segment] != nullptr)
+        {
+            release(sm_shadow_ptrs[segment], sm_segment_size[segment]);
+        }
         sm_segment_ptrs[segment] = nullptr;
         sm_segment_size[segment] = 0;
         sm_shadow_ptrs[segment]  = nullptr;
@@ -65,11 +341,7 @@ storage_model_base::init_segments()
 {
     if (!sm_ready)
     {
-        for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
-        {
-            allocate_segment(i);
-        }
-
+        allocate_segment(first_segment_index());
         sm_ready = true;
     }
 }
@@ -77,12 +349,11 @@ storage_model_base::init_segments()
 void
 storage_model_base::reset_segments()
 {
-    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    for (size_type i = first_segment_index();  i <= sm_top_segment;  ++i)
     {
         if (sm_segment_ptrs[i] != nullptr)
         {
-            memset(sm_segment_ptrs[i], 0, sm_segment_size[i]);
-            memset(sm_shadow_ptrs[i], 0, sm_segment_size[i]);
+            discard(sm_segment_ptrs[i], sm_segment_size[i]);
         }
     }
 }
@@ -90,9 +361,205 @@ storage_model_base::reset_segments()
 void
 storage_model_base::swap_segments()
 {
-    for (size_type i = first_segment_index();  i <= last_segment_index();  ++i)
+    for (size_type i = first_segment_index();  i <= sm_top_segment;  ++i)
     {
-        memcpy(sm_shadow_ptrs[i], sm_segment_ptrs[i], sm_segment_size[i]);
+        if (sm_segment_ptrs[i] == nullptr)
+        {
+            continue;
+        }
+#ifdef __linux__
+        if (char* pnew = relocate(sm_segment_ptrs[i], sm_segment_size[i]);  pnew != nullptr)
+        {
+            unbind_slot(i);
+            sm_segment_ptrs[i] = pnew;
+            bind_slot(i);
+            continue;
+        }
+#endif
+        if (sm_shadow_ptrs[i] == nullptr  &&
+            (sm_shadow_ptrs[i] = reserve_zeroed(sm_segment_size[i])) == nullptr)
+        {
+            continue;
+        }
+
+        //- After the copy, the old buffer becomes the shadow; its pages are given back so that
+        //  a relocated segment is not resident twice, and so that the shadow is zero-filled the
+        //  next time it is copied to.
+        //
+        copy_to_zeroed(sm_shadow_ptrs[i], sm_segment_ptrs[i], sm_segment_size[i]);
+        unbind_slot(i);
         std::swap(sm_shadow_ptrs[i], sm_segment_ptrs[i]);
+        bind_slot(i);
+        discard(sm_shadow_ptrs[i], sm_segment_size[i]);
+    }
+}
+
+//------
+//- Sets the number of segments that may be allocated.  This can only be done while no segments
+//  are allocated (i.e., before first use, or after clear_segments()).
+//
+bool
+storage_model_base::set_segment_count(size_type count)
+{
+    if (count == 0  ||  count > max_segments  ||  sm_top_segment >= first_segment_index())
+    {
+        return false;
+    }
+    sm_segment_count = count;
+    return true;
+}
+
+//------
+//- Writes segments first_segment_index() through top_segment to the file at path, with only
+//  the first top_offset bytes of the top segment, along with the given root pointers.  Every
+//  root must point into a segment, or be null.  Returns whether the file was written.
+//
+bool
+storage_model_base::snapshot(char const* path, size_type top_segment, size_type top_offset,
+                             void* const* roots, size_type root_count)
+{
+#ifdef _WIN32
+    return false;
+#else
+    size_type const     first = first_segment_index();
+
+    if (top_segment < first  ||  top_segment > sm_top_segment  ||  top_offset > sm_segment_size[top_segment])
+    {
+        return false;
+    }
+
+    snapshot_header     header = { snapshot_magic, max_size, top_segment - first + 1,
+                                   top_segment, top_offset, root_count };
+    std::vector<std::uint64_t>  sizes(header.m_segment_count);
+    std::vector<snapshot_root>  rtable(root_count);
+    std::vector<iovec>          iov;
+
+    for (size_type i = 0;  i < root_count;  ++i)
+    {
+        size_type   segment = segment_index(roots[i]);
+
+        if (segment == 0  &&  roots[i] != nullptr)
+        {
+            return false;
+        }
+        rtable[i].m_segment = segment;
+        rtable[i].m_offset  = (segment != 0) ? static_cast<char*>(roots[i]) - sm_segment_ptrs[segment] : 0;
+    }
+
+    iov.push_back({ &header, sizeof(header) });
+    iov.push_back({ sizes.data(), sizes.size() * sizeof(std::uint64_t) });
+    iov.push_back({ rtable.data(), rtable.size() * sizeof(snapshot_root) });
+
+    for (size_type i = first;  i <= top_segment;  ++i)
+    {
+        sizes[i - first] = (sm_segment_ptrs[i] == nullptr) ? 0 :
+                           (i == top_segment) ? top_offset : sm_segment_size[i];
+        iov.push_back({ sm_segment_ptrs[i], sizes[i - first] });
+    }
+
+    int     fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    bool    okay = write_all(fd, iov.data(), iov.size());
+
+    return (close(fd) == 0)  &&  okay;
+#endif
+}
+
+//- Replaces the current segments with those saved in the file at path, which are read into
+//  newly allocated segments.  On success, the extent of the saved storage is returned in
+//  top_segment and top_offset, and the saved roots, resolved at the segments' new addresses,
+//  in roots[0..root_count).  root_count must match the count given to snapshot().  On failure
+//  the model is left without segments, as after clear_segments().
+//
+bool
+storage_model_base::restore(char const* path, size_type& top_segment, size_type& top_offset,
+                            void** roots, size_type root_count)
+{
+#ifdef _WIN32
+    return false;
+#else
+    size_type const     first = first_segment_index();
+    snapshot_header     header;
+    int                 fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+    clear_segments();
+
+    bool    okay = read_all(fd, &header, sizeof(header))  &&
+                   header.m_magic == snapshot_magic       &&
+                   header.m_max_size == max_size          &&
+                   header.m_root_count == root_count      &&
+                   header.m_segment_count >= 1            &&
+                   header.m_top_segment == first + header.m_segment_count - 1  &&
+                   header.m_top_segment <= last_segment_index();
+
+    std::vector<std::uint64_t>  sizes(okay ? header.m_segment_count : 0);
+    std::vector<snapshot_root>  rtable(okay ? root_count : 0);
+
+    okay = okay  &&  read_all(fd, sizes.data(), sizes.size() * sizeof(std::uint64_t))
+                 &&  read_all(fd, rtable.data(), rtable.size() * sizeof(snapshot_root));
+
+    for (size_type i = first;  okay  &&  i <= header.m_top_segment;  ++i)
+    {
+        allocate_segment(i);
+        okay = sm_segment_ptrs[i] != nullptr  &&  sizes[i - first] <= sm_segment_size[i]  &&
+               read_all(fd, sm_segment_ptrs[i], sizes[i - first]);
+    }
+    for (size_type i = 0;  okay  &&  i < root_count;  ++i)
+    {
+        size_type const     segment = rtable[i].m_segment;
+
+        okay = segment == 0  ||  (segment >= first  &&  segment <= header.m_top_segment  &&
+                                  rtable[i].m_offset < sm_segment_size[segment]);
+        if (okay)
+        {
+            roots[i] = (segment != 0) ? sm_segment_ptrs[segment] + rtable[i].m_offset : nullptr;
+        }
+    }
+    close(fd);
+
+    if (!okay)
+    {
+        clear_segments();
+        return false;
+    }
+    top_segment = header.m_top_segment;
+    top_offset  = header.m_top_offset;
+    sm_ready    = true;
+    return true;
+#endif
+}
+
+//------
+//- Records (or erases) the slot table entry for a segment's current address.  Segments never
+//  exceed max_size and are aligned to it, so each occupies exactly one slot.
+//
+void
+storage_model_base::bind_slot(size_type segment)
+{
+    std::uintptr_t const    slot = reinterpret_cast<std::uintptr_t>(sm_segment_ptrs[segment]) >> slot_shift;
+
+    if (slot < slot_count)
+    {
+        sm_slot_segments[slot] = static_cast<uint16_t>(segment);
+    }
+}
+
+void
+storage_model_base::unbind_slot(size_type segment)
+{
+    std::uintptr_t const    slot = reinterpret_cast<std::uintptr_t>(sm_segment_ptrs[segment]) >> slot_shift;
+
+    if (slot < slot_count  &&  sm_slot_segments[slot] == segment)
+    {
+        sm_slot_segments[slot] = 0;
     }
 }
@@ -0,0 +1,13 @@
+//==================================================================================================
+//  File:
+//      tagged_storage.cpp
+//
+//  Summary:
+//      Instantiates the tagged addressing model for the tagged storage model.
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include "tagged_storage.h"
+
+template class tagged_addressing_model<tagged_storage_model, 3, 4>;
@@ -0,0 +1,213 @@
+//==================================================================================================
+//  File:   bplus_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <random>
+
+#include "bplus_tree.h"
+#include "rb_tree.h"
+
+//--------------------------------------------------------------------------------------------------
+//  B+tree tests.  For each allocation strategy, a bplus_tree<uint64_t, uint64_t> is constructed
+//  in the segments and filled with random keys, and a std::map with the same keys and an
+//  rhx_allocator for the same strategy is filled alongside it.  Both are searched for every key
+//  and for as many absent keys, and both are walked in key order.  Some keys are then erased and
+//  reinserted, the segments are relocated (for the strategies whose pointers may be held
+//  outside the segments), and the B+tree is checked again, including a range scan.
+//--------------------------------------------------------------------------------------------------
+//
+static size_t const     bplus_key_count = 1000000;
+
+template<class AS, class MT>
+MT*
+construct_tree_in_segments(AS& heap, typename AS::template rebind_pointer<MT>& pmap)
+{
+    pmap = static_cast<typename AS::template rebind_pointer<MT>>(heap.allocate(sizeof(MT)));
+    return ::new (static_cast<MT*>(pmap)) MT();
+}
+
+//- Checks the tree's contents and order against the first count keys, of which sorted is a
+//  sorted copy, and returns the number of errors found.
+//
+template<class TT>
+size_t
+check_bplus_tree(TT const& tree, std::vector<uint64_t> const& keys, std::vector<uint64_t> const& sorted)
+{
+    size_t  count  = sorted.size();
+    size_t  errors = (tree.size() != count) ? 1 : 0;
+    size_t  index  = 0;
+
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        uint64_t const*     pval = tree.find(keys[i]);
+
+        errors += (pval == nullptr  ||  *pval != keys[i] * 3) ? 1 : 0;
+    }
+    for (size_t i = count;  i < keys.size();  ++i)
+    {
+        errors += tree.contains(keys[i]) ? 1 : 0;
+    }
+
+    tree.for_each([&](uint64_t key, uint64_t)
+    {
+        errors += (index >= count  ||  sorted[index] != key) ? 1 : 0;
+        ++index;
+    });
+    errors += (index != count) ? 1 : 0;
+
+    //- A range scan over the middle half of the keys.
+    //
+    index = count / 4;
+    tree.for_each_in(sorted[count / 4], sorted[3 * count / 4], [&](uint64_t key, uint64_t)
+    {
+        errors += (sorted[index] != key) ? 1 : 0;
+        ++index;
+    });
+    errors += (index != 3 * count / 4) ? 1 : 0;
+
+    return errors;
+}
+
+template<class AS>
+void
+do_bplus_test(char const* name, std::vector<uint64_t> const& keys, std::vector<uint64_t> const& sorted,
+              bool reloc)
+{
+    using bplus_map = bplus_tree<uint64_t, uint64_t, AS>;
+    using alloc     = rhx_allocator<std::pair<uint64_t const, uint64_t>, AS>;
+    using tree_map  = std::map<uint64_t, uint64_t, std::less<uint64_t>, alloc>;
+    using bplus_ptr = typename AS::template rebind_pointer<bplus_map>;
+    using tree_ptr  = typename AS::template rebind_pointer<tree_map>;
+
+    AS          heap;
+    bplus_ptr   pbplus;
+    tree_ptr    ptree;
+    size_t      count  = sorted.size();
+    size_t      errors = 0;
+    uint64_t    sum    = 0;
+    stopwatch   sw;
+
+    heap.reset_segments();
+
+    bplus_map&  bmap = *construct_tree_in_segments<AS, bplus_map>(heap, pbplus);
+
+    sw.start();
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        bmap.try_emplace(keys[i], keys[i] * 3);
+    }
+    sw.stop();
+    int64_t     bplus_insert = sw.elapsed_msec();
+    size_t      bplus_bytes  = segment_bytes_used<AS>();
+
+    tree_map&   tmap = *construct_tree_in_segments<AS, tree_map>(heap, ptree);
+
+    sw.start();
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        tmap.emplace(keys[i], keys[i] * 3);
+    }
+    sw.stop();
+    int64_t     tree_insert = sw.elapsed_msec();
+    size_t      tree_bytes  = segment_bytes_used<AS>() - bplus_bytes;
+
+    errors += check_bplus_tree(bmap, keys, sorted);
+
+    //- Time lookups of every key, half of which are present, and an ordered walk.
+    //
+    sw.start();
+    for (uint64_t key : keys)
+    {
+        uint64_t const*     pval = bmap.find(key);
+        sum += (pval != nullptr) ? *pval : 0;
+    }
+    sw.stop();
+    int64_t     bplus_lookup = sw.elapsed_msec();
+
+    sw.start();
+    for (uint64_t key : keys)
+    {
+        auto    it = tmap.find(key);
+        sum -= (it != tmap.end()) ? it->second : 0;
+    }
+    sw.stop();
+    int64_t     tree_lookup = sw.elapsed_msec();
+
+    sw.start();
+    bmap.for_each([&sum](uint64_t, uint64_t value) { sum += value; });
+    sw.stop();
+    int64_t     bplus_walk = sw.elapsed_msec();
+
+    sw.start();
+    for (auto const& kv : tmap)
+    {
+        sum -= kv.second;
+    }
+    sw.stop();
+    int64_t     tree_walk = sw.elapsed_msec();
+
+    CHECK(sum == 0);
+
+    //- Erase every fourth key and put it back, then relocate.
+    //
+    for (size_t i = 0;  i < count;  i += 4)
+    {
+        errors += bmap.erase(keys[i]) ? 0 : 1;
+        errors += bmap.erase(keys[i]) ? 1 : 0;
+    }
+    for (size_t i = 0;  i < count;  i += 4)
+    {
+        bmap[keys[i]] = keys[i] * 3;
+    }
+    if (reloc)
+    {
+        AS::swap_segments();
+    }
+    errors += check_bplus_tree(*pbplus, keys, sorted);
+    CHECK(errors == 0);
+
+    std::cout << "  " << std::left << std::setw(14) << name << std::right
+              << "B+tree: " << std::setw(6) << (bplus_bytes >> 10) << " KB, height "
+              << pbplus->height() << ", insert " << std::setw(4) << bplus_insert
+              << " msec, lookup " << std::setw(4) << bplus_lookup
+              << " msec, walk " << std::setw(3) << bplus_walk << " msec" << std::endl
+              << "  " << std::setw(14) << "" << "std::map " << std::setw(6) << (tree_bytes >> 10)
+              << " KB,          insert " << std::setw(4) << tree_insert
+              << " msec, lookup " << std::setw(4) << tree_lookup
+              << " msec, walk " << std::setw(3) << tree_walk << " msec" << std::endl;
+
+    heap.reset_segments();
+}
+
+void
+test_bplus_ops()
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "***** TEST B+TREE *****" << std::endl;
+
+    std::mt19937_64         gen(4242);
+    std::vector<uint64_t>   keys(bplus_key_count * 2);
+
+    for (auto& key : keys)
+    {
+        key = gen();
+    }
+
+    //- The second half of the keys are never inserted.
+    //
+    std::vector<uint64_t>   sorted(keys.begin(), keys.begin() + bplus_key_count);
+
+    std::sort(sorted.begin(), sorted.end());
+
+    std::cout << bplus_key_count << " keys inserted, " << keys.size() << " looked up" << std::endl;
+
+    do_bplus_test<wrapper_strategy>("wrapper", keys, sorted, false);
+    do_bplus_test<offset_strategy>("offset", keys, sorted, false);
+    do_bplus_test<based_2d_xl_strategy>("based_2d_xl", keys, sorted, true);
+    do_bplus_test<based_2d_sm_strategy>("based_2d_sm", keys, sorted, true);
+    do_bplus_test<based_2d_msk_strategy>("based_2d_msk", keys, sorted, true);
+    do_bplus_test<compact_strategy>("compact", keys, sorted, true);
+    std::cout << std::endl;
+}
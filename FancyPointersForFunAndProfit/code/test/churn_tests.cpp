@@ -0,0 +1,144 @@
+//==================================================================================================
+//  File:   churn_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <random>
+
+#include "container_tests.h"
+#include "segregated_fit_allocation_strategy.h"
+
+using segregated_xl_strategy = segregated_fit_allocation_strategy<based_2d_xl_storage_model>;
+
+//--------------------------------------------------------------------------------------------------
+//  Churn benchmark.  A map of strings to lists of strings is filled, and then repeatedly has a
+//  random key erased and a new key inserted, so that the number of live entries stays constant
+//  while the total allocated grows with every round.  Reported for each allocator are the
+//  elapsed time, and (for the segment-based strategies) the number of segment bytes consumed.
+//--------------------------------------------------------------------------------------------------
+//
+static int const    churn_key_count   = 10000;
+static int const    churn_value_count = 5;
+static int const    churn_rounds      = 100000;
+
+struct std_churn_containers
+{
+    using string_type = std::string;
+    using list_type   = std::list<std::string>;
+    using map_type    = std::map<std::string, list_type>;
+
+    static  size_t  bytes_used() { return 0; }
+    static  void    reset() {}
+};
+
+template<class AS>
+struct syn_churn_containers
+{
+    using string_type = simple_string<rhx_allocator<char, AS>>;
+    using list_type   = std::list<string_type, rhx_allocator<string_type, AS>>;
+    using map_type    = std::map<string_type, list_type, std::less<string_type>,
+                                 rhx_allocator<std::pair<string_type const, list_type>, AS>>;
+
+    static  size_t  bytes_used();
+    static  void    reset() { AS::reset_segments(); }
+};
+
+template<class AS>
+size_t
+syn_churn_containers<AS>::bytes_used()
+{
+    using storage_model = typename AS::storage_model;
+
+    size_t  segment, offset;
+
+    AS::get_position(segment, offset);
+    return (segment - storage_model::first_segment_index()) * storage_model::max_segment_size() + offset;
+}
+
+template<class CT>
+void
+insert_churn_key(typename CT::map_type& map, int key)
+{
+    using string_type = typename CT::string_type;
+
+    char    key_str[128], val_str[128];
+
+    sprintf(key_str, "this is churn key #%08d", key);
+    auto&   values = map[string_type(key_str)];
+
+    for (int j = 0;  j < churn_value_count;  ++j)
+    {
+        sprintf(val_str, "this is value string #%d for churn key #%d", j, key);
+        values.push_back(string_type(val_str));
+    }
+}
+
+template<class CT>
+void
+do_churn_test(char const* name)
+{
+    using string_type = typename CT::string_type;
+    using map_type    = typename CT::map_type;
+
+    std::mt19937    gen(12345);
+    std::vector<int>    live(churn_key_count);
+    char            key_str[128];
+    size_t          errors = 0;
+    size_t          bytes  = 0;
+    stopwatch       sw;
+
+    {
+        map_type    map;
+
+        for (int i = 0;  i < churn_key_count;  ++i)
+        {
+            live[i] = i;
+            insert_churn_key<CT>(map, i);
+        }
+
+        for (int r = 0;  r < churn_rounds;  ++r)
+        {
+            int&    slot = live[gen() % churn_key_count];
+
+            sprintf(key_str, "this is churn key #%08d", slot);
+            map.erase(string_type(key_str));
+            slot = churn_key_count + r;
+            insert_churn_key<CT>(map, slot);
+        }
+        sw.stop();
+
+        errors += (map.size() != (size_t) churn_key_count) ? 1 : 0;
+        for (int key : live)
+        {
+            sprintf(key_str, "this is churn key #%08d", key);
+            auto    iter = map.find(string_type(key_str));
+            errors += (iter == map.end()  ||  iter->second.size() != (size_t) churn_value_count) ? 1 : 0;
+        }
+        bytes = CT::bytes_used();
+    }
+    CT::reset();
+
+    CHECK(errors == 0);
+    std::cout << "  " << std::left << std::setw(34) << name << std::right << std::dec
+              << std::setw(10) << sw.elapsed_msec() << " msec";
+    if (bytes != 0)
+    {
+        std::cout << std::setw(10) << (bytes >> 10) << " KB of segments";
+    }
+    std::cout << std::endl;
+}
+
+void
+test_churn_ops()
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "*****  TEST CHURN  ****" << std::endl;
+    std::cout << "live keys: " << churn_key_count << ",  values per key: " << churn_value_count
+              << ",  erase/insert rounds: " << churn_rounds << std::endl;
+
+    do_churn_test<std_churn_containers>("std::allocator");
+    do_churn_test<syn_churn_containers<based_2d_xl_strategy>>("monotonic<based_2d_xl>");
+    do_churn_test<syn_churn_containers<segregated_xl_strategy>>("segregated_fit<based_2d_xl>");
+    std::cout << std::endl;
+}
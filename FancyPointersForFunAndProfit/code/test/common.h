@@ -32,6 +32,7 @@
 #include <numeric>
 #include <scoped_allocator>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <typeinfo>
 #include <unordered_map>
@@ -41,7 +42,9 @@
 #include "based_2d_msk_storage.h"
 #include "based_2d_sm_storage.h"
 #include "based_2d_xl_storage.h"
+#include "compact_storage.h"
 #include "offset_storage.h"
+#include "tagged_storage.h"
 #include "wrapper_storage.h"
 #include "monotonic_allocation_strategy.h"
 #include "rhx_allocator.h"
@@ -88,6 +91,8 @@ using based_2d_xl_strategy  = monotonic_allocation_strategy<based_2d_xl_storage_
 using based_2d_sm_strategy  = monotonic_allocation_strategy<based_2d_sm_storage_model>;
 using based_2d_msk_strategy = monotonic_allocation_strategy<based_2d_msk_storage_model>;
 using offset_strategy       = monotonic_allocation_strategy<offset_storage_model>;
+using tagged_strategy       = monotonic_allocation_strategy<tagged_storage_model>;
+using compact_strategy      = monotonic_allocation_strategy<compact_storage_model>;
 
 bool    verbose_output();
 size_t  max_ptr_op_count_index();
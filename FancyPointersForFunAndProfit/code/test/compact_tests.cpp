@@ -0,0 +1,323 @@
+//==================================================================================================
+//  File:   compact_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "rb_tree.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Compact pointer tests.  The first part checks that 4-byte pointers address any byte of the
+//  segments, survive arithmetic and relocation, reject addresses outside the segments, and can
+//  point one past an object that ends at the end of a segment's usable space.  The second part
+//  builds the same node-based structures with 8-byte (wrapper, based_2d_msk) and 4-byte
+//  (compact) pointers: a doubly-linked list whose links visit the nodes in random order, and an
+//  insert-only red-black tree.  Reported are the node sizes, the segment bytes used, and the
+//  times to build and to traverse each structure.
+//--------------------------------------------------------------------------------------------------
+//
+static size_t const     list_node_count = 2000000;
+static size_t const     tree_key_count  = 1000000;
+
+void
+check_compact_pointers()
+{
+    using char_ptr = compact_strategy::rebind_pointer<char>;
+    using int_ptr  = compact_strategy::rebind_pointer<uint64_t>;
+
+    compact_strategy    heap;
+
+    CHECK(sizeof(char_ptr) == 4  &&  sizeof(int_ptr) == 4);
+
+    //- Byte-granular pointers work, so strings may live in the segments too.
+    //
+    char_ptr    pstr = static_cast<char_ptr>(heap.allocate(16));
+
+    strcpy(static_cast<char*>(pstr), "compact");
+    CHECK(*(pstr + 3) == 'p');
+    CHECK(strcmp(static_cast<char*>(pstr + 1), "ompact") == 0);
+
+    //- Arithmetic, comparison, and assignment from native pointers.
+    //
+    int_ptr     parray = static_cast<int_ptr>(heap.allocate(16 * sizeof(uint64_t)));
+    uint64_t*   praw   = parray;
+
+    for (uint64_t i = 0;  i < 16;  ++i)
+    {
+        parray[i] = i * 100;
+    }
+
+    int_ptr     p1 = parray + 5;
+    int_ptr     p2 = praw + 9;
+
+    CHECK(*p1 == 500  &&  *p2 == 900);
+    CHECK(p1 < p2  &&  p2 - p1 == 4);
+    CHECK(p1 == praw + 5);
+    p2 -= 4;
+    CHECK(p1 == p2);
+
+    int_ptr     pnull = nullptr;
+
+    CHECK(pnull == nullptr  &&  !pnull);
+
+    //- A pointer to memory outside the segments cannot be represented.
+    //
+    uint64_t    local  = 42;
+    bool        thrown = false;
+
+    try
+    {
+        p2 = &local;
+    }
+    catch (std::out_of_range const&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    //- Targets survive relocation.
+    //
+    compact_strategy::swap_segments();
+    CHECK(*p1 == 500);
+    CHECK(strcmp(static_cast<char*>(pstr), "compact") == 0);
+
+    //- An array that ends where a segment's usable space ends has a representable end pointer,
+    //  and the next chunk comes from the next segment.
+    //
+    using storage_model = compact_strategy::storage_model;
+
+    size_t const    first  = storage_model::first_segment_index();
+    size_t const    usable = storage_model::segment_size(first);
+
+    compact_strategy::set_position(first, usable - 16);
+
+    char_ptr    pbegin = static_cast<char_ptr>(heap.allocate(16));
+    char*       pedge  = static_cast<char*>(pbegin) + 16;
+    char_ptr    pend;
+
+    thrown = false;
+    try
+    {
+        pend = pedge;
+    }
+    catch (std::out_of_range const&)
+    {
+        thrown = true;
+    }
+    CHECK(pedge == storage_model::segment_address(first) + usable);
+    CHECK(!thrown  &&  pend - pbegin == 16  &&  static_cast<char*>(pend) == pedge);
+
+    char_ptr    pnext = static_cast<char_ptr>(heap.allocate(16));
+
+    CHECK(storage_model::segment_index(static_cast<char*>(pnext)) == first + 1);
+
+    compact_strategy::reset_segments();
+}
+
+//------
+//- A doubly-linked list node; the value follows the links so that it can share their padding.
+//
+template<class AS>
+struct list_node
+{
+    using node_ptr = typename AS::template rebind_pointer<list_node>;
+
+    node_ptr    m_next;
+    node_ptr    m_prev;
+    uint64_t    m_value;
+};
+
+template<class AS>
+void
+do_list_test(char const* name, std::vector<size_t> const& order)
+{
+    using node_type = list_node<AS>;
+    using node_ptr  = typename node_type::node_ptr;
+
+    std::vector<node_ptr>   nodes;
+    AS          heap;
+    uint64_t    fwd_sum = 0;
+    uint64_t    rev_sum = 0;
+    stopwatch   sw;
+
+    heap.reset_segments();
+    nodes.reserve(order.size());
+
+    //- The nodes are allocated in sequence and then linked in the given order, so that walking
+    //  the list jumps around the segments as it would after a long history of insertions.
+    //
+    sw.start();
+    for (size_t i = 0;  i < order.size();  ++i)
+    {
+        node_ptr    n = static_cast<node_ptr>(heap.allocate(sizeof(node_type)));
+
+        ::new (static_cast<node_type*>(n)) node_type();
+        n->m_value = i;
+        nodes.push_back(n);
+    }
+
+    node_ptr    head = nodes[order.front()];
+    node_ptr    tail = head;
+
+    for (size_t i = 1;  i < order.size();  ++i)
+    {
+        node_ptr    n = nodes[order[i]];
+
+        tail->m_next = n;
+        n->m_prev    = tail;
+        tail         = n;
+    }
+    sw.stop();
+
+    int64_t     build_msec = sw.elapsed_msec();
+    size_t      bytes      = segment_bytes_used<AS>();
+
+    sw.start();
+    for (node_ptr n = head;  n;  n = n->m_next)
+    {
+        fwd_sum += n->m_value;
+    }
+    for (node_ptr n = tail;  n;  n = n->m_prev)
+    {
+        rev_sum += n->m_value;
+    }
+    sw.stop();
+
+    uint64_t const  expected = (uint64_t) order.size() * (order.size() - 1) / 2;
+
+    CHECK(fwd_sum == expected  &&  rev_sum == expected);
+
+    std::cout << "  " << std::left << std::setw(22) << name << std::right
+              << "node: " << std::setw(3) << sizeof(node_type) << " bytes,  segments: "
+              << std::setw(6) << (bytes >> 10) << " KB,  build: "
+              << std::setw(4) << build_msec << " msec,  traverse: "
+              << std::setw(4) << sw.elapsed_msec() << " msec" << std::endl;
+
+    heap.reset_segments();
+}
+
+//------
+//- Visits the nodes of a tree in key order, returning the number of nodes that are out of order.
+//
+template<class NT>
+size_t
+in_order_walk(typename NT::node_ptr root, size_t& count)
+{
+    using node_ptr = typename NT::node_ptr;
+
+    std::vector<node_ptr>   stack;
+    node_ptr    x      = root;
+    node_ptr    prev   = nullptr;
+    size_t      errors = 0;
+
+    while (x  ||  !stack.empty())
+    {
+        for (;  x;  x = x->m_left)
+        {
+            stack.push_back(x);
+        }
+        x = stack.back();
+        stack.pop_back();
+
+        errors += (prev  &&  x->m_key < prev->m_key) ? 1 : 0;
+        ++count;
+        prev = x;
+        x    = x->m_right;
+    }
+    return errors;
+}
+
+template<class AS>
+void
+do_tree_test(char const* name, std::vector<uint64_t> const& keys)
+{
+    using node_type = colored_rb_node<AS>;
+    using node_ptr  = typename node_type::node_ptr;
+
+    AS          heap;
+    size_t      errors = 0;
+    size_t      count  = 0;
+    stopwatch   sw;
+
+    heap.reset_segments();
+
+    {
+        rb_tree<node_type>  tree;
+
+        sw.start();
+        for (uint64_t key : keys)
+        {
+            node_ptr    n = static_cast<node_ptr>(heap.allocate(sizeof(node_type)));
+
+            ::new (static_cast<node_type*>(n)) node_type();
+            n->m_key = key;
+            tree.insert(n);
+        }
+        sw.stop();
+
+        int64_t     build_msec = sw.elapsed_msec();
+        size_t      bytes      = segment_bytes_used<AS>();
+
+        sw.start();
+        for (uint64_t key : keys)
+        {
+            errors += tree.contains(key) ? 0 : 1;
+        }
+        sw.stop();
+
+        int64_t     lookup_msec = sw.elapsed_msec();
+
+        sw.start();
+        errors += in_order_walk<node_type>(tree.root(), count);
+        sw.stop();
+
+        errors += tree.verify();
+        CHECK(errors == 0);
+        CHECK(count == keys.size());
+
+        std::cout << "  " << std::left << std::setw(22) << name << std::right
+                  << "node: " << std::setw(3) << sizeof(node_type) << " bytes,  segments: "
+                  << std::setw(6) << (bytes >> 10) << " KB,  build: "
+                  << std::setw(4) << build_msec << " msec,  lookup: "
+                  << std::setw(4) << lookup_msec << " msec,  walk: "
+                  << std::setw(4) << sw.elapsed_msec() << " msec" << std::endl;
+    }
+
+    heap.reset_segments();
+}
+
+void
+test_compact_ops()
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "*** TEST COMPACT PTR **" << std::endl;
+
+    check_compact_pointers();
+
+    std::mt19937_64         gen(4242);
+    std::vector<size_t>     order(list_node_count);
+    std::vector<uint64_t>   keys(tree_key_count);
+
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), gen);
+
+    for (auto& key : keys)
+    {
+        key = gen();
+    }
+
+    std::cout << "doubly-linked list with " << list_node_count << " nodes" << std::endl;
+    do_list_test<wrapper_strategy>("wrapper", order);
+    do_list_test<based_2d_msk_strategy>("based_2d_msk", order);
+    do_list_test<compact_strategy>("compact", order);
+
+    std::cout << "red-black tree with " << tree_key_count << " random keys" << std::endl;
+    do_tree_test<wrapper_strategy>("wrapper", keys);
+    do_tree_test<based_2d_msk_strategy>("based_2d_msk", keys);
+    do_tree_test<compact_strategy>("compact", keys);
+    std::cout << std::endl;
+}
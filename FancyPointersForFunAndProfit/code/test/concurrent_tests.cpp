@@ -0,0 +1,154 @@
+//==================================================================================================
+//  File:   concurrent_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <atomic>
+#include <thread>
+
+#include "container_tests.h"
+#include "concurrent_allocation_strategy.h"
+
+using concurrent_xl_strategy = concurrent_monotonic_allocation_strategy<based_2d_xl_storage_model>;
+using arena_xl_strategy      = thread_arena_allocation_strategy<based_2d_xl_storage_model>;
+
+//--------------------------------------------------------------------------------------------------
+//  Multithreaded container-build benchmark.  Each of N threads builds (and then checks) its own
+//  map of strings to lists of strings, so that the only thing the threads share is the memory
+//  resource behind their allocators.  The elapsed time for all N threads to finish is reported
+//  for the two thread-safe strategies, and for std::allocator as a baseline.  No pointer is
+//  passed between threads, so each thread only converts pointers into segments that it has
+//  reached through the strategy's position word, as concurrent_monotonic_allocation_strategy
+//  requires.
+//--------------------------------------------------------------------------------------------------
+//
+static int const    mt_key_count   = 1000;
+static int const    mt_value_count = 5;
+
+struct std_containers
+{
+    using string_type = std::string;
+    using list_type   = std::list<std::string>;
+    using map_type    = std::map<std::string, list_type>;
+
+    static  void    reset() {}
+};
+
+template<class AS>
+struct syn_containers
+{
+    using string_type = simple_string<rhx_allocator<char, AS>>;
+    using list_type   = std::list<string_type, rhx_allocator<string_type, AS>>;
+    using map_type    = std::map<string_type, list_type, std::less<string_type>,
+                                 rhx_allocator<std::pair<string_type const, list_type>, AS>>;
+
+    static  void    reset() { AS::reset_segments(); }
+};
+
+//- Builds a map in the calling thread, and returns the number of incorrect values found in it.
+//
+template<class CT>
+size_t
+build_thread_map(int thread_index)
+{
+    using string_type = typename CT::string_type;
+    using map_type    = typename CT::map_type;
+
+    char        key_str[128], val_str[128];
+    map_type    map;
+    size_t      errors = 0;
+
+    for (int i = 0;  i < mt_key_count;  ++i)
+    {
+        sprintf(key_str, "key #%d from thread #%d", i, thread_index);
+        string_type     key(key_str);
+
+        for (int j = 0;  j < mt_value_count;  ++j)
+        {
+            sprintf(val_str, "value string #%d for key #%d from thread #%d", j, i, thread_index);
+            map[key].push_back(string_type(val_str));
+        }
+    }
+
+    for (int i = 0;  i < mt_key_count;  ++i)
+    {
+        sprintf(key_str, "key #%d from thread #%d", i, thread_index);
+        auto const&     values = map[string_type(key_str)];
+        int             j = 0;
+
+        errors += (values.size() != (size_t) mt_value_count) ? 1 : 0;
+        for (auto const& val : values)
+        {
+            sprintf(val_str, "value string #%d for key #%d from thread #%d", j++, i, thread_index);
+            errors += (strcmp(val.c_str(), val_str) != 0) ? 1 : 0;
+        }
+    }
+    return errors;
+}
+
+template<class CT>
+int64_t
+time_thread_maps(int num_threads, size_t& errors)
+{
+    std::vector<std::thread>    threads;
+    std::atomic<size_t>         error_count{0};
+    std::atomic<bool>           go{false};
+    stopwatch                   sw;
+
+    for (int i = 0;  i < num_threads;  ++i)
+    {
+        threads.emplace_back([i, &go, &error_count]()
+        {
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+            error_count += build_thread_map<CT>(i);
+        });
+    }
+
+    sw.start();
+    go.store(true);
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    sw.stop();
+
+    CT::reset();
+    errors += error_count.load();
+    return sw.elapsed_usec();
+}
+
+void
+test_concurrent_ops(int max_threads)
+{
+    size_t  errors = 0;
+
+    std::cout << "***********************" << std::endl;
+    std::cout << "*****  TEST MT  *******" << std::endl;
+    std::cout << "each thread builds a map of " << mt_key_count << " keys x " << mt_value_count
+              << " values;  hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "elapsed time in usec:" << std::endl;
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "std::allocator"
+              << std::setw(16) << "concurrent" << std::setw(16) << "thread arena" << std::endl;
+
+    //- Initialize the segments up front, so that the cost is not charged to the first run.
+    //
+    concurrent_xl_strategy().allocate(1);
+    concurrent_xl_strategy::reset_segments();
+
+    for (int n = 1;  n <= max_threads;  n *= 2)
+    {
+        int64_t     t_std   = time_thread_maps<std_containers>(n, errors);
+        int64_t     t_conc  = time_thread_maps<syn_containers<concurrent_xl_strategy>>(n, errors);
+        int64_t     t_arena = time_thread_maps<syn_containers<arena_xl_strategy>>(n, errors);
+
+        std::cout << std::dec << std::setw(8) << n << std::setw(16) << t_std
+                  << std::setw(16) << t_conc << std::setw(16) << t_arena << std::endl;
+    }
+
+    CHECK(errors == 0);
+    std::cout << "errors: " << errors << std::endl << std::endl;
+}
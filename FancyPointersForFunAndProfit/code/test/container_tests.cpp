@@ -5,12 +5,14 @@
 //==================================================================================================
 //
 #include "container_tests.h"
+#include "root_directory.h"
 
 template class simple_string<rhx_allocator<char, wrapper_strategy>>;
 template class simple_string<rhx_allocator<char, based_2d_xl_strategy>>;
 template class simple_string<rhx_allocator<char, based_2d_sm_strategy>>;
 template class simple_string<rhx_allocator<char, based_2d_msk_strategy>>;
 template class simple_string<rhx_allocator<char, offset_strategy>>;
+template class simple_string<rhx_allocator<char, compact_strategy>>;
 
 template<class AS>
 void
@@ -37,6 +39,58 @@ do_test_string()
         std::cout << "  " << p.first << " : " << p.second << std::endl;
     }
     std::cout << std::endl;
+
+    //- Short strings are held inline, and so survive a bitwise copy of the object; long ones
+    //  are not, and the characters of a moved string change hands without being copied.
+    //
+    string_type     s6("a string too long to be held inline");
+    char const*     pchars = s6.data();
+    string_type     s7(std::move(s6));
+
+    string_type     s8("hello");
+
+    CHECK(s1.is_local()  &&  s8.is_local()  &&  mmap.begin()->first.is_local());
+    CHECK(!s7.is_local()  &&  s7.data() == pchars  &&  s6.empty());
+    CHECK(s4.empty()  &&  s5.view() == "good-bye, world");
+
+    alignas(string_type) unsigned char  raw[sizeof(string_type)];
+
+    std::memcpy(raw, &s8, sizeof(string_type));
+    CHECK(reinterpret_cast<string_type const*>(raw)->view() == "hello");
+
+    //- Comparisons order prefixes first, and interoperate with string_view.
+    //
+    CHECK(string_type("abc") < string_type("abcd")  &&  !(string_type("abcd") < string_type("abc")));
+    CHECK(s1 < s2  &&  !(s2 < s1)  &&  !(s1 < s1));
+    CHECK(s7.compare("a string too long to be held inline") == 0  &&  s7 != s2);
+
+    std::string_view    sv = s2;
+
+    s1 = sv;
+    CHECK(s1 == s2  &&  s1.data() != s2.data());
+    s1 = s7;
+    CHECK(s1 == s7  &&  s1.data() != s7.data());
+    s1 = "short";
+    CHECK(s1.is_local()  &&  s1.size() == 5  &&  std::strcmp(s1.c_str(), "short") == 0);
+
+    //- Assigning a longer value to the most recently allocated heap string extends its buffer
+    //  in place, using only the additional segment space; a shorter value reuses the buffer,
+    //  even when it is taken from the string itself.
+    //
+    typename AS::size_type  seg0, off0, seg1, off1;
+    string_type             s9("a string that is long enough for the heap");
+    char const*             pbuf = s9.data();
+
+    AS::get_position(seg0, off0);
+    s9.assign("a string that is long enough for the heap, and then some more");
+    AS::get_position(seg1, off1);
+    CHECK(s9.data() == pbuf  &&  seg1 == seg0  &&  off1 - off0 < s9.size());
+    CHECK(s9.view() == "a string that is long enough for the heap, and then some more");
+
+    s9.assign(s9.view().substr(2, 35));
+    s5 = s9;
+    CHECK(s9.data() == pbuf  &&  s9.view() == "string that is long enough for the ");
+    CHECK(s5 == s9  &&  s5.data() != pbuf);
 }
 
 
@@ -84,10 +138,16 @@ do_map_test(char const* strategy_name, bool do_reloc)
     using syn_alloc  = rhx_allocator<syn_pair, strategy>;
     using syn_map    = std::map<syn_string, syn_list, syn_less, syn_alloc>;
 
+    using directory  = root_directory<strategy>;
+
     auto    spmap = allocate<syn_map, strategy>();
     auto    spkey = allocate<syn_string, strategy>();
     auto    spval = allocate<syn_string, strategy>();
 
+    directory::bind("map", spmap);
+    directory::bind("key", spkey);
+    directory::bind("value", spval);
+
     char    key_str[128], val_str[128];
 
     for (int i = outer;  i < (outer + 3);  ++i)
@@ -112,14 +172,113 @@ do_map_test(char const* strategy_name, bool do_reloc)
 
     if (do_reloc)
     {
-        std::cout << "------  SWAPPING  ------" << std::endl;
+        stopwatch   sw;
+
+        sw.start();
         strategy::swap_segments();
+        sw.stop();
+
+        std::cout << "------  SWAPPING  ------  (" << std::dec << sw.elapsed_usec() << " usec)" << std::endl;
+#if defined(__GLIBCXX__)
+        //- libstdc++'s node-based containers link their nodes with ordinary pointers, so the map
+        //  cannot be traversed once its segments have really moved.  Show the last key and value
+        //  instead, as found through the root directory; they are reached only through synthetic
+        //  pointers.
+        //
+        std::cout << *directory::template find<syn_string>("key") << std::endl << "    "
+                  << *directory::template find<syn_string>("value") << std::endl << std::endl;
+#else
         print_map(*spmap);
+#endif
     }
 
     strategy::reset_segments();
 }
 
+//------
+//- Binds many names in the root directory (so that its table is regrown several times),
+//  unbinds and rebinds some of them, and checks every lookup before and after the segments are
+//  relocated.  The directory's own location is found through the first segment's header.
+//
+static int const    directory_count = 1000;
+
+template<class AS>
+size_t
+check_directory(int count)
+{
+    using directory = root_directory<AS>;
+
+    char    name[64];
+    size_t  errors = (directory::size() != (size_t) count) ? 1 : 0;
+
+    for (int i = 0;  i < count;  ++i)
+    {
+        sprintf(name, "root object #%d", i);
+
+        auto    pobj = directory::template find<uint64_t>(name);
+
+        errors += (pobj == nullptr  ||  *pobj != (uint64_t) i) ? 1 : 0;
+    }
+    sprintf(name, "root object #%d", count);
+    errors += (directory::find(name) != nullptr) ? 1 : 0;
+    return errors;
+}
+
+template<class AS>
+void
+do_directory_test(char const* strategy_name, bool do_reloc)
+{
+    using directory = root_directory<AS>;
+
+    char    name[64];
+    size_t  errors = 0;
+
+    AS::reset_segments();
+    errors += (directory::size() != 0) ? 1 : 0;
+
+    for (int i = 0;  i < directory_count;  ++i)
+    {
+        sprintf(name, "root object #%d", i);
+        errors += directory::bind(name, allocate<uint64_t, AS>(i)) ? 0 : 1;
+    }
+    errors += check_directory<AS>(directory_count);
+
+    //- Unbind every third name, and bind it again to a new object.
+    //
+    for (int i = 0;  i < directory_count;  i += 3)
+    {
+        sprintf(name, "root object #%d", i);
+        errors += directory::unbind(name) ? 0 : 1;
+        errors += directory::unbind(name) ? 1 : 0;
+        errors += (directory::find(name) != nullptr) ? 1 : 0;
+    }
+    for (int i = 0;  i < directory_count;  i += 3)
+    {
+        sprintf(name, "root object #%d", i);
+        errors += directory::bind(name, allocate<uint64_t, AS>(i)) ? 0 : 1;
+    }
+    errors += check_directory<AS>(directory_count);
+
+    //- Names must be non-empty and fit in an entry.
+    //
+    std::string     long_name(directory::max_name + 1, 'x');
+
+    errors += directory::bind("", nullptr) ? 1 : 0;
+    errors += directory::bind(long_name, nullptr) ? 1 : 0;
+
+    if (do_reloc)
+    {
+        AS::swap_segments();
+        errors += check_directory<AS>(directory_count);
+    }
+    CHECK(errors == 0);
+
+    std::cout << "  " << std::left << std::setw(16) << strategy_name << std::right
+              << directory::size() << " names bound, " << errors << " errors" << std::endl;
+
+    AS::reset_segments();
+}
+
 void
 test_map_ops()
 {
@@ -133,5 +292,15 @@ test_map_ops()
     DO_MAP_TEST(based_2d_sm_strategy, true);
     DO_MAP_TEST(based_2d_msk_strategy, true);
 #endif
+
+    std::cout << "***********************" << std::endl;
+    std::cout << "*** TEST DIRECTORY ****" << std::endl;
+    do_directory_test<wrapper_strategy>("wrapper", false);
+    do_directory_test<offset_strategy>("offset", false);
+    do_directory_test<based_2d_xl_strategy>("based_2d_xl", true);
+    do_directory_test<based_2d_sm_strategy>("based_2d_sm", true);
+    do_directory_test<based_2d_msk_strategy>("based_2d_msk", true);
+    do_directory_test<compact_strategy>("compact", true);
+    std::cout << std::endl;
 }
 
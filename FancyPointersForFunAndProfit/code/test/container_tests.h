@@ -10,6 +10,27 @@
 
 #include "pointer_tests.h"
 
+//--------------------------------------------------------------------------------------------------
+//  Class:
+//      simple_string<Alloc>
+//
+//  Summary:
+//      This class template implements a string whose characters are either held inline, in a
+//      buffer inside the object, or in a buffer obtained from allocator Alloc and held by the
+//      allocator's pointer type.  Strings short enough for the inline buffer (up to 15 chars
+//      with 8-byte pointers) cost no allocation, and since an inline string is marked by a
+//      null pointer rather than by a pointer to its own buffer, the object may be relocated
+//      (by memcpy, or with the segments that contain it) without any fix-ups.  Comparisons of
+//      short strings likewise read only the objects themselves.
+//
+//      The allocator is propagated as std::allocator_traits directs: it is moved along with
+//      the characters, and copied or swapped as the propagate_on_* traits say.
+//
+//      A heap buffer's capacity is kept in the otherwise unused inline buffer.  assign() reuses
+//      the buffer when the new value fits, and otherwise tries to extend it in place, which an
+//      rhx_allocator over a monotonic strategy can do when the buffer was its last allocation.
+//--------------------------------------------------------------------------------------------------
+//
 template<class Alloc>
 class simple_string
 {
@@ -23,6 +44,25 @@ class simple_string
     using const_pointer      = typename allocator_type::const_pointer;
     using value_type         = char;
 
+  private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    static constexpr bool   move_assign_noexcept =
+                                alloc_traits::propagate_on_container_move_assignment::value  ||
+                                alloc_traits::is_always_equal::value;
+
+    //- The inline buffer fills out the object to 32 bytes, less the allocator, but always has
+    //  room for at least seven characters and the terminator.
+    //
+    enum : size_type
+    {
+        local_bytes    = (sizeof(size_type) + sizeof(pointer) + 8 < 32)
+                       ? 32 - sizeof(size_type) - sizeof(pointer) : 8,
+        local_capacity = local_bytes - 1
+    };
+
+    static_assert(local_bytes >= sizeof(size_type), "simple_string inline buffer cannot hold a capacity");
+
   public:
     ~simple_string();
 
@@ -32,118 +72,136 @@ class simple_string
     simple_string(simple_string const& other, allocator_type const& alloc);
     simple_string(std::string const& str);
     simple_string(char const* pstr, allocator_type const& alloc=allocator_type());
+    explicit
+    simple_string(std::string_view str, allocator_type const& alloc=allocator_type());
 
-    simple_string&  operator =(simple_string&& rhs) noexcept;
+    simple_string&  operator =(simple_string&& rhs) noexcept(move_assign_noexcept);
     simple_string&  operator =(simple_string const& rhs);
     simple_string&  operator =(std::string const& str);
+    simple_string&  operator =(std::string_view str);
     simple_string&  operator =(char const* pstr);
 
+                    operator std::string_view() const noexcept;
+
+    allocator_type  get_allocator() const noexcept;
+
     char const*     c_str() const noexcept;
+    char const*     data() const noexcept;
+    bool            empty() const noexcept;
+    bool            is_local() const noexcept;
+    size_type       size() const noexcept;
+    std::string_view    view() const noexcept;
+
+    int             compare(std::string_view rhs) const noexcept;
     bool            equal_to(simple_string const& rhs) const noexcept;
     bool            less_than(simple_string const& rhs) const noexcept;
-    size_type       size() const noexcept;
 
     void            assign(char const* pstr);
+    void            assign(std::string_view str);
     void            swap(simple_string& other) noexcept;
 
   private:
-    pointer         mp_data;
     size_type       m_size;
+    pointer         mp_data;                //- Null when the characters are inline
+    char            m_local[local_bytes];
     allocator_type  m_alloc;
-};
 
+    size_type       heap_capacity() const noexcept;
+    void            set_heap_capacity(size_type capacity) noexcept;
+
+    void            copy_in(char const* pstr, size_type len);
+    void            release() noexcept;
+    void            steal(simple_string& other) noexcept;
+    void            swap_all(simple_string& other) noexcept;
+};
 
+//------
+//
 template<class Alloc> inline
 simple_string<Alloc>::~simple_string()
 {
-    if (mp_data != nullptr)
-    {
-        m_alloc.deallocate(mp_data, 1);
-    }
+    release();
 }
 
 template<class Alloc> inline
 simple_string<Alloc>::simple_string(allocator_type const& alloc) noexcept
-:   mp_data(nullptr)
-,   m_size(0)
+:   m_size(0)
+,   mp_data(nullptr)
+,   m_local{}
 ,   m_alloc(alloc)
 {}
 
 template<class Alloc> inline
 simple_string<Alloc>::simple_string(simple_string&& other) noexcept
-:   mp_data(other.mp_data)
-,   m_size(other.m_size)
+:   m_size(0)
+,   mp_data(nullptr)
+,   m_local{}
+,   m_alloc(std::move(other.m_alloc))
 {
-    other.mp_data = nullptr;
-    other.m_size  = 0;
+    steal(other);
 }
 
 template<class Alloc>
 simple_string<Alloc>::simple_string(simple_string const& other)
-:   mp_data(nullptr)
-,   m_size(0)
-{
-    if (other.m_size > 0)
-    {
-        mp_data = m_alloc.allocate(other.m_size + 1);
-        m_size  = other.m_size;
-        std::copy(other.mp_data, other.mp_data + m_size, mp_data);
-        mp_data[m_size] = '\0';
-    }
-}
+:   simple_string(other, alloc_traits::select_on_container_copy_construction(other.m_alloc))
+{}
 
 template<class Alloc>
 simple_string<Alloc>::simple_string(simple_string const& other, allocator_type const& alloc)
-:   mp_data(nullptr)
-,   m_size(0)
-,   m_alloc(alloc)
+:   simple_string(alloc)
 {
-    if (other.m_size > 0)
-    {
-        mp_data = m_alloc.allocate(other.m_size + 1);
-        m_size  = other.m_size;
-        std::copy(other.mp_data, other.mp_data + m_size, mp_data);
-        mp_data[m_size] = '\0';
-    }
+    copy_in(other.data(), other.m_size);
 }
 
 template<class Alloc>
 simple_string<Alloc>::simple_string(std::string const& str)
-:   mp_data(nullptr)
-,   m_size(0)
-{
-    if (str.size() > 0)
-    {
-        mp_data = m_alloc.allocate(str.size() + 1);
-        m_size  = str.size();
-        std::copy(str.begin(), str.end() + m_size, mp_data);
-        mp_data[m_size] = '\0';
-    }
-}
+:   simple_string(std::string_view(str))
+{}
 
 template<class Alloc>
 simple_string<Alloc>::simple_string(char const* pstr, allocator_type const& alloc)
-:   mp_data(nullptr)
-,   m_size(0)
-,   m_alloc(alloc)
+:   simple_string(alloc)
 {
     if (pstr != nullptr)
     {
-        if (size_t len = std::strlen(pstr);  len > 0)
-        {
-            mp_data = m_alloc.allocate(len + 1);
-            m_size  = len;
-            std::copy(pstr, pstr + len, mp_data);
-            mp_data[m_size] = '\0';
-        }
+        copy_in(pstr, std::strlen(pstr));
     }
 }
 
+template<class Alloc>
+simple_string<Alloc>::simple_string(std::string_view str, allocator_type const& alloc)
+:   simple_string(alloc)
+{
+    copy_in(str.data(), str.size());
+}
+
+//------
+//- Move assignment takes the other string's buffer when the allocators permit, and otherwise
+//  copies the characters into a buffer of its own.
+//
 template<class Alloc>
 simple_string<Alloc>&
-simple_string<Alloc>::operator =(simple_string&& other) noexcept
+simple_string<Alloc>::operator =(simple_string&& other) noexcept(move_assign_noexcept)
 {
-    this->swap(other);
+    if (&other != this)
+    {
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            release();
+            m_alloc = std::move(other.m_alloc);
+            steal(other);
+        }
+        else if (alloc_traits::is_always_equal::value  ||  m_alloc == other.m_alloc)
+        {
+            release();
+            steal(other);
+        }
+        else
+        {
+            simple_string   tmp(other, m_alloc);
+            swap_all(tmp);
+        }
+    }
     return *this;
 }
 
@@ -153,8 +211,16 @@ simple_string<Alloc>::operator =(simple_string const& other)
 {
     if (&other != this)
     {
-        simple_string   tmp(other, m_alloc);
-        this->swap(tmp);
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            simple_string   tmp(other, other.m_alloc);
+            swap_all(tmp);
+        }
+        else
+        {
+            simple_string   tmp(other, m_alloc);
+            swap_all(tmp);
+        }
     }
     return *this;
 }
@@ -163,8 +229,15 @@ template<class Alloc>
 simple_string<Alloc>&
 simple_string<Alloc>::operator =(std::string const& str)
 {
-    simple_string   tmp(str, m_alloc);
-    this->swap(tmp);
+    assign(std::string_view(str));
+    return *this;
+}
+
+template<class Alloc>
+simple_string<Alloc>&
+simple_string<Alloc>::operator =(std::string_view str)
+{
+    assign(str);
     return *this;
 }
 
@@ -172,33 +245,51 @@ template<class Alloc>
 simple_string<Alloc>&
 simple_string<Alloc>::operator =(char const* pstr)
 {
-    simple_string   tmp(pstr, m_alloc);
-    this->swap(tmp);
+    assign(pstr);
     return *this;
 }
 
+//------
+//
+template<class Alloc> inline
+simple_string<Alloc>::operator std::string_view() const noexcept
+{
+    return view();
+}
+
+template<class Alloc> inline
+typename simple_string<Alloc>::allocator_type
+simple_string<Alloc>::get_allocator() const noexcept
+{
+    return m_alloc;
+}
+
 template<class Alloc> inline
 char const*
 simple_string<Alloc>::c_str() const noexcept
 {
-    return static_cast<char const*>(mp_data);
+    return data();
+}
+
+template<class Alloc> inline
+char const*
+simple_string<Alloc>::data() const noexcept
+{
+    return (mp_data == nullptr) ? m_local : to_address(mp_data);
 }
 
 template<class Alloc> inline
 bool
-simple_string<Alloc>::equal_to(simple_string const& rhs) const noexcept
+simple_string<Alloc>::empty() const noexcept
 {
-    return (m_size == rhs.m_size)  &&
-           (mp_data == rhs.mp_data  ||  memcmp(mp_data, rhs.mp_data, m_size) == 0);
+    return m_size == 0;
 }
 
 template<class Alloc> inline
 bool
-simple_string<Alloc>::less_than(simple_string const& rhs) const noexcept
+simple_string<Alloc>::is_local() const noexcept
 {
-    return (mp_data != nullptr)     &&
-           (rhs.mp_data != nullptr) &&
-           (std::char_traits<char>::compare(mp_data, rhs.mp_data, std::min(m_size, rhs.m_size)) < 0);
+    return mp_data == nullptr;
 }
 
 template<class Alloc> inline
@@ -208,23 +299,203 @@ simple_string<Alloc>::size() const noexcept
     return m_size;
 }
 
+template<class Alloc> inline
+std::string_view
+simple_string<Alloc>::view() const noexcept
+{
+    return std::string_view(data(), m_size);
+}
+
+//------
+//
+template<class Alloc> inline
+int
+simple_string<Alloc>::compare(std::string_view rhs) const noexcept
+{
+    return view().compare(rhs);
+}
+
+template<class Alloc> inline
+bool
+simple_string<Alloc>::equal_to(simple_string const& rhs) const noexcept
+{
+    return (m_size == rhs.m_size)  &&  std::memcmp(data(), rhs.data(), m_size) == 0;
+}
+
+template<class Alloc> inline
+bool
+simple_string<Alloc>::less_than(simple_string const& rhs) const noexcept
+{
+    return view().compare(rhs.view()) < 0;
+}
+
+//------
+//
 template<class Alloc> inline
 void
 simple_string<Alloc>::assign(char const* pstr)
 {
-    simple_string   tmp(pstr, m_alloc);
-    this->swap(tmp);
+    assign((pstr != nullptr) ? std::string_view(pstr) : std::string_view());
+}
+
+//- Assigns in place where it can: inline if the value is short, and otherwise into the current
+//  heap buffer, possibly extended.  The value may alias this string's own characters.
+//
+template<class Alloc>
+void
+simple_string<Alloc>::assign(std::string_view str)
+{
+    size_type const     len = str.size();
+
+    if (len <= local_capacity)
+    {
+        char    local[local_bytes];
+
+        std::memcpy(local, str.data(), len);
+        release();
+        std::memcpy(m_local, local, len);
+        m_local[len] = '\0';
+        m_size       = len;
+        return;
+    }
+
+    if (mp_data != nullptr)
+    {
+        size_type   capacity = heap_capacity();
+        bool        fits     = (len <= capacity);
+
+        if constexpr (has_try_extend<allocator_type, pointer>::value)
+        {
+            if (!fits  &&  m_alloc.try_extend(mp_data, capacity + 1, len + 1))
+            {
+                fits = true;
+                set_heap_capacity(len);
+            }
+        }
+        if (fits)
+        {
+            raw_span<char>  dst = to_span(mp_data, mp_data + len + 1);
+
+            std::memmove(dst.data(), str.data(), len);
+            dst[len] = '\0';
+            m_size   = len;
+            return;
+        }
+    }
+
+    simple_string   tmp(str, m_alloc);
+    swap_all(tmp);
 }
 
 template<class Alloc> inline
 void
 simple_string<Alloc>::swap(simple_string& other) noexcept
 {
-    std::swap(mp_data, other.mp_data);
-    std::swap(m_size, other.m_size);
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+    {
+        swap_all(other);
+    }
+    else
+    {
+        swap_all(other);
+        std::swap(m_alloc, other.m_alloc);      //- Put the allocators back
+    }
+}
+
+//------
+//
+template<class Alloc> inline
+typename simple_string<Alloc>::size_type
+simple_string<Alloc>::heap_capacity() const noexcept
+{
+    size_type   capacity;
+
+    std::memcpy(&capacity, m_local, sizeof(size_type));
+    return capacity;
+}
+
+template<class Alloc> inline
+void
+simple_string<Alloc>::set_heap_capacity(size_type capacity) noexcept
+{
+    std::memcpy(m_local, &capacity, sizeof(size_type));
+}
+
+//- Copies len characters into a string that holds none, either inline or, for a longer
+//  string, into a buffer that is filled through a native span that is resolved once, rather
+//  than through a synthetic pointer resolved for every character.
+//
+template<class Alloc>
+void
+simple_string<Alloc>::copy_in(char const* pstr, size_type len)
+{
+    if (len <= local_capacity)
+    {
+        std::memcpy(m_local, pstr, len);
+        m_local[len] = '\0';
+    }
+    else
+    {
+        mp_data = m_alloc.allocate(len + 1);
+        set_heap_capacity(len);
+
+        raw_span<char>  dst = to_span(mp_data, mp_data + len + 1);
+
+        std::copy(pstr, pstr + len, dst.begin());
+        dst[len] = '\0';
+    }
+    m_size = len;
+}
+
+template<class Alloc> inline
+void
+simple_string<Alloc>::release() noexcept
+{
+    if (mp_data != nullptr)
+    {
+        m_alloc.deallocate(mp_data, heap_capacity() + 1);
+        mp_data = nullptr;
+    }
+    m_size     = 0;
+    m_local[0] = '\0';
+}
+
+//- Takes the characters of other, which is left empty, into a string that holds none.  Only
+//  the pointer to a buffer changes hands; inline characters (or the buffer's capacity) are
+//  copied.
+//
+template<class Alloc> inline
+void
+simple_string<Alloc>::steal(simple_string& other) noexcept
+{
+    std::memcpy(m_local, other.m_local, local_bytes);
+    if (other.mp_data != nullptr)
+    {
+        mp_data       = other.mp_data;
+        other.mp_data = nullptr;
+    }
+    m_size           = other.m_size;
+    other.m_size     = 0;
+    other.m_local[0] = '\0';
 }
 
+template<class Alloc> inline
+void
+simple_string<Alloc>::swap_all(simple_string& other) noexcept
+{
+    char    local[local_bytes];
+
+    std::memcpy(local, m_local, local_bytes);
+    std::memcpy(m_local, other.m_local, local_bytes);
+    std::memcpy(other.m_local, local, local_bytes);
 
+    std::swap(m_size, other.m_size);
+    std::swap(mp_data, other.mp_data);
+    std::swap(m_alloc, other.m_alloc);
+}
+
+//------
+//
 template<class Alloc> inline
 bool
 operator <(simple_string<Alloc> const& lhs, simple_string<Alloc> const& rhs)
@@ -250,7 +521,7 @@ template<class Alloc> inline
 std::ostream&
 operator <<(std::ostream& os, simple_string<Alloc> const& str)
 {
-    os << str.c_str();
+    os << str.view();
     return os;
 }
 
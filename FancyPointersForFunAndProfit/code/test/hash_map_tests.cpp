@@ -0,0 +1,164 @@
+//==================================================================================================
+//  File:   hash_map_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <random>
+
+#include "flat_hash_map.h"
+#include "container_tests.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Flat hash map tests.  For each allocation strategy, a flat_hash_map<uint64_t, uint64_t> is
+//  constructed in the segments, filled with random keys, checked against a reference, and
+//  searched for every key and for as many absent keys.  Some keys are then erased and
+//  reinserted, so that tombstones are reused, and the segments are relocated (for the
+//  strategies whose pointers may be held outside the segments) before the map is checked
+//  again.  A std::map with the same allocator and keys is timed alongside it, for comparison
+//  with red-black tree lookups.
+//--------------------------------------------------------------------------------------------------
+//
+static size_t const     hash_key_count = 500000;
+
+template<class AS, class MT>
+MT*
+construct_in_segments(AS& heap, typename AS::template rebind_pointer<MT>& pmap)
+{
+    pmap = static_cast<typename AS::template rebind_pointer<MT>>(heap.allocate(sizeof(MT)));
+    return ::new (static_cast<MT*>(pmap)) MT();
+}
+
+template<class AS, class MT>
+size_t
+check_hash_map(MT const& map, std::vector<uint64_t> const& keys, size_t count)
+{
+    size_t  errors = (map.size() != count) ? 1 : 0;
+
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        uint64_t const*     pval = map.find(keys[i]);
+
+        errors += (pval == nullptr  ||  *pval != keys[i] * 3) ? 1 : 0;
+    }
+    for (size_t i = count;  i < keys.size();  ++i)
+    {
+        errors += map.contains(keys[i]) ? 1 : 0;
+    }
+    return errors;
+}
+
+template<class AS>
+void
+do_hash_map_test(char const* name, std::vector<uint64_t> const& keys, bool reloc)
+{
+    using alloc_type = rhx_allocator<std::pair<uint64_t const, uint64_t>, AS>;
+    using hash_map   = flat_hash_map<uint64_t, uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>, alloc_type>;
+    using tree_map   = std::map<uint64_t, uint64_t, std::less<uint64_t>, alloc_type>;
+    using hash_ptr   = typename AS::template rebind_pointer<hash_map>;
+    using tree_ptr   = typename AS::template rebind_pointer<tree_map>;
+
+    AS          heap;
+    hash_ptr    phash;
+    tree_ptr    ptree;
+    size_t      count  = keys.size() / 2;     //- The second half of the keys are never inserted
+    size_t      errors = 0;
+    uint64_t    sum    = 0;
+    stopwatch   sw;
+
+    heap.reset_segments();
+
+    hash_map&   hmap = *construct_in_segments<AS, hash_map>(heap, phash);
+    tree_map&   tmap = *construct_in_segments<AS, tree_map>(heap, ptree);
+
+    sw.start();
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        hmap.try_emplace(keys[i], keys[i] * 3);
+    }
+    sw.stop();
+    int64_t     hash_insert = sw.elapsed_msec();
+
+    sw.start();
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        tmap.emplace(keys[i], keys[i] * 3);
+    }
+    sw.stop();
+    int64_t     tree_insert = sw.elapsed_msec();
+
+    errors += check_hash_map<AS>(hmap, keys, count);
+
+    //- Time lookups of every key, half of which are present.
+    //
+    sw.start();
+    for (uint64_t key : keys)
+    {
+        uint64_t const*     pval = hmap.find(key);
+        sum += (pval != nullptr) ? *pval : 0;
+    }
+    sw.stop();
+    int64_t     hash_lookup = sw.elapsed_msec();
+
+    sw.start();
+    for (uint64_t key : keys)
+    {
+        auto    it = tmap.find(key);
+        sum -= (it != tmap.end()) ? it->second : 0;
+    }
+    sw.stop();
+    int64_t     tree_lookup = sw.elapsed_msec();
+
+    CHECK(sum == 0);
+
+    //- Erase every fourth key and put it back, then relocate.
+    //
+    for (size_t i = 0;  i < count;  i += 4)
+    {
+        errors += hmap.erase(keys[i]) ? 0 : 1;
+        errors += hmap.erase(keys[i]) ? 1 : 0;
+    }
+    for (size_t i = 0;  i < count;  i += 4)
+    {
+        hmap[keys[i]] = keys[i] * 3;
+    }
+    if (reloc)
+    {
+        AS::swap_segments();
+    }
+    errors += check_hash_map<AS>(*phash, keys, count);
+    CHECK(errors == 0);
+
+    std::cout << "  " << std::left << std::setw(16) << name << std::right
+              << "flat: insert " << std::setw(4) << hash_insert << " msec, lookup "
+              << std::setw(4) << hash_lookup << " msec;  std::map: insert "
+              << std::setw(4) << tree_insert << " msec, lookup "
+              << std::setw(4) << tree_lookup << " msec" << std::endl;
+
+    heap.reset_segments();
+}
+
+void
+test_hash_map_ops()
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "*** TEST FLAT HASH ****" << std::endl;
+
+    std::mt19937_64         gen(4242);
+    std::vector<uint64_t>   keys(hash_key_count * 2);
+
+    for (auto& key : keys)
+    {
+        key = gen();
+    }
+
+    std::cout << hash_key_count << " keys inserted, " << keys.size() << " looked up" << std::endl;
+
+    do_hash_map_test<wrapper_strategy>("wrapper", keys, false);
+    do_hash_map_test<offset_strategy>("offset", keys, false);
+    do_hash_map_test<based_2d_xl_strategy>("based_2d_xl", keys, true);
+    do_hash_map_test<based_2d_sm_strategy>("based_2d_sm", keys, true);
+    do_hash_map_test<based_2d_msk_strategy>("based_2d_msk", keys, true);
+    do_hash_map_test<compact_strategy>("compact", keys, true);
+    std::cout << std::endl;
+}
@@ -15,15 +15,51 @@ void    run_pointer_tests(bool do_copy, bool do_sort);
 void    test_string_ops();
 void    test_map_ops();
 void    test_scd();
+void    test_concurrent_ops(int max_threads);
+void    test_churn_ops();
+void    test_segment_growth_ops(size_t segment_count);
+void    test_tagged_ops();
+void    test_compact_ops();
+void    test_pin_ops();
+void    test_hash_map_ops();
+void    test_bplus_ops();
+void    test_seg_vector_ops();
+
+//- These tests use POSIX mmap(), and are not built for Windows.
+//
+#ifndef _WIN32
+void    test_mmap_ops(char const* path_prefix, bool do_build, bool do_load);
+void    test_shm_ops(char const* name_prefix, int num_procs);
+void    test_snapshot_ops();
+#endif
 
 bool    copy_flag    = true;
 bool    sort_flag    = true;
 bool    strop_flag   = true;
 bool    map_flag     = false;
 bool    heap_flag    = false;
+bool    mmap_build   = false;
+bool    mmap_load    = false;
+bool    shm_flag     = false;
+int     shm_procs    = 4;
+bool    mt_flag      = false;
+int     mt_threads   = 32;
+bool    churn_flag   = false;
+bool    growth_flag  = false;
+size_t  growth_segs  = 64;
+bool    tagged_flag  = false;
+bool    compact_flag = false;
+bool    pin_flag     = false;
+bool    hash_flag    = false;
+bool    bplus_flag   = false;
+bool    segvec_flag  = false;
+bool    snap_flag    = false;
 bool    verbose_flag = false;
 size_t  max_elem_idx = 13;
 
+char const*     mmap_prefix = "/tmp/fancy_segments";
+char const*     shm_prefix  = "fancy_segments";
+
 bool
 verbose_output()
 {
@@ -36,6 +72,32 @@ max_ptr_op_count_index()
     return max_elem_idx;
 }
 
+//- Every mode flag is cleared before the one named on the command line is set, so that the
+//  last mode given is the only one that runs.
+//
+static void
+clear_mode_flags()
+{
+    copy_flag    = false;
+    sort_flag    = false;
+    strop_flag   = false;
+    map_flag     = false;
+    heap_flag    = false;
+    mmap_build   = false;
+    mmap_load    = false;
+    shm_flag     = false;
+    mt_flag      = false;
+    churn_flag   = false;
+    growth_flag  = false;
+    tagged_flag  = false;
+    compact_flag = false;
+    pin_flag     = false;
+    hash_flag    = false;
+    bplus_flag   = false;
+    segvec_flag  = false;
+    snap_flag    = false;
+}
+
 
 int main(int argc, char* argv[])
 {
@@ -57,43 +119,117 @@ int main(int argc, char* argv[])
         }
         else if (arg == "-c")
         {
-            copy_flag  = true;
-            sort_flag  = false;
-            strop_flag = false;
-            map_flag   = false;
-            heap_flag  = false;
+            clear_mode_flags();
+            copy_flag = true;
         }
         else if (arg == "-s")
         {
-            copy_flag  = false;
-            sort_flag  = true;
-            strop_flag = false;
-            map_flag   = false;
-            heap_flag  = false;
+            clear_mode_flags();
+            sort_flag = true;
         }
         else if (arg == "-ss")
         {
-            copy_flag  = false;
-            sort_flag  = false;
+            clear_mode_flags();
             strop_flag = true;
-            map_flag   = false;
-            heap_flag  = false;
         }
         else if (arg == "-m")
         {
-            copy_flag  = false;
-            sort_flag  = false;
-            strop_flag = false;
-            map_flag   = true;
-            heap_flag  = false;
+            clear_mode_flags();
+            map_flag = true;
         }
         else if (arg == "-h")
         {
-            copy_flag  = false;
-            sort_flag  = false;
-            strop_flag = false;
-            map_flag   = false;
-            heap_flag  = true;
+            clear_mode_flags();
+            heap_flag = true;
+        }
+        else if (arg == "-mm"  ||  arg == "-mmb"  ||  arg == "-mml")
+        {
+            clear_mode_flags();
+            mmap_build = (arg != "-mml");
+            mmap_load  = (arg != "-mmb");
+        }
+        else if (arg == "-mf")
+        {
+            if (++i < argc)
+            {
+                mmap_prefix = argv[i];
+            }
+        }
+        else if (arg == "-shm")
+        {
+            clear_mode_flags();
+            shm_flag = true;
+        }
+        else if (arg == "-np")
+        {
+            if (++i < argc)
+            {
+                shm_procs = atoi(argv[i]);
+            }
+        }
+        else if (arg == "-mt")
+        {
+            clear_mode_flags();
+            mt_flag = true;
+        }
+        else if (arg == "-ch")
+        {
+            clear_mode_flags();
+            churn_flag = true;
+        }
+        else if (arg == "-sg")
+        {
+            clear_mode_flags();
+            growth_flag = true;
+        }
+        else if (arg == "-tg")
+        {
+            clear_mode_flags();
+            tagged_flag = true;
+        }
+        else if (arg == "-cp")
+        {
+            clear_mode_flags();
+            compact_flag = true;
+        }
+        else if (arg == "-pin")
+        {
+            clear_mode_flags();
+            pin_flag = true;
+        }
+        else if (arg == "-hm")
+        {
+            clear_mode_flags();
+            hash_flag = true;
+        }
+        else if (arg == "-bp")
+        {
+            clear_mode_flags();
+            bplus_flag = true;
+        }
+        else if (arg == "-sv")
+        {
+            clear_mode_flags();
+            segvec_flag = true;
+        }
+        else if (arg == "-snap")
+        {
+            clear_mode_flags();
+            snap_flag = true;
+        }
+        else if (arg == "-sc")
+        {
+            if (++i < argc)
+            {
+                growth_segs = (size_t) atoi(argv[i]);
+            }
+        }
+        else if (arg == "-nt")
+        {
+            if (++i < argc)
+            {
+                mt_threads = atoi(argv[i]);
+            }
         }
     }
 
@@ -109,5 +245,45 @@ int main(int argc, char* argv[])
     if (heap_flag)
         test_scd();
 
+#ifndef _WIN32
+    if (mmap_build || mmap_load)
+        test_mmap_ops(mmap_prefix, mmap_build, mmap_load);
+
+    if (shm_flag)
+        test_shm_ops(shm_prefix, shm_procs);
+#endif
+
+    if (mt_flag)
+        test_concurrent_ops(mt_threads);
+
+    if (churn_flag)
+        test_churn_ops();
+
+    if (growth_flag)
+        test_segment_growth_ops(growth_segs);
+
+    if (tagged_flag)
+        test_tagged_ops();
+
+    if (compact_flag)
+        test_compact_ops();
+
+    if (pin_flag)
+        test_pin_ops();
+
+    if (hash_flag)
+        test_hash_map_ops();
+
+    if (bplus_flag)
+        test_bplus_ops();
+
+    if (segvec_flag)
+        test_seg_vector_ops();
+
+#ifndef _WIN32
+    if (snap_flag)
+        test_snapshot_ops();
+#endif
+
     return 0;
 }
@@ -0,0 +1,537 @@
+//==================================================================================================
+//  File:   mmap_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <fstream>
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "container_tests.h"
+#include "mmap_storage.h"
+#include "root_directory.h"
+#include "shm_storage.h"
+
+using mmap_based_2d_xl_strategy  = monotonic_allocation_strategy<mmap_based_2d_xl_storage_model>;
+using mmap_based_2d_sm_strategy  = monotonic_allocation_strategy<mmap_based_2d_sm_storage_model>;
+using mmap_based_2d_msk_strategy = monotonic_allocation_strategy<mmap_based_2d_msk_storage_model>;
+using mmap_offset_strategy       = monotonic_allocation_strategy<mmap_offset_storage_model>;
+using shm_based_2d_xl_strategy   = monotonic_allocation_strategy<shm_based_2d_xl_storage_model>;
+
+//--------------------------------------------------------------------------------------------------
+//  Struct:
+//      mmap_table<AS>
+//
+//  Summary:
+//      A simple lookup table, sorted by key, in which each key maps to a list of value strings.
+//      Note that this uses std::vector rather than std::map/std::list, because the node-based
+//      containers in libstdc++ link their nodes with ordinary pointers internally, and those
+//      would be left dangling when the segments are mapped at a new address.  std::vector
+//      stores its allocator's pointer type, so the whole table is position-independent.
+//--------------------------------------------------------------------------------------------------
+//
+template<class AS>
+struct mmap_table
+{
+    using syn_string = simple_string<rhx_allocator<char, AS>>;
+    using syn_values = std::vector<syn_string, rhx_allocator<syn_string, AS>>;
+    using syn_entry  = std::pair<syn_string, syn_values>;
+    using syn_table  = std::vector<syn_entry, rhx_allocator<syn_entry, AS>>;
+
+    syn_table   m_entries;
+
+    void                add_entries(int first_key, int key_count, int value_count);
+    syn_values const*   find(char const* key) const;
+};
+
+template<class AS>
+void
+mmap_table<AS>::add_entries(int first_key, int key_count, int value_count)
+{
+    char    key_str[128], val_str[128];
+
+    for (int i = first_key;  i < (first_key + key_count);  ++i)
+    {
+        sprintf(key_str, "this is key string #%08d", i);
+        m_entries.emplace_back(syn_string(key_str), syn_values());
+
+        for (int j = 0;  j < value_count;  ++j)
+        {
+            sprintf(val_str, "this is string #%d created for key #%d", j, i);
+            m_entries.back().second.emplace_back(val_str);
+        }
+    }
+}
+
+template<class AS>
+typename mmap_table<AS>::syn_values const*
+mmap_table<AS>::find(char const* key) const
+{
+    auto    iter = std::lower_bound(m_entries.begin(), m_entries.end(), key,
+                                    [](syn_entry const& e, char const* k)
+                                    { return strcmp(e.first.c_str(), k) < 0; });
+
+    return (iter != m_entries.end()  &&  strcmp(iter->first.c_str(), key) == 0)
+            ? &iter->second : nullptr;
+}
+
+//------
+//
+static int const    mmap_key_count   = 20000;
+static int const    mmap_value_count = 5;
+static size_t const mmap_small_segment_size = 16u << 20;
+
+template<typename AllocStrategy>
+bool
+verify_mmap_table(mmap_table<AllocStrategy> const& table)
+{
+    char    key_str[128], val_str[128];
+    size_t  errors = 0;
+
+    CHECK(table.m_entries.size() == (size_t) mmap_key_count);
+
+    for (int i = 0;  i < mmap_key_count;  i += 97)
+    {
+        sprintf(key_str, "this is key string #%08d", i);
+
+        auto const*     pvals = table.find(key_str);
+
+        if (pvals == nullptr  ||  pvals->size() != (size_t) mmap_value_count)
+        {
+            ++errors;
+            continue;
+        }
+        for (int j = 0;  j < mmap_value_count;  ++j)
+        {
+            sprintf(val_str, "this is string #%d created for key #%d", j, i);
+            errors += (strcmp((*pvals)[j].c_str(), val_str) != 0) ? 1 : 0;
+        }
+    }
+    CHECK(errors == 0);
+
+    return errors == 0;
+}
+
+//- Builds a table in a fresh set of segment files of the given size, and leaves it there.
+//
+template<typename AllocStrategy>
+bool
+build_mmap_table(char const* path_prefix, size_t segment_size)
+{
+    using strategy      = AllocStrategy;
+    using storage_model = typename strategy::storage_model;
+    using table_type    = mmap_table<strategy>;
+    using size_type     = typename storage_model::size_type;
+
+    if (!storage_model::create_segments(path_prefix, segment_size))
+    {
+        std::cout << "unable to create segment files with prefix " << path_prefix << std::endl;
+        return false;
+    }
+
+    stopwatch   sw;
+    size_type   segment, offset;
+
+    //- The table is found again through the root directory, under its name.
+    //
+    strategy::set_position(storage_model::first_segment_index(), storage_model::header_size);
+    auto    sptable = allocate<table_type, strategy>();
+
+    root_directory<strategy>::bind("mmap_table", sptable);
+
+    sptable->add_entries(0, mmap_key_count, mmap_value_count);
+
+    strategy::get_position(segment, offset);
+    storage_model::header()->m_next_segment = segment;
+    storage_model::header()->m_next_offset  = offset;
+    storage_model::sync_segments();
+    sw.stop();
+
+    std::cout << "  built " << std::dec << sptable->m_entries.size() << " keys at 0x" << std::hex
+              << (uintptr_t) storage_model::segment_address(storage_model::first_segment_index())
+              << std::dec << " in " << sw.elapsed_msec() << " msec, "
+              << (segment - storage_model::first_segment_index() + 1) << " segment(s) of "
+              << (segment_size >> 10) << " KB" << std::endl;
+
+    storage_model::close_segments();
+    return true;
+}
+
+//- Maps an existing set of segment files, verifies the table, and appends to it.
+//
+template<typename AllocStrategy>
+bool
+load_mmap_table(char const* path_prefix)
+{
+    using strategy      = AllocStrategy;
+    using storage_model = typename strategy::storage_model;
+    using table_type    = mmap_table<strategy>;
+
+    stopwatch   sw;
+
+    if (!storage_model::open_segments(path_prefix))
+    {
+        std::cout << "unable to open segment files with prefix " << path_prefix << std::endl;
+        return false;
+    }
+
+    char*           pbase  = storage_model::segment_address(storage_model::first_segment_index());
+    table_type*     ptable = static_cast<table_type*>(root_directory<strategy>::template find<table_type>("mmap_table"));
+
+    if (ptable == nullptr)
+    {
+        std::cout << "  no table found in segment files with prefix " << path_prefix << std::endl;
+        storage_model::close_segments();
+        return false;
+    }
+
+    strategy::set_position(storage_model::header()->m_next_segment,
+                           storage_model::header()->m_next_offset);
+    sw.stop();
+
+    std::cout << "  loaded " << std::dec << ptable->m_entries.size() << " keys at 0x" << std::hex
+              << (uintptr_t) pbase << std::dec << " in " << sw.elapsed_usec() << " usec" << std::endl;
+
+    bool    okay = verify_mmap_table(*ptable);
+
+    //- Allocation must resume after the existing objects, not overwrite them.  The segments are
+    //  mapped at unrelated addresses, so the new object's position is compared as a segment
+    //  index and offset.
+    //
+    auto    spextra = allocate<typename table_type::syn_string, strategy>("an extra string");
+    char*   pextra  = static_cast<char*>(static_cast<void*>(spextra));
+    size_t  segment = storage_model::segment_index(pextra);
+    size_t  offset  = pextra - storage_model::segment_address(segment);
+
+    CHECK(segment > storage_model::header()->m_next_segment  ||
+          (segment == storage_model::header()->m_next_segment  &&
+           offset >= storage_model::header()->m_next_offset));
+    okay = okay  &&  verify_mmap_table(*ptable);
+
+    storage_model::close_segments();
+    return okay;
+}
+
+template<typename AllocStrategy>
+void
+do_mmap_test(char const* strategy_name, char const* path_prefix, size_t segment_size)
+{
+    using storage_model = typename AllocStrategy::storage_model;
+
+    std::cout << "***********************" << std::endl;
+    std::cout << "*****  TEST MMAP  *****" << std::endl;
+    std::cout << "for strategy: " << strategy_name << std::endl;
+
+    if (build_mmap_table<AllocStrategy>(path_prefix, segment_size))
+    {
+        //- Occupy the address range just released, so that the segments are very likely to be
+        //  mapped somewhere else when they are reopened.
+        //
+        size_t  span    = storage_model::max_segment_count() * storage_model::max_segment_size();
+        void*   pblock  = mmap(nullptr, span, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        bool    okay = load_mmap_table<AllocStrategy>(path_prefix);
+
+        if (pblock != MAP_FAILED)
+        {
+            munmap(pblock, span);
+        }
+        std::cout << "  reopened table is " << (okay ? "intact" : "CORRUPT") << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+//- Runs the build/reopen round trip for every persistent storage model, or, for showing that
+//  the table survives from one process to the next, only the build or only the load step.  The
+//  round trip is also run with segment files smaller than max_size, which the allocation
+//  strategies must fill only up to their actual size, and across more than one segment.
+//
+void
+test_mmap_ops(char const* path_prefix, bool do_build, bool do_load)
+{
+    #define DO_MMAP_TEST(AS)  do_mmap_test<AS>(#AS, path_prefix, mmap_storage_model::max_size)
+
+    if (do_build  &&  do_load)
+    {
+        DO_MMAP_TEST(mmap_based_2d_xl_strategy);
+        DO_MMAP_TEST(mmap_based_2d_sm_strategy);
+        DO_MMAP_TEST(mmap_based_2d_msk_strategy);
+        DO_MMAP_TEST(mmap_offset_strategy);
+
+        do_mmap_test<mmap_based_2d_xl_strategy>("mmap_based_2d_xl_strategy, small segments",
+                                                path_prefix, mmap_small_segment_size);
+    }
+    else if (do_build)
+    {
+        build_mmap_table<mmap_based_2d_xl_strategy>(path_prefix, mmap_storage_model::max_size);
+    }
+    else if (do_load)
+    {
+        bool    okay = load_mmap_table<mmap_based_2d_xl_strategy>(path_prefix);
+        std::cout << "  reopened table is " << (okay ? "intact" : "CORRUPT") << std::endl;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+//  Multi-process read benchmark.  A table is built once in shared memory segments, and then
+//  several worker processes each map the segments (at their own addresses), walk the whole table
+//  and perform random lookups.  For comparison, the workers then each build a private copy of the
+//  same table and repeat the exercise.  Each worker reports the growth of its proportional set
+//  size (PSS), in which every shared page is charged 1/N to each of the N processes mapping it;
+//  the sum over all workers is therefore the real memory cost of the table.
+//--------------------------------------------------------------------------------------------------
+//
+struct shm_worker_result
+{
+    uintptr_t   m_base;
+    int64_t     m_pss_kb;
+    int64_t     m_lookup_ns;
+    size_t      m_found;
+};
+
+struct shm_worker_board
+{
+    pthread_barrier_t   m_attached;
+    pthread_barrier_t   m_measured;
+    shm_worker_result   m_results[64];
+};
+
+static int const    shm_key_count    = 50000;
+static int const    shm_lookup_count = 200000;
+
+static int64_t
+read_pss_kb()
+{
+    std::ifstream   ifs("/proc/self/smaps_rollup");
+    std::string     label;
+    int64_t         value;
+
+    while (ifs >> label)
+    {
+        if (label == "Pss:"  &&  (ifs >> value))
+        {
+            return value;
+        }
+    }
+    return 0;
+}
+
+template<typename AllocStrategy>
+static void
+shm_worker(mmap_table<AllocStrategy> const& table, int64_t pss_before,
+           shm_worker_board& board, shm_worker_result& result)
+{
+    char        key_str[128];
+    size_t      found = 0;
+    size_t      bytes = 0;
+
+    //- Touch every entry, so that the whole table is resident in (or charged to) this process.
+    //
+    for (auto const& entry : table.m_entries)
+    {
+        bytes += entry.first.size();
+        for (auto const& val : entry.second)
+        {
+            bytes += val.size();
+        }
+    }
+
+    stopwatch   sw;
+
+    for (int i = 0;  i < shm_lookup_count;  ++i)
+    {
+        sprintf(key_str, "this is key string #%08d", (int) ((i * 7919u) % shm_key_count));
+        found += (table.find(key_str) != nullptr) ? 1 : 0;
+    }
+    sw.stop();
+
+    //- Measure only while every worker has the table mapped, since PSS divides shared pages
+    //  among the processes mapping them at the moment it is read.
+    //
+    pthread_barrier_wait(&board.m_attached);
+    result.m_pss_kb    = read_pss_kb() - pss_before;
+    result.m_lookup_ns = sw.elapsed_nsec() / shm_lookup_count;
+    result.m_found     = found + (bytes == 0);
+    pthread_barrier_wait(&board.m_measured);
+}
+
+//- Stands in for shm_worker() in a worker that could not get at the table.  The worker still
+//  arrives at both barriers, so that the others are not left waiting for it.
+//
+static void
+shm_worker_failed(shm_worker_board& board, shm_worker_result& result)
+{
+    result = shm_worker_result{0, 0, 0, 0};
+    pthread_barrier_wait(&board.m_attached);
+    pthread_barrier_wait(&board.m_measured);
+}
+
+static void
+report_shm_workers(char const* title, shm_worker_board const& board, int num_procs)
+{
+    int64_t     total_kb = 0;
+
+    std::cout << title << std::endl;
+    for (int i = 0;  i < num_procs;  ++i)
+    {
+        shm_worker_result const&    r = board.m_results[i];
+
+        std::cout << "  worker " << std::setw(2) << i << ": table at 0x" << std::hex << r.m_base
+                  << std::dec << "  PSS +" << std::setw(7) << r.m_pss_kb << " KB"
+                  << "  lookup " << std::setw(5) << r.m_lookup_ns << " ns"
+                  << "  found " << r.m_found << std::endl;
+        total_kb += r.m_pss_kb;
+    }
+    std::cout << "  total PSS growth: " << total_kb << " KB" << std::endl << std::endl;
+}
+
+//- Forks `num_procs` workers that each run `work(index)`, and waits for all of them.
+//
+template<class FN>
+static void
+run_shm_workers(int num_procs, FN work)
+{
+    std::vector<pid_t>  pids;
+
+    for (int i = 0;  i < num_procs;  ++i)
+    {
+        pid_t   pid = fork();
+
+        if (pid == 0)
+        {
+            work(i);
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+    for (pid_t pid : pids)
+    {
+        if (pid > 0)
+        {
+            waitpid(pid, nullptr, 0);
+        }
+    }
+}
+
+void
+test_shm_ops(char const* name_prefix, int num_procs)
+{
+    using shared_strategy  = shm_based_2d_xl_strategy;
+    using shared_model     = shared_strategy::storage_model;
+    using shared_table     = mmap_table<shared_strategy>;
+    using private_strategy = mmap_based_2d_xl_strategy;
+    using private_model    = private_strategy::storage_model;
+    using private_table    = mmap_table<private_strategy>;
+
+    num_procs = std::max(1, std::min(num_procs, 64));
+
+    //- The board lives in anonymous shared memory, so that it is visible to every worker.
+    //
+    void*   pboard = mmap(nullptr, sizeof(shm_worker_board), PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (pboard == MAP_FAILED)
+    {
+        std::cout << "unable to map the worker board" << std::endl;
+        return;
+    }
+
+    shm_worker_board&       board = *static_cast<shm_worker_board*>(pboard);
+    pthread_barrierattr_t   attr;
+
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+
+    std::cout << "***********************" << std::endl;
+    std::cout << "*****  TEST SHM  ******" << std::endl;
+    std::cout << "processes: " << num_procs << ",  keys: " << shm_key_count
+              << ",  lookups per process: " << shm_lookup_count << std::endl;
+
+    //- Build the table once, in shared memory.
+    //
+    shared_model::unlink_segments(name_prefix);
+    if (!shared_model::create_segments(name_prefix))
+    {
+        std::cout << "unable to create shared memory segments " << name_prefix << std::endl;
+        munmap(pboard, sizeof(shm_worker_board));
+        return;
+    }
+
+    stopwatch   sw;
+
+    shared_strategy::set_position(shared_model::first_segment_index(), shared_model::header_size);
+
+    auto    sptable = allocate<shared_table, shared_strategy>();
+
+    sptable->add_entries(0, shm_key_count, mmap_value_count);
+    root_directory<shared_strategy>::bind("shm_table", sptable);
+    sw.stop();
+    shared_model::close_segments();
+    std::cout << "built shared table in " << sw.elapsed_msec() << " msec" << std::endl << std::endl;
+
+    //- Shared: each worker maps the segments by name, wherever its kernel chooses.
+    //
+    pthread_barrier_init(&board.m_attached, &attr, (unsigned) num_procs);
+    pthread_barrier_init(&board.m_measured, &attr, (unsigned) num_procs);
+
+    run_shm_workers(num_procs, [&](int i)
+    {
+        int64_t     pss_before = read_pss_kb();
+
+        //- Forked workers have identical address space layouts; reserve a different amount of
+        //  address space in each one so that the segments land at different addresses.
+        //
+        mmap(nullptr, (i + 1) * 0x100000u, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        shared_table const*     ptable = nullptr;
+
+        if (shared_model::open_segments(name_prefix))
+        {
+            ptable = static_cast<shared_table const*>(root_directory<shared_strategy>::find<shared_table>("shm_table"));
+        }
+        if (ptable == nullptr)
+        {
+            std::cout << "  worker " << i << ": unable to attach the shared table " << name_prefix << std::endl;
+            shm_worker_failed(board, board.m_results[i]);
+            return;
+        }
+        board.m_results[i].m_base = (uintptr_t) shared_model::segment_address(shared_model::first_segment_index());
+        shm_worker(*ptable, pss_before, board, board.m_results[i]);
+    });
+    report_shm_workers("one shared copy:", board, num_procs);
+
+    pthread_barrier_destroy(&board.m_attached);
+    pthread_barrier_destroy(&board.m_measured);
+
+    //- Private: each worker builds its own copy in anonymous segments.
+    //
+    pthread_barrier_init(&board.m_attached, &attr, (unsigned) num_procs);
+    pthread_barrier_init(&board.m_measured, &attr, (unsigned) num_procs);
+
+    run_shm_workers(num_procs, [&](int i)
+    {
+        int64_t     pss_before = read_pss_kb();
+
+        private_model::init_segments();
+
+        char*   pbase  = private_model::segment_address(private_model::first_segment_index());
+        auto    sptable = allocate<private_table, private_strategy>();
+
+        sptable->add_entries(0, shm_key_count, mmap_value_count);
+        board.m_results[i].m_base = (uintptr_t) pbase;
+        shm_worker(*sptable, pss_before, board, board.m_results[i]);
+    });
+    report_shm_workers("per-process copies:", board, num_procs);
+
+    pthread_barrier_destroy(&board.m_attached);
+    pthread_barrier_destroy(&board.m_measured);
+    pthread_barrierattr_destroy(&attr);
+
+    shared_model::unlink_segments(name_prefix);
+    munmap(pboard, sizeof(shm_worker_board));
+}
@@ -0,0 +1,206 @@
+//==================================================================================================
+//  File:   pin_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <algorithm>
+#include <random>
+
+#include "segment_pin.h"
+#include "rb_tree.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Segment pin tests.  Node-based structures are traversed with synthetic pointers resolved in
+//  the usual way, and again with the same pointers resolved through a segment_pin.  Each node
+//  hop depends on the previous one, so these loops cannot be unwrapped into native ranges the
+//  way copies and sorts can.  The structures are a doubly-linked list whose links visit the
+//  nodes in random order (each node's value is read and then incremented in place, so that the
+//  loop also stores through resolved pointers), and an insert-only red-black tree (searched for
+//  every key).  Both are small enough to stay in cache, so that the cost of resolving pointers
+//  is not hidden behind the cost of cache misses.  Wrapper pointers are the native baseline.
+//--------------------------------------------------------------------------------------------------
+//
+static size_t const     pin_list_count = 16384;
+static size_t const     pin_tree_count = 8192;
+static size_t const     pin_repeats    = 500;
+
+template<class AS>
+struct pin_list_node
+{
+    using node_ptr = typename AS::template rebind_pointer<pin_list_node>;
+
+    node_ptr    m_next;
+    node_ptr    m_prev;
+    uint64_t    m_value;
+};
+
+//- Resolves a synthetic pointer either directly, or through a pin.
+//
+template<bool Pinned, class T, class AM, class PIN>
+inline T*
+resolve(syn_ptr<T, AM> const& p, PIN const& pin)
+{
+    if constexpr (Pinned)
+        return to_address(p, pin);
+    else
+        return to_address(p);
+}
+
+template<class AS, bool Pinned>
+int64_t
+time_list_walk(typename pin_list_node<AS>::node_ptr head, uint64_t& sum)
+{
+    using node_type = pin_list_node<AS>;
+
+    segment_pin<typename AS::storage_model>     pin;
+    stopwatch   sw;
+
+    sw.start();
+    for (size_t i = 0;  i < pin_repeats;  ++i)
+    {
+        for (node_type* n = resolve<Pinned>(head, pin);  n != nullptr;  n = resolve<Pinned>(n->m_next, pin))
+        {
+            sum        += n->m_value;
+            n->m_value += 1;
+        }
+    }
+    sw.stop();
+    return sw.elapsed_msec();
+}
+
+template<class AS, bool Pinned>
+int64_t
+time_tree_search(typename colored_rb_node<AS>::node_ptr root, std::vector<uint64_t> const& keys,
+                 size_t& found)
+{
+    using node_type = colored_rb_node<AS>;
+
+    segment_pin<typename AS::storage_model>     pin;
+    stopwatch   sw;
+
+    sw.start();
+    for (size_t i = 0;  i < pin_repeats;  ++i)
+    {
+        for (uint64_t key : keys)
+        {
+            node_type const*    x = resolve<Pinned>(root, pin);
+
+            while (x != nullptr  &&  x->m_key != key)
+            {
+                x = resolve<Pinned>((key < x->m_key) ? x->m_left : x->m_right, pin);
+            }
+            found += (x != nullptr) ? 1 : 0;
+        }
+    }
+    sw.stop();
+    return sw.elapsed_msec();
+}
+
+//------
+//
+template<class AS, bool CanPin>
+void
+do_pin_test(char const* name, std::vector<size_t> const& order, std::vector<uint64_t> const& keys)
+{
+    using list_node = pin_list_node<AS>;
+    using list_ptr  = typename list_node::node_ptr;
+    using tree_node = colored_rb_node<AS>;
+    using tree_ptr  = typename tree_node::node_ptr;
+
+    std::vector<list_ptr>   nodes;
+    AS          heap;
+    uint64_t    sum_plain  = 0;
+    uint64_t    sum_pinned = 0;
+    size_t      found      = 0;
+
+    heap.reset_segments();
+    nodes.reserve(order.size());
+
+    for (size_t i = 0;  i < order.size();  ++i)
+    {
+        list_ptr    n = static_cast<list_ptr>(heap.allocate(sizeof(list_node)));
+
+        ::new (static_cast<list_node*>(n)) list_node();
+        n->m_value = i;
+        nodes.push_back(n);
+    }
+    for (size_t i = 1;  i < order.size();  ++i)
+    {
+        nodes[order[i - 1]]->m_next = nodes[order[i]];
+        nodes[order[i]]->m_prev     = nodes[order[i - 1]];
+    }
+
+    rb_tree<tree_node>  tree;
+
+    for (uint64_t key : keys)
+    {
+        tree_ptr    n = static_cast<tree_ptr>(heap.allocate(sizeof(tree_node)));
+
+        ::new (static_cast<tree_node*>(n)) tree_node();
+        n->m_key = key;
+        tree.insert(n);
+    }
+
+    list_ptr    head = nodes[order.front()];
+    int64_t     list_plain  = time_list_walk<AS, false>(head, sum_plain);
+    int64_t     tree_plain  = time_tree_search<AS, false>(tree.root(), keys, found);
+    int64_t     list_pinned = 0;
+    int64_t     tree_pinned = 0;
+
+    CHECK(found == keys.size() * pin_repeats);
+
+    std::cout << "  " << std::left << std::setw(16) << name << std::right
+              << "list walk: " << std::setw(4) << list_plain << " msec,  tree search: "
+              << std::setw(4) << tree_plain << " msec";
+
+    if constexpr (CanPin)
+    {
+        found       = 0;
+        list_pinned = time_list_walk<AS, true>(head, sum_pinned);
+        tree_pinned = time_tree_search<AS, true>(tree.root(), keys, found);
+
+        //- Each walk adds one to every value, so the pinned sums exceed the plain ones by a
+        //  known amount.
+        //
+        uint64_t const  n = order.size();
+
+        CHECK(found == keys.size() * pin_repeats);
+        CHECK(sum_pinned == sum_plain + n * pin_repeats * pin_repeats);
+
+        std::cout << std::endl << "  " << std::left << std::setw(16) << "  (pinned)" << std::right
+                  << "list walk: " << std::setw(4) << list_pinned << " msec,  tree search: "
+                  << std::setw(4) << tree_pinned << " msec";
+    }
+    std::cout << std::endl;
+
+    heap.reset_segments();
+}
+
+void
+test_pin_ops()
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "*** TEST SEGMENT PIN **" << std::endl;
+
+    std::mt19937_64         gen(4242);
+    std::vector<size_t>     order(pin_list_count);
+    std::vector<uint64_t>   keys(pin_tree_count);
+
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), gen);
+
+    for (auto& key : keys)
+    {
+        key = gen();
+    }
+
+    std::cout << pin_list_count << " list nodes, " << pin_tree_count << " tree keys, "
+              << pin_repeats << " passes" << std::endl;
+
+    do_pin_test<wrapper_strategy, false>("wrapper", order, keys);
+    do_pin_test<based_2d_xl_strategy, true>("based_2d_xl", order, keys);
+    do_pin_test<based_2d_sm_strategy, true>("based_2d_sm", order, keys);
+    do_pin_test<based_2d_msk_strategy, true>("based_2d_msk", order, keys);
+    std::cout << std::endl;
+}
@@ -294,6 +294,13 @@ run_pointer_cast_tests()
     not_conv(test_ptr_derived_const, test_ptr_derived);
     imp_conv(test_ptr_derived_const, test_ptr_derived_const);
 
+    static_assert(std::is_same<decltype(to_address(make_val<test_ptr_type>())), user*>::value,
+                  "to_address() must yield a native pointer");
+#if __cpp_lib_concepts
+    static_assert(std::contiguous_iterator<test_ptr_type>  &&  std::contiguous_iterator<test_ptr_type_const>,
+                  "synthetic pointers must model contiguous_iterator");
+#endif
+
     ++x;
 }
 
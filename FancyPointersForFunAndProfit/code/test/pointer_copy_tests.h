@@ -85,10 +85,11 @@ test_copy(II src_begin, II src_end, OI dst_begin, OI dst_end)
 //      This function template measures the time it takes to copy elements from a source vector
 //      to a destination array.  It measures elapsed time twice: once for the case when the
 //      destination is accessed by native pointers, and once for the case when the destination
-//      is accessed with synthetic pointers.
+//      is accessed with synthetic pointers.  If Unwrap is true, the synthetic destination range
+//      is resolved to native pointers with to_span() before each copy.
 //--------------------------------------------------------------------------------------------------
 //
-template<typename AllocStrategy, typename DataType>
+template<typename AllocStrategy, typename DataType, bool Unwrap = false>
 timing_pair
 do_pointer_copy_test(size_t nelem, size_t nreps)
 {
@@ -147,7 +148,8 @@ do_pointer_copy_test(size_t nelem, size_t nreps)
         sw.start();
         for (size_t i = 0;  i < nreps;  ++i)
         {
-            test_copy(std::cbegin(random_data), std::cend(random_data), psyn_begin, psyn_end);
+            auto    dst = unwrap_range<Unwrap>(psyn_begin, psyn_end);
+            test_copy(std::cbegin(random_data), std::cend(random_data), dst.first, dst.second);
         }
         sw.stop();
         el_syn = sw.elapsed_nsec();
@@ -162,7 +164,8 @@ do_pointer_copy_test(size_t nelem, size_t nreps)
         sw.start();
         for (size_t i = 0;  i < nreps;  ++i)
         {
-            test_copy(std::cbegin(random_data), std::cend(random_data), psyn_begin, psyn_end);
+            auto    dst = unwrap_range<Unwrap>(psyn_begin, psyn_end);
+            test_copy(std::cbegin(random_data), std::cend(random_data), dst.first, dst.second);
         }
         sw.stop();
         el_syn = sw.elapsed_nsec();
@@ -200,7 +203,7 @@ do_pointer_copy_test(size_t nelem, size_t nreps)
 //      times, accumulating the timings, and reporting the results.
 //--------------------------------------------------------------------------------------------------
 //
-template<typename AllocStrategy, typename DataType>
+template<typename AllocStrategy, typename DataType, bool Unwrap = false>
 std::tuple<std::string, std::vector<size_t>, std::vector<double>>
 run_pointer_copy_tests(char const* stype, char const* dtype)
 {
@@ -212,7 +215,7 @@ run_pointer_copy_tests(char const* stype, char const* dtype)
     std::vector<size_t> counts;
     std::vector<double> ratios;
 
-    name.assign("copy/").append(stype).append("/").append(dtype);
+    name.assign(Unwrap ? "copy/unwrapped/" : "copy/").append(stype).append("/").append(dtype);
 
     //- Time the copy operation for variously-sized arrays.
     //
@@ -225,7 +228,7 @@ run_pointer_copy_tests(char const* stype, char const* dtype)
 
         for (size_t j = 0;  j < stat_repeats;  ++j)
         {
-            timing = do_pointer_copy_test<AllocStrategy, DataType>(nelem, run_reps);
+            timing = do_pointer_copy_test<AllocStrategy, DataType, Unwrap>(nelem, run_reps);
             timings.push_back(timing);
         }
 
@@ -271,4 +274,147 @@ run_pointer_copy_tests(char const* stype, char const* dtype)
     return {tname, counts, ratios};
 }
 
+//--------------------------------------------------------------------------------------------------
+//  Function:
+//      do_pointer_assign_test<AS,DT>
+//
+//  Summary:
+//      This function template measures the time it takes to copy an array of native pointers to
+//      an array of pointers.  It measures elapsed time twice: once for the case when the
+//      destination holds native pointers, and once for the case when the destination holds
+//      synthetic pointers, so that every element copied is converted by assign_from().  The
+//      pointed-to objects are placed in the last segment, which is the worst case for an
+//      addressing model that searches the segment table.
+//--------------------------------------------------------------------------------------------------
+//
+template<typename AllocStrategy, typename DataType>
+timing_pair
+do_pointer_assign_test(size_t nelem, size_t nreps)
+{
+    using storage_model = typename AllocStrategy::storage_model;
+    using syn_ptr_data  = typename AllocStrategy::template rebind_pointer<DataType>;
+    using syn_ptr_ptr   = typename AllocStrategy::template rebind_pointer<syn_ptr_data>;
+
+    AllocStrategy   heap;
+
+    //- Allocate the objects to be pointed to in the last segment, and the array of synthetic
+    //  pointers wherever the strategy puts it after that.
+    //
+    AllocStrategy::set_position(storage_model::last_segment_index(), 64);
+
+    syn_ptr_data    pobj_begin = static_cast<syn_ptr_data>(heap.allocate(nelem*sizeof(DataType)));
+    syn_ptr_ptr     psyn_begin = static_cast<syn_ptr_ptr>(heap.allocate(nelem*sizeof(syn_ptr_data)));
+    syn_ptr_ptr     psyn_end   = psyn_begin + nelem;
+
+    std::uninitialized_fill(psyn_begin, psyn_end, syn_ptr_data());
+
+    std::vector<DataType*>  source(nelem);
+    std::vector<DataType*>  native(nelem);
+    DataType*               pobj = pobj_begin;
+
+    for (size_t i = 0;  i < nelem;  ++i)
+    {
+        source[i] = pobj + i;
+    }
+
+    stopwatch   sw;
+    int64_t     el_nat = 0;
+    int64_t     el_syn = 0;
+
+    test_copy(std::cbegin(source), std::cend(source), std::begin(native), std::end(native));
+
+    sw.start();
+    for (size_t i = 0;  i < nreps;  ++i)
+    {
+        test_copy(std::cbegin(source), std::cend(source), std::begin(native), std::end(native));
+    }
+    sw.stop();
+    el_nat = sw.elapsed_nsec();
+
+    sw.start();
+    for (size_t i = 0;  i < nreps;  ++i)
+    {
+        test_copy(std::cbegin(source), std::cend(source), psyn_begin, psyn_end);
+    }
+    sw.stop();
+    el_syn = sw.elapsed_nsec();
+
+    size_t  errors = 0;
+
+    for (size_t i = 0;  i < nelem;  ++i)
+    {
+        errors += (static_cast<DataType*>(psyn_begin[i]) != source[i]) ? 1 : 0;
+    }
+    CHECK(errors == 0);
+
+    heap.reset_segments();
+
+    return timing_pair{el_nat, el_syn};
+}
+
+//--------------------------------------------------------------------------------------------------
+//  Function:
+//      run_pointer_assign_tests<AS,DT>
+//
+//  Summary:
+//      This function template manages the process of calling do_pointer_assign_test() multiple
+//      times, accumulating the timings, and reporting the results.
+//--------------------------------------------------------------------------------------------------
+//
+template<typename AllocStrategy, typename DataType>
+std::tuple<std::string, std::vector<size_t>, std::vector<double>>
+run_pointer_assign_tests(char const* stype, char const* dtype)
+{
+    size_t const    stat_repeats = 16;      //- Times to repeat the test.
+    size_t const    stat_rejects = 6;       //- Measurements to drop; highest & lowest.
+
+    std::string         tname(stype);
+    std::string         name;
+    std::vector<size_t> counts;
+    std::vector<double> ratios;
+
+    name.assign("assign/").append(stype).append("/").append(dtype);
+
+    for (size_t i = 0;  i < max_element_index();  ++i)
+    {
+        size_t          nelem    = elem_counts[i];
+        size_t          run_reps = std::max((size_t)1, (size_t)(10'000'000/nelem));
+        timing_vector   timings;
+
+        for (size_t j = 0;  j < stat_repeats;  ++j)
+        {
+            timings.push_back(do_pointer_assign_test<AllocStrategy, DataType>(nelem, run_reps));
+        }
+
+        //- Sort the timings vector so we can reject highest/lowest timings, and compute the
+        //  synthetic-to-natural ratio from the rest.
+        //
+        sort(begin(timings), end(timings));
+
+        int64_t     el_nat_total = 0;
+        int64_t     el_syn_total = 0;
+
+        for (size_t j = (stat_rejects/2);  j < (timings.size() - stat_rejects);  ++j)
+        {
+            el_nat_total += timings[j].m_el_nat;
+            el_syn_total += timings[j].m_el_syn;
+        }
+
+        double      ratio = (double) el_syn_total / (double) el_nat_total;
+
+        counts.push_back(nelem);
+        ratios.push_back(ratio);
+
+        std::printf("%s, %7.5f, %zu\n", name.c_str(), ratio, nelem);
+        fflush(stdout);
+    }
+    std::printf("\n");
+
+    if (size_t pos = tname.find("_strategy");  pos < tname.size())
+    {
+        tname.erase(pos);
+    }
+    return {tname, counts, ratios};
+}
+
 #endif  //-  POINTER_COPY_TESTS_H_DEFINED
@@ -18,10 +18,11 @@
 //      This function template measures the time it takes to sort elements in an array.  It
 //      measures elapsed time twice: once for the case when the destination is accessed with
 //      native pointers, and once for the case when the destination is accessed with synthetic
-//      pointers.
+//      pointers.  If Unwrap is true, the synthetic range is resolved to native pointers with
+//      to_span() before it is sorted.
 //--------------------------------------------------------------------------------------------------
 //
-template<typename AllocStrategy, typename DataType>
+template<typename AllocStrategy, typename DataType, bool Unwrap = false>
 timing_pair
 do_pointer_sort_test(size_t nelem)
 {
@@ -95,7 +96,8 @@ do_pointer_sort_test(size_t nelem)
         //- Sort the buffer using synthetic pointers as iterators.
         //
         sw.start();
-        std::sort(psyn_begin, psyn_end);
+        auto    range = unwrap_range<Unwrap>(psyn_begin, psyn_end);
+        std::sort(range.first, range.second);
         sw.stop();
         el_syn = sw.elapsed_nsec();
 
@@ -120,7 +122,8 @@ do_pointer_sort_test(size_t nelem)
         //- Sort the buffer using synthetic pointers as iterators.
         //
         sw.start();
-        std::sort(psyn_begin, psyn_end);
+        auto    range = unwrap_range<Unwrap>(psyn_begin, psyn_end);
+        std::sort(range.first, range.second);
         sw.stop();
         el_syn = sw.elapsed_nsec();
 
@@ -166,7 +169,7 @@ do_pointer_sort_test(size_t nelem)
 //      times, accumulating the timings, and reporting the results.
 //--------------------------------------------------------------------------------------------------
 //
-template<typename AllocStrategy, typename DataType>
+template<typename AllocStrategy, typename DataType, bool Unwrap = false>
 std::tuple<std::string, std::vector<size_t>, std::vector<double>>
 run_pointer_sort_tests(char const* stype, char const* dtype)
 {
@@ -182,7 +185,7 @@ run_pointer_sort_tests(char const* stype, char const* dtype)
     std::vector<size_t> counts;
     std::vector<double> ratios;
 
-    name.assign("sort/").append(stype).append("/").append(dtype);
+    name.assign(Unwrap ? "sort/unwrapped/" : "sort/").append(stype).append("/").append(dtype);
 
     //- Time the sort operation for variously-sized arrays.
     //
@@ -195,7 +198,7 @@ run_pointer_sort_tests(char const* stype, char const* dtype)
 
         for (size_t j = 0;  j < sreps;  ++j)
         {
-            timing = do_pointer_sort_test<AllocStrategy, DataType>(nelem);
+            timing = do_pointer_sort_test<AllocStrategy, DataType, Unwrap>(nelem);
             timings.push_back(timing);
         }
 
@@ -9,8 +9,11 @@
 #include "pointer_copy_tests.h"
 #include "pointer_sort_tests.h"
 
-#define RUN_COPY_TESTS(ST, DT)          run_pointer_copy_tests<ST,DT>(#ST, #DT)
-#define RUN_SORT_TESTS(ST, DT)          run_pointer_sort_tests<ST,DT>(#ST, #DT)
+#define RUN_COPY_TESTS(ST, DT)              run_pointer_copy_tests<ST,DT>(#ST, #DT)
+#define RUN_ASSIGN_TESTS(ST, DT)            run_pointer_assign_tests<ST,DT>(#ST, #DT)
+#define RUN_SORT_TESTS(ST, DT)              run_pointer_sort_tests<ST,DT>(#ST, #DT)
+#define RUN_UNWRAPPED_COPY_TESTS(ST, DT)    run_pointer_copy_tests<ST,DT,true>(#ST, #DT)
+#define RUN_UNWRAPPED_SORT_TESTS(ST, DT)    run_pointer_sort_tests<ST,DT,true>(#ST, #DT)
 
 using name_list   = std::vector<std::string>;
 using counts_list = std::vector<size_t>;
@@ -60,6 +63,7 @@ run_pointer_tests(bool do_copy_tests, bool do_sort_tests)
     run_pointer_cast_tests<based_2d_xl_strategy>();
     run_pointer_cast_tests<based_2d_msk_strategy>();
     run_pointer_cast_tests<offset_strategy>();
+    run_pointer_cast_tests<tagged_strategy>();
 
     if (do_copy_tests)
     {
@@ -91,6 +95,34 @@ run_pointer_tests(bool do_copy_tests, bool do_sort_tests)
         printf("tabular summary for copy() with uint64_t:\n");
         print_tabular_summary(test_names, counts, test_ratios);
 
+        //- for uint64_t, with the synthetic ranges unwrapped by to_span()
+        //
+        test_names.clear();
+        test_ratios.clear();
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_COPY_TESTS(wrapper_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_COPY_TESTS(based_2d_xl_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_COPY_TESTS(based_2d_sm_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_COPY_TESTS(based_2d_msk_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_COPY_TESTS(offset_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        printf("tabular summary for unwrapped copy() with uint64_t:\n");
+        print_tabular_summary(test_names, counts, test_ratios);
+
         //- for test_struct
         //
         test_names.clear();
@@ -118,6 +150,34 @@ run_pointer_tests(bool do_copy_tests, bool do_sort_tests)
 
         printf("tabular summary for copy() with test_struct:\n");
         print_tabular_summary(test_names, counts, test_ratios);
+
+        //- for pointers to uint64_t
+        //
+        test_names.clear();
+        test_ratios.clear();
+
+        std::tie(name, counts, ratios) = RUN_ASSIGN_TESTS(wrapper_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_ASSIGN_TESTS(based_2d_xl_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_ASSIGN_TESTS(based_2d_sm_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_ASSIGN_TESTS(based_2d_msk_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_ASSIGN_TESTS(offset_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        printf("tabular summary for copy() of pointers to uint64_t:\n");
+        print_tabular_summary(test_names, counts, test_ratios);
     }
 
     if (do_sort_tests)
@@ -150,6 +210,34 @@ run_pointer_tests(bool do_copy_tests, bool do_sort_tests)
         printf("tabular summary for sort() with uint64_t:\n");
         print_tabular_summary(test_names, counts, test_ratios);
 
+        //- for uint64_t, with the synthetic ranges unwrapped by to_span()
+        //
+        test_names.clear();
+        test_ratios.clear();
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_SORT_TESTS(wrapper_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_SORT_TESTS(based_2d_xl_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_SORT_TESTS(based_2d_sm_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_SORT_TESTS(based_2d_msk_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        std::tie(name, counts, ratios) = RUN_UNWRAPPED_SORT_TESTS(offset_strategy, uint64_t);
+        test_names.push_back(std::move(name));
+        test_ratios.push_back(std::move(ratios));
+
+        printf("tabular summary for unwrapped sort() with uint64_t:\n");
+        print_tabular_summary(test_names, counts, test_ratios);
+
         //- for test_struct
         //
         test_names.clear();
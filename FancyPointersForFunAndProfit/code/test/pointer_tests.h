@@ -25,4 +25,23 @@ max_element_index()
     return std::min(array_size(elem_counts), max_ptr_op_count_index());
 }
 
+//- Returns a synthetic range unchanged, or when Unwrap is true, resolved to a range of native
+//  pointers by to_span().  The copy and sort tests use this to time the same algorithm over a
+//  synthetic range both as is and unwrapped.
+//
+template<bool Unwrap, typename PT>
+inline auto
+unwrap_range(PT first, PT last)
+{
+    if constexpr (Unwrap)
+    {
+        auto    span = to_span(first, last);
+        return std::make_pair(span.begin(), span.end());
+    }
+    else
+    {
+        return std::make_pair(first, last);
+    }
+}
+
 #endif  //- POINTER_TESTS_H_DEFINED
@@ -0,0 +1,270 @@
+//==================================================================================================
+//  File:   rb_tree.h
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#ifndef RB_TREE_H_DEFINED
+#define RB_TREE_H_DEFINED
+
+#include "container_tests.h"
+
+//--------------------------------------------------------------------------------------------------
+//  An insert-only red-black tree whose nodes are linked by synthetic pointers, shared by the node
+//  layout benchmarks.  A node type NT provides the members m_left, m_right, and m_key, and static
+//  functions that get and set the node's color and parent, so that the color may be stored either
+//  in a field of its own or in the bits of a pointer.
+//--------------------------------------------------------------------------------------------------
+//
+//- Returns the number of bytes allocated by strategy AS since its segments were last reset.
+//
+template<class AS>
+size_t
+segment_bytes_used()
+{
+    using storage_model = typename AS::storage_model;
+
+    size_t  segment, offset;
+
+    AS::get_position(segment, offset);
+    return (segment - storage_model::first_segment_index()) * storage_model::max_segment_size() + offset;
+}
+
+//------
+//- A node layout with the color in a field of its own, placed after the pointers so that it
+//  shares their padding when the pointers are narrower than the key.
+//
+template<class AS>
+struct colored_rb_node
+{
+    using node_ptr = typename AS::template rebind_pointer<colored_rb_node>;
+
+    node_ptr    m_left;
+    node_ptr    m_right;
+    node_ptr    m_parent;
+    bool        m_red;
+    uint64_t    m_key;
+
+    static  bool        is_red(node_ptr n)              { return n  &&  n->m_red; }
+    static  void        set_red(node_ptr n, bool red)   { n->m_red = red; }
+    static  node_ptr    parent(node_ptr n)              { return n->m_parent; }
+    static  void        set_parent(node_ptr n, node_ptr p)  { n->m_parent = p; }
+};
+
+//------
+//- An insert-only red-black tree, after Cormen et al.
+//
+template<class NT>
+class rb_tree
+{
+  public:
+    using node_ptr = typename NT::node_ptr;
+
+    void        insert(node_ptr z);
+    bool        contains(uint64_t key) const;
+    node_ptr    root() const;
+    size_t      verify() const;
+
+  private:
+    node_ptr    m_root = nullptr;
+
+    void    insert_fixup(node_ptr z);
+    void    rotate_left(node_ptr x);
+    void    rotate_right(node_ptr x);
+    size_t  verify(node_ptr n, node_ptr parent, size_t& errors) const;
+};
+
+template<class NT>
+void
+rb_tree<NT>::insert(node_ptr z)
+{
+    node_ptr    y = nullptr;
+    node_ptr    x = m_root;
+
+    while (x)
+    {
+        y = x;
+        x = (z->m_key < x->m_key) ? x->m_left : x->m_right;
+    }
+
+    z->m_left  = nullptr;
+    z->m_right = nullptr;
+    NT::set_parent(z, y);
+    NT::set_red(z, true);
+
+    if (!y)
+        m_root = z;
+    else if (z->m_key < y->m_key)
+        y->m_left = z;
+    else
+        y->m_right = z;
+
+    insert_fixup(z);
+}
+
+template<class NT>
+void
+rb_tree<NT>::insert_fixup(node_ptr z)
+{
+    while (NT::is_red(NT::parent(z)))
+    {
+        node_ptr    p = NT::parent(z);
+        node_ptr    g = NT::parent(p);
+
+        if (p == g->m_left)
+        {
+            node_ptr    u = g->m_right;
+
+            if (NT::is_red(u))
+            {
+                NT::set_red(p, false);
+                NT::set_red(u, false);
+                NT::set_red(g, true);
+                z = g;
+            }
+            else
+            {
+                if (z == p->m_right)
+                {
+                    z = p;
+                    rotate_left(z);
+                    p = NT::parent(z);
+                }
+                NT::set_red(p, false);
+                NT::set_red(g, true);
+                rotate_right(g);
+            }
+        }
+        else
+        {
+            node_ptr    u = g->m_left;
+
+            if (NT::is_red(u))
+            {
+                NT::set_red(p, false);
+                NT::set_red(u, false);
+                NT::set_red(g, true);
+                z = g;
+            }
+            else
+            {
+                if (z == p->m_left)
+                {
+                    z = p;
+                    rotate_right(z);
+                    p = NT::parent(z);
+                }
+                NT::set_red(p, false);
+                NT::set_red(g, true);
+                rotate_left(g);
+            }
+        }
+    }
+    NT::set_red(m_root, false);
+}
+
+template<class NT>
+void
+rb_tree<NT>::rotate_left(node_ptr x)
+{
+    node_ptr    y  = x->m_right;
+    node_ptr    xp = NT::parent(x);
+
+    x->m_right = y->m_left;
+    if (y->m_left)
+    {
+        NT::set_parent(y->m_left, x);
+    }
+    NT::set_parent(y, xp);
+
+    if (!xp)
+        m_root = y;
+    else if (x == xp->m_left)
+        xp->m_left = y;
+    else
+        xp->m_right = y;
+
+    y->m_left = x;
+    NT::set_parent(x, y);
+}
+
+template<class NT>
+void
+rb_tree<NT>::rotate_right(node_ptr x)
+{
+    node_ptr    y  = x->m_left;
+    node_ptr    xp = NT::parent(x);
+
+    x->m_left = y->m_right;
+    if (y->m_right)
+    {
+        NT::set_parent(y->m_right, x);
+    }
+    NT::set_parent(y, xp);
+
+    if (!xp)
+        m_root = y;
+    else if (x == xp->m_right)
+        xp->m_right = y;
+    else
+        xp->m_left = y;
+
+    y->m_right = x;
+    NT::set_parent(x, y);
+}
+
+template<class NT>
+bool
+rb_tree<NT>::contains(uint64_t key) const
+{
+    node_ptr    x = m_root;
+
+    while (x  &&  x->m_key != key)
+    {
+        x = (key < x->m_key) ? x->m_left : x->m_right;
+    }
+    return (bool) x;
+}
+
+template<class NT> inline
+typename rb_tree<NT>::node_ptr
+rb_tree<NT>::root() const
+{
+    return m_root;
+}
+
+//- Checks ordering, parent links, the red-red rule, and equal black heights; returns the
+//  number of violations found.
+//
+template<class NT>
+size_t
+rb_tree<NT>::verify() const
+{
+    size_t  errors = 0;
+
+    verify(m_root, nullptr, errors);
+    return errors + (NT::is_red(m_root) ? 1 : 0);
+}
+
+template<class NT>
+size_t
+rb_tree<NT>::verify(node_ptr n, node_ptr parent, size_t& errors) const
+{
+    if (!n)
+    {
+        return 1;
+    }
+
+    errors += (NT::parent(n) != parent) ? 1 : 0;
+    errors += (NT::is_red(n)  &&  (NT::is_red(n->m_left) || NT::is_red(n->m_right))) ? 1 : 0;
+    errors += (n->m_left   &&  !(n->m_left->m_key < n->m_key)) ? 1 : 0;
+    errors += (n->m_right  &&  (n->m_right->m_key < n->m_key)) ? 1 : 0;
+
+    size_t  lh = verify(n->m_left, n, errors);
+    size_t  rh = verify(n->m_right, n, errors);
+
+    errors += (lh != rh) ? 1 : 0;
+    return lh + (NT::is_red(n) ? 0 : 1);
+}
+
+#endif  //- RB_TREE_H_DEFINED
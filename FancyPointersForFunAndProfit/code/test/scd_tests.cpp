@@ -199,7 +199,15 @@ template class scd_allocator<std::string, 8192>;
 //      scd_message
 //
 //  Summary:
-//      This class template implements a self-contained heap and message.
+//      This class template implements a self-contained heap and message.  Every pointer in the
+//      message is an offset pointer to somewhere else in the message, so a byte-wise copy of
+//      the message is a complete, independent message.
+//
+//      The map is a std::vector of (key, values) pairs, kept sorted by key, rather than a
+//      std::map of std::lists, because the node-based containers in libstdc++ link their nodes
+//      (and their header nodes, which are inside the container objects) with ordinary pointers.
+//      A copy of such a map still points into the original, and walking it runs off the end of
+//      the original's storage.  std::vector stores only its allocator's pointer type.
 //--------------------------------------------------------------------------------------------------
 //
 template<size_t N>
@@ -211,12 +219,11 @@ class scd_message
     using syn_string       = simple_string<syn_string_alloc>;
 
     using syn_list_alloc   = scd_allocator<syn_string, N>;
-    using syn_list         = std::list<syn_string, syn_list_alloc>;
+    using syn_list         = std::vector<syn_string, syn_list_alloc>;
 
-    using syn_less         = std::less<syn_string>;
-    using syn_pair         = std::pair<syn_string const, syn_list>;
+    using syn_pair         = std::pair<syn_string, syn_list>;
     using syn_map_alloc    = scd_allocator<syn_pair, N>;
-    using syn_map          = std::map<syn_string, syn_list, syn_less, syn_map_alloc>;
+    using syn_map          = std::vector<syn_pair, syn_map_alloc>;
 
   public:
     scd_message();
@@ -226,6 +233,7 @@ class scd_message
 
     void            add_data(int key_start, int val_start, int count);
     void            print_values() const;
+    std::string     values() const;
 
   private:
     heap_type   m_heap;
@@ -265,20 +273,33 @@ scd_message<N>::add_data(int key_start, int val_start, int count)
     syn_list_alloc      list_alloc(&m_heap);
 
     syn_string  key_str(str_alloc);
-    syn_string  val_str(str_alloc);
     syn_list    val_list(list_alloc);
 
+    val_list.reserve(count);
     for (int i = val_start;  i < (val_start + count);  ++i)
     {
         sprintf(val_buf, "this is value string #%d", i+100);
-        val_str.assign(val_buf);
-        val_list.push_back(std::move(val_str));
+        val_list.emplace_back(val_buf, str_alloc);
     }
-    
+
     sprintf(key_buf, "this is key string #%d", key_start);
     key_str.assign(key_buf);
 
-    m_map.emplace(std::move(key_str), std::move(val_list));
+    auto    iter = std::lower_bound(m_map.begin(), m_map.end(), key_str,
+                                    [](syn_pair const& e, syn_string const& k)
+                                    { return e.first < k; });
+
+    if (iter != m_map.end()  &&  iter->first == key_str)
+    {
+        for (auto& val : val_list)
+        {
+            iter->second.push_back(std::move(val));
+        }
+    }
+    else
+    {
+        m_map.emplace(iter, std::move(key_str), std::move(val_list));
+    }
 }
 
 template<size_t N> void
@@ -295,12 +316,33 @@ scd_message<N>::print_values() const
             std::cout << "    " <<  val << "   0x" << std::hex << (uintptr_t) &val << std::endl;
         }
     }
-    std::cout << std::endl;
+    std::cout << std::dec << std::endl;
+}
+
+//- Returns the keys and values, without their addresses, for comparing messages.
+//
+template<size_t N> std::string
+scd_message<N>::values() const
+{
+    std::string     str;
+
+    for (auto const& elem : m_map)
+    {
+        str.append(elem.first.view()).append("\n");
+        for (auto const& val : elem.second)
+        {
+            str.append("    ").append(val.view()).append("\n");
+        }
+    }
+    return str;
 }
 
 void test_scd()
 {
-    scd_message<8192>   msg;
+    using message = scd_message<8192>;
+
+    auto        porig = std::make_unique<message>();
+    message&    msg   = *porig;
 
     for (int i = 0;  i < 3;  ++i)
     {
@@ -308,15 +350,27 @@ void test_scd()
     }
     msg.print_values();
 
-    char    bytes[sizeof(scd_message<8192>)];
-    memcpy(&bytes[0], &msg, sizeof(scd_message<8192>));
+    std::string const   expected = msg.values();
 
-    auto const*     pmsg = reinterpret_cast<scd_message<8192>*>(&bytes[0]);
+    CHECK(expected.find("this is key string #30\n    this is value string #700\n") != std::string::npos);
+
+    alignas(message) char   bytes[sizeof(message)];
+    memcpy(&bytes[0], &msg, sizeof(message));
+
+    auto const*     pmsg = reinterpret_cast<message*>(&bytes[0]);
     pmsg->print_values();
+    CHECK(pmsg->values() == expected);
 
-    std::vector<char>   vmsg(sizeof(scd_message<8192>));
-    memcpy(vmsg.data(), &msg, sizeof(scd_message<8192>));
+    std::vector<char>   vmsg(sizeof(message));
+    memcpy(vmsg.data(), &msg, sizeof(message));
 
-    auto const*     pmsg2 = reinterpret_cast<scd_message<8192>*>(vmsg.data());
+    auto const*     pmsg2 = reinterpret_cast<message*>(vmsg.data());
     pmsg2->print_values();
+    CHECK(pmsg2->values() == expected);
+
+    //- Each copy must stand alone, so free the original before reading them again.
+    //
+    porig.reset();
+    CHECK(pmsg->values() == expected);
+    CHECK(pmsg2->values() == expected);
 }
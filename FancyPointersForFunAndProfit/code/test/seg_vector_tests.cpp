@@ -0,0 +1,146 @@
+//==================================================================================================
+//  File:   seg_vector_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include "seg_vector.h"
+#include "rb_tree.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Segment vector tests.  For each allocation strategy, a std::vector with an rhx_allocator and
+//  a seg_vector, both constructed in the segments, are filled by appending, and the segment
+//  bytes used by each are reported; the monotonic strategy never reclaims the buffers that a
+//  std::vector outgrows.  The seg_vector is then read back, both by index and chunk by chunk,
+//  and checked again after the segments are relocated (for the strategies whose pointers may
+//  be held outside the segments).  A second pass fills two seg_vectors in alternation, so that
+//  neither can grow in place, to show that the fallback copies at most one chunk per append.
+//--------------------------------------------------------------------------------------------------
+//
+static size_t const     seg_vector_count = 4000000;
+
+template<class AS, class VT>
+VT*
+construct_vector_in_segments(AS& heap, typename AS::template rebind_pointer<VT>& pvec)
+{
+    pvec = static_cast<typename AS::template rebind_pointer<VT>>(heap.allocate(sizeof(VT)));
+    return ::new (static_cast<VT*>(pvec)) VT();
+}
+
+template<class VT>
+size_t
+check_seg_vector(VT const& vec, size_t count, uint64_t salt)
+{
+    size_t      errors = (vec.size() != count) ? 1 : 0;
+    uint64_t    next   = 0;
+
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        errors += (vec[i] != i * salt) ? 1 : 0;
+    }
+    vec.for_each_chunk([&](raw_span<uint64_t> chunk)
+    {
+        for (uint64_t value : chunk)
+        {
+            errors += (value != next * salt) ? 1 : 0;
+            ++next;
+        }
+    });
+    return errors + ((next != count) ? 1 : 0);
+}
+
+template<class AS>
+void
+do_seg_vector_test(char const* name, bool reloc)
+{
+    using std_vector = std::vector<uint64_t, rhx_allocator<uint64_t, AS>>;
+    using syn_vector = seg_vector<uint64_t, AS>;
+    using std_ptr    = typename AS::template rebind_pointer<std_vector>;
+    using syn_ptr    = typename AS::template rebind_pointer<syn_vector>;
+
+    AS          heap;
+    std_ptr     pstd;
+    syn_ptr     psyn;
+    syn_ptr     palt;
+    size_t      errors = 0;
+    stopwatch   sw;
+
+    heap.reset_segments();
+
+    std_vector& svec = *construct_vector_in_segments<AS, std_vector>(heap, pstd);
+    size_t      base = segment_bytes_used<AS>();
+
+    sw.start();
+    for (size_t i = 0;  i < seg_vector_count;  ++i)
+    {
+        svec.push_back(i);
+    }
+    sw.stop();
+    int64_t     std_msec  = sw.elapsed_msec();
+    size_t      std_bytes = segment_bytes_used<AS>() - base;
+
+    heap.reset_segments();
+
+    syn_vector& vec = *construct_vector_in_segments<AS, syn_vector>(heap, psyn);
+
+    base = segment_bytes_used<AS>();
+    sw.start();
+    for (size_t i = 0;  i < seg_vector_count;  ++i)
+    {
+        vec.push_back(i);
+    }
+    sw.stop();
+    int64_t     syn_msec  = sw.elapsed_msec();
+    size_t      syn_bytes = segment_bytes_used<AS>() - base;
+
+    //- Two vectors grown in alternation; each one's growth is blocked by the other's.
+    //
+    syn_vector& alt = *construct_vector_in_segments<AS, syn_vector>(heap, palt);
+
+    base = segment_bytes_used<AS>();
+    for (size_t i = 0;  i < seg_vector_count / 2;  ++i)
+    {
+        vec.push_back(seg_vector_count + i);
+        alt.push_back(i * 7);
+    }
+    size_t      alt_bytes = segment_bytes_used<AS>() - base;
+
+    for (size_t i = 0;  i < seg_vector_count / 2;  ++i)
+    {
+        vec.pop_back();
+    }
+    errors += check_seg_vector(vec, seg_vector_count, 1);
+    errors += check_seg_vector(alt, seg_vector_count / 2, 7);
+
+    if (reloc)
+    {
+        AS::swap_segments();
+    }
+    errors += check_seg_vector(*psyn, seg_vector_count, 1);
+    errors += check_seg_vector(*palt, seg_vector_count / 2, 7);
+    CHECK(errors == 0);
+
+    std::cout << "  " << std::left << std::setw(14) << name << std::right
+              << "std::vector: " << std::setw(6) << (std_bytes >> 10) << " KB, "
+              << std::setw(4) << std_msec << " msec;  seg_vector: " << std::setw(6)
+              << (syn_bytes >> 10) << " KB, " << std::setw(4) << syn_msec << " msec;  "
+              << "alternating: " << std::setw(6) << (alt_bytes >> 10) << " KB" << std::endl;
+
+    heap.reset_segments();
+}
+
+void
+test_seg_vector_ops()
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "*** TEST SEG VECTOR ***" << std::endl;
+    std::cout << seg_vector_count << " uint64_t elements appended" << std::endl;
+
+    do_seg_vector_test<wrapper_strategy>("wrapper", false);
+    do_seg_vector_test<offset_strategy>("offset", false);
+    do_seg_vector_test<based_2d_xl_strategy>("based_2d_xl", true);
+    do_seg_vector_test<based_2d_sm_strategy>("based_2d_sm", true);
+    do_seg_vector_test<based_2d_msk_strategy>("based_2d_msk", true);
+    do_seg_vector_test<compact_strategy>("compact", true);
+    std::cout << std::endl;
+}
@@ -0,0 +1,127 @@
+//==================================================================================================
+//  File:   segment_growth_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <fstream>
+#include <new>
+
+#include "container_tests.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Segment growth test.  The storage model is configured with a run-time segment count, and 1 MB
+//  chunks are then allocated (touching the first bytes of each) until the allocation strategy
+//  runs out of segments and throws std::bad_alloc, after which the segments are relocated once.
+//  Reported are the costs of initialization and relocation, the number of segments allocated on
+//  demand along the way, and the resident set size, which should track the memory actually
+//  touched rather than the memory reserved.
+//--------------------------------------------------------------------------------------------------
+//
+static size_t const     growth_chunk_size = 1u << 20;
+
+static int64_t
+read_rss_kb()
+{
+    std::ifstream   ifs("/proc/self/status");
+    std::string     label;
+    int64_t         value;
+
+    while (ifs >> label)
+    {
+        if (label == "VmRSS:"  &&  (ifs >> value))
+        {
+            return value;
+        }
+    }
+    return 0;
+}
+
+template<class AS>
+void
+do_segment_growth_test(char const* name, size_t segment_count)
+{
+    using storage_model = typename AS::storage_model;
+    using void_pointer  = typename AS::void_pointer;
+    using size_pointer  = typename AS::template rebind_pointer<size_t>;
+
+    std::vector<void_pointer>   chunks;
+    AS          alloc;
+    size_t      errors   = 0;
+    bool        bounded  = false;
+    int64_t     rss_base = read_rss_kb();
+    stopwatch   sw;
+
+    storage_model::clear_segments();
+    CHECK(storage_model::set_segment_count(segment_count));
+
+    sw.start();
+    storage_model::init_segments();
+    AS::reset_segments();
+    sw.stop();
+
+    int64_t     init_usec = sw.elapsed_usec();
+    int64_t     rss_init  = read_rss_kb();
+
+    sw.start();
+    try
+    {
+        for (;;)
+        {
+            void_pointer    vp = alloc.allocate(growth_chunk_size);
+
+            *static_cast<size_pointer>(vp) = chunks.size();
+            chunks.push_back(vp);
+        }
+    }
+    catch (std::bad_alloc const&)
+    {
+        bounded = true;
+    }
+    sw.stop();
+
+    int64_t     fill_msec = sw.elapsed_msec();
+    int64_t     rss_full  = read_rss_kb();
+
+    //- Relocate the segments; the shadow buffers needed to do so are created only now.
+    //
+    sw.start();
+    AS::swap_segments();
+    sw.stop();
+
+    int64_t     rss_swap = read_rss_kb();
+
+    //- Every chunk must still hold its own index when read back through its synthetic pointer.
+    //
+    for (size_t i = 0;  i < chunks.size();  ++i)
+    {
+        errors += (*static_cast<size_pointer>(chunks[i]) != i) ? 1 : 0;
+    }
+
+    size_t      segments_used = storage_model::top_segment_index() - storage_model::first_segment_index() + 1;
+
+    CHECK(bounded);
+    CHECK(errors == 0);
+    CHECK(segments_used == segment_count);
+
+    std::cout << "  " << name << std::endl
+              << "    init: " << init_usec << " usec, RSS +" << (rss_init - rss_base) << " KB" << std::endl
+              << "    fill: " << chunks.size() << " chunks in " << segments_used << " segments, "
+              << fill_msec << " msec, RSS +" << (rss_full - rss_base) << " KB" << std::endl
+              << "    swap: " << sw.elapsed_msec() << " msec, RSS +" << (rss_swap - rss_base) << " KB" << std::endl;
+
+    storage_model::clear_segments();
+    storage_model::set_segment_count(storage_model::default_segments);
+}
+
+void
+test_segment_growth_ops(size_t segment_count)
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "*** TEST SEG GROWTH ***" << std::endl;
+    std::cout << "segments: " << segment_count << " x " << (based_2d_msk_storage_model::max_segment_size() >> 20)
+              << " MB,  chunk size: " << (growth_chunk_size >> 10) << " KB" << std::endl;
+
+    do_segment_growth_test<based_2d_msk_strategy>("monotonic<based_2d_msk>", segment_count);
+    std::cout << std::endl;
+}
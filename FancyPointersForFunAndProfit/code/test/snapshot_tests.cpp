@@ -0,0 +1,246 @@
+//==================================================================================================
+//  File:   snapshot_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <cstdio>
+#include <fstream>
+
+#include <sys/mman.h>
+
+#include "container_tests.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Snapshot tests.  For each relocatable allocation strategy, a lookup table from key strings to
+//  lists of value strings is built in the segments by parsing a text file, which is the usual
+//  way to load such a table.  The segments are then saved with snapshot(), released, and read
+//  back with restore() while their old addresses are occupied, so that the table comes back at
+//  a new address; it is checked, and appended to, to show that allocation resumes after it.
+//
+//  Like mmap_table, the table is a sorted std::vector rather than a std::map of std::lists,
+//  because the node-based containers in libstdc++ link their nodes with ordinary pointers.
+//--------------------------------------------------------------------------------------------------
+//
+static int const        snap_key_count   = 250000;
+static int const        snap_value_count = 4;
+static char const*      snap_text_path   = "fancy_snapshot.txt";
+static char const*      snap_image_path  = "fancy_snapshot.img";
+
+template<class AS>
+struct snap_table
+{
+    using syn_string = simple_string<rhx_allocator<char, AS>>;
+    using syn_values = std::vector<syn_string, rhx_allocator<syn_string, AS>>;
+    using syn_entry  = std::pair<syn_string, syn_values>;
+    using syn_table  = std::vector<syn_entry, rhx_allocator<syn_entry, AS>>;
+
+    syn_table   m_entries;
+
+    void                load_text(char const* path);
+    syn_values const*   find(std::string_view key) const;
+};
+
+//- Reads lines of tab-separated strings, of which the first is a key and the rest its values.
+//  The keys are in sorted order.
+//
+template<class AS>
+void
+snap_table<AS>::load_text(char const* path)
+{
+    std::ifstream   in(path);
+    std::string     line;
+
+    m_entries.reserve(snap_key_count);
+
+    while (std::getline(in, line))
+    {
+        std::string_view    rest(line);
+        size_t              tab = rest.find('\t');
+
+        m_entries.emplace_back(syn_string(rest.substr(0, tab)), syn_values());
+
+        syn_values&     values = m_entries.back().second;
+
+        values.reserve(snap_value_count);
+        while (tab != std::string_view::npos)
+        {
+            rest = rest.substr(tab + 1);
+            tab  = rest.find('\t');
+            values.emplace_back(rest.substr(0, tab));
+        }
+    }
+}
+
+template<class AS>
+typename snap_table<AS>::syn_values const*
+snap_table<AS>::find(std::string_view key) const
+{
+    auto    iter = std::lower_bound(m_entries.begin(), m_entries.end(), key,
+                                    [](syn_entry const& e, std::string_view k)
+                                    { return e.first.view() < k; });
+
+    return (iter != m_entries.end()  &&  iter->first.view() == key) ? &iter->second : nullptr;
+}
+
+//------
+//
+void
+write_snap_text(char const* path)
+{
+    std::FILE*  fp = std::fopen(path, "w");
+
+    for (int i = 0;  i < snap_key_count;  ++i)
+    {
+        std::fprintf(fp, "this is key string #%08d", i);
+        for (int j = 0;  j < snap_value_count;  ++j)
+        {
+            std::fprintf(fp, "\tthis is string #%d created for key #%d", j, i);
+        }
+        std::fputc('\n', fp);
+    }
+    std::fclose(fp);
+}
+
+template<class AS>
+size_t
+check_snap_table(snap_table<AS> const& table)
+{
+    char    key_str[128], val_str[128];
+    size_t  errors = (table.m_entries.size() != (size_t) snap_key_count) ? 1 : 0;
+
+    for (int i = 0;  i < snap_key_count;  i += 7)
+    {
+        sprintf(key_str, "this is key string #%08d", i);
+
+        auto const*     pvals = table.find(key_str);
+
+        if (pvals == nullptr  ||  pvals->size() != (size_t) snap_value_count)
+        {
+            ++errors;
+            continue;
+        }
+        for (int j = 0;  j < snap_value_count;  ++j)
+        {
+            sprintf(val_str, "this is string #%d created for key #%d", j, i);
+            errors += ((*pvals)[j].view() != val_str) ? 1 : 0;
+        }
+    }
+    return errors;
+}
+
+template<class AS>
+void
+do_snapshot_test(char const* name)
+{
+    using storage_model = typename AS::storage_model;
+    using table_type    = snap_table<AS>;
+    using size_type     = typename storage_model::size_type;
+
+    AS          heap;
+    stopwatch   sw;
+    size_t      errors = 0;
+
+    heap.reset_segments();
+
+    //- Load the table from text.
+    //
+    sw.start();
+    table_type*     ptable = ::new (static_cast<table_type*>(heap.allocate(sizeof(table_type)))) table_type();
+    ptable->load_text(snap_text_path);
+    sw.stop();
+    int64_t     text_msec = sw.elapsed_msec();
+
+    errors += check_snap_table(*ptable);
+
+    //- Save it.
+    //
+    void*       root = ptable;
+    size_type   segment, offset;
+
+    sw.start();
+    AS::get_position(segment, offset);
+    bool    saved = storage_model::snapshot(snap_image_path, segment, offset, &root, 1);
+    sw.stop();
+    int64_t     save_msec = sw.elapsed_msec();
+
+    CHECK(saved);
+
+    //- Release the segments, and occupy the address ranges they held, so that they are restored
+    //  somewhere else.
+    //
+    std::vector<std::pair<void*, size_t>>   blocks;
+
+    for (size_type i = storage_model::first_segment_index();  i <= segment;  ++i)
+    {
+        blocks.emplace_back(storage_model::segment_address(i), storage_model::segment_size(i));
+    }
+    storage_model::clear_segments();
+    for (auto& block : blocks)
+    {
+        block.first = mmap(block.first, block.second, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    sw.start();
+    bool    restored = storage_model::restore(snap_image_path, segment, offset, &root, 1);
+    sw.stop();
+    int64_t     load_msec = sw.elapsed_msec();
+
+    CHECK(restored);
+    CHECK(root != ptable);
+
+    if (restored)
+    {
+        AS::set_position(segment, offset);
+        ptable  = static_cast<table_type*>(root);
+        errors += check_snap_table(*ptable);
+
+        //- Allocation must resume after the restored objects, not overwrite them.
+        //
+        ptable->m_entries.emplace_back(typename table_type::syn_string("this is key string #99999999"),
+                                       typename table_type::syn_values());
+        ptable->m_entries.back().second.emplace_back("an extra string");
+        errors += (ptable->m_entries.size() != (size_t) snap_key_count + 1) ? 1 : 0;
+        ptable->m_entries.pop_back();
+        errors += check_snap_table(*ptable);
+    }
+    CHECK(errors == 0);
+
+    for (auto const& block : blocks)
+    {
+        if (block.first != MAP_FAILED)
+        {
+            munmap(block.first, block.second);
+        }
+    }
+
+    std::ifstream   image(snap_image_path, std::ios::binary | std::ios::ate);
+
+    std::cout << "  " << std::left << std::setw(16) << name << std::right
+              << "text load: " << std::setw(4) << text_msec << " msec,  snapshot: "
+              << std::setw(4) << save_msec << " msec,  restore: " << std::setw(4) << load_msec
+              << " msec  (" << (image.tellg() >> 20) << " MB)" << std::endl;
+
+    std::remove(snap_image_path);
+    heap.reset_segments();
+}
+
+void
+test_snapshot_ops()
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "**** TEST SNAPSHOT ****" << std::endl;
+
+    write_snap_text(snap_text_path);
+
+    std::cout << snap_key_count << " keys, " << snap_key_count * snap_value_count
+              << " values" << std::endl;
+
+    do_snapshot_test<based_2d_xl_strategy>("based_2d_xl");
+    do_snapshot_test<based_2d_sm_strategy>("based_2d_sm");
+    do_snapshot_test<based_2d_msk_strategy>("based_2d_msk");
+    do_snapshot_test<compact_strategy>("compact");
+    std::cout << std::endl;
+
+    std::remove(snap_text_path);
+}
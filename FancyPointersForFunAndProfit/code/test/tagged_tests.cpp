@@ -0,0 +1,196 @@
+//==================================================================================================
+//  File:   tagged_tests.cpp
+//
+//  Copyright (c) 2018 Bob Steagall, KEWB Computing
+//==================================================================================================
+//
+#include <random>
+
+#include "rb_tree.h"
+
+//--------------------------------------------------------------------------------------------------
+//  Tagged pointer tests.  The first part checks that tags round-trip, are ignored by address(),
+//  comparisons, and dereferencing, and survive pointer arithmetic and relocation.  The second
+//  part builds an insert-only red-black tree twice: once with the node color in its own field
+//  (with based_2d_msk pointers), and once with the color kept in the low tag bit of the node's
+//  parent pointer (with tagged pointers).  Reported are the node sizes, the segment bytes used,
+//  and the build and lookup times.
+//--------------------------------------------------------------------------------------------------
+//
+static size_t const     rb_key_count = 500000;
+
+void
+check_tagged_pointers()
+{
+    using int_ptr = tagged_strategy::rebind_pointer<uint64_t>;
+
+    tagged_strategy     heap;
+    int_ptr             parray = static_cast<int_ptr>(heap.allocate(16 * sizeof(uint64_t)));
+    uint64_t*           praw   = parray;
+
+    for (uint64_t i = 0;  i < 16;  ++i)
+    {
+        parray[i] = i * 100;
+    }
+
+    int_ptr     p1 = parray + 5;
+    int_ptr     p2 = p1;
+
+    p2.addrmodel().set_low_tag(5);
+    p2.addrmodel().set_high_tag(9);
+
+    CHECK(p2.addrmodel().low_tag() == 5);
+    CHECK(p2.addrmodel().high_tag() == 9);
+    CHECK(static_cast<uint64_t*>(p2) == praw + 5);
+    CHECK(*p2 == 500);
+    CHECK(p1 == p2);
+    CHECK(!(p1 < p2)  &&  !(p2 < p1));
+
+    //- Arithmetic in whole elements leaves the tags alone.
+    //
+    p2 += 3;
+    CHECK(*p2 == 800);
+    CHECK(p2.addrmodel().low_tag() == 5  &&  p2.addrmodel().high_tag() == 9);
+    --p2;
+    CHECK(*p2 == 700);
+    CHECK(p2 - parray == 7);
+
+    //- A tagged null is still null, and assignment from a native pointer clears the tags.
+    //
+    int_ptr     pnull = nullptr;
+
+    pnull.addrmodel().set_low_tag(1);
+    CHECK(pnull == nullptr);
+    p2 = praw + 2;
+    CHECK(p2.addrmodel().low_tag() == 0  &&  p2.addrmodel().high_tag() == 0);
+
+    //- Pointers outside the segments keep their full address.
+    //
+    uint64_t    local = 42;
+    int_ptr     plocal = &local;
+
+    plocal.addrmodel().set_low_tag(7);
+    CHECK(*plocal == 42);
+
+    //- Tags and targets both survive relocation.
+    //
+    p2.addrmodel().set_low_tag(3);
+    tagged_strategy::swap_segments();
+    CHECK(*p2 == 200);
+    CHECK(p2.addrmodel().low_tag() == 3);
+
+    tagged_strategy::reset_segments();
+}
+
+//------
+//------
+//- A node layout with the color in the low tag bit of the parent pointer.
+//
+template<class AS>
+struct tagged_rb_node
+{
+    using node_ptr = typename AS::template rebind_pointer<tagged_rb_node>;
+
+    node_ptr    m_left;
+    node_ptr    m_right;
+    node_ptr    m_parent;       //- Low tag bit holds the node's color
+    uint64_t    m_key;
+
+    static  bool        is_red(node_ptr n)
+                        {
+                            return n  &&  n->m_parent.addrmodel().low_tag() != 0;
+                        }
+    static  void        set_red(node_ptr n, bool red)
+                        {
+                            n->m_parent.addrmodel().set_low_tag(red ? 1 : 0);
+                        }
+    static  node_ptr    parent(node_ptr n)
+                        {
+                            node_ptr    p = n->m_parent;
+                            p.addrmodel().set_low_tag(0);
+                            return p;
+                        }
+    static  void        set_parent(node_ptr n, node_ptr p)
+                        {
+                            auto    color = n->m_parent.addrmodel().low_tag();
+                            n->m_parent = p;
+                            n->m_parent.addrmodel().set_low_tag(color);
+                        }
+};
+
+//------
+//
+template<class AS, class NT>
+void
+do_rb_tree_test(char const* name, std::vector<uint64_t> const& keys)
+{
+    using node_ptr = typename NT::node_ptr;
+
+    AS          heap;
+    size_t      errors = 0;
+    stopwatch   sw;
+
+    heap.reset_segments();
+
+    {
+        rb_tree<NT>     tree;
+
+        sw.start();
+        for (uint64_t key : keys)
+        {
+            node_ptr    n = static_cast<node_ptr>(heap.allocate(sizeof(NT)));
+
+            ::new (static_cast<NT*>(n)) NT();
+            n->m_key = key;
+            tree.insert(n);
+        }
+        sw.stop();
+
+        int64_t     build_msec = sw.elapsed_msec();
+        size_t      bytes      = segment_bytes_used<AS>();
+
+        //- The whole tree must be intact after its segments are relocated.
+        //
+        AS::swap_segments();
+
+        sw.start();
+        for (uint64_t key : keys)
+        {
+            errors += tree.contains(key) ? 0 : 1;
+        }
+        sw.stop();
+
+        errors += tree.verify();
+        CHECK(errors == 0);
+
+        std::cout << "  " << std::left << std::setw(28) << name << std::right
+                  << "node: " << std::setw(3) << sizeof(NT) << " bytes,  segments: "
+                  << std::setw(6) << (bytes >> 10) << " KB,  build: "
+                  << std::setw(4) << build_msec << " msec,  lookup: "
+                  << std::setw(4) << sw.elapsed_msec() << " msec" << std::endl;
+    }
+
+    heap.reset_segments();
+}
+
+void
+test_tagged_ops()
+{
+    std::cout << "***********************" << std::endl;
+    std::cout << "*****  TEST TAGGED  ***" << std::endl;
+
+    check_tagged_pointers();
+
+    std::mt19937_64         gen(4242);
+    std::vector<uint64_t>   keys(rb_key_count);
+
+    for (auto& key : keys)
+    {
+        key = gen();
+    }
+
+    std::cout << "red-black tree with " << rb_key_count << " random keys" << std::endl;
+    do_rb_tree_test<based_2d_msk_strategy, colored_rb_node<based_2d_msk_strategy>>("color field<based_2d_msk>", keys);
+    do_rb_tree_test<tagged_strategy, tagged_rb_node<tagged_strategy>>("color tag bit<tagged>", keys);
+    std::cout << std::endl;
+}
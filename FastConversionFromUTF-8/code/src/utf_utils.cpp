@@ -383,6 +383,55 @@ char const*     UtfUtils::smStateNames[9] =
     "BGN", "ERR", "CS1", "CS2", "CS3", "P3A", "P3B", "P4A", "P4B",
 };
 
+//- These are the per-thread hot-path counters; they are only updated when the library is
+//  compiled with KEWB_UTF_UTILS_COLLECT_STATS defined.
+//
+thread_local UtfUtils::ConversionStats  UtfUtils::smStats = {};
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Reports whether the conversion member functions were compiled with counting enabled.
+///
+/// \returns
+///     Boolean value `true` if KEWB_UTF_UTILS_COLLECT_STATS was defined when this file was built.
+//--------------------------------------------------------------------------------------------------
+//
+bool
+UtfUtils::CollectingStats() noexcept
+{
+#if defined KEWB_UTF_UTILS_COLLECT_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Returns a copy of the calling thread's hot-path counters.
+///
+/// \details
+///     The copy is a plain aggregate, so it can be handed directly to an external metrics
+///     exporter.  All counters are zero if counting was not enabled at compile time.
+///
+/// \returns
+///     The counters accumulated by the calling thread since the last call to `ResetStats`.
+//--------------------------------------------------------------------------------------------------
+//
+UtfUtils::ConversionStats
+UtfUtils::GetStats() noexcept
+{
+    return smStats;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Sets all of the calling thread's hot-path counters to zero.
+//--------------------------------------------------------------------------------------------------
+//
+void
+UtfUtils::ResetStats() noexcept
+{
+    smStats = ConversionStats{};
+}
+
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of UTF-8 code units to a sequence of UTF-32 code points.
 ///
@@ -392,6 +441,8 @@ char const*     UtfUtils::smStateNames[9] =
 ///     the DFA without any optimizations using the `AdvanceWithBigTable` member function to
 ///     read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -404,6 +455,7 @@ char const*     UtfUtils::smStateNames[9] =
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
@@ -414,7 +466,7 @@ UtfUtils::BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
     {
         if (AdvanceWithBigTable(pSrc, pSrcEnd, cdpt) != ERR)
         {
-            *pDst++ = cdpt;
+            *pDst++ = OrderUnit<BO>(cdpt);
         }
         else
         {
@@ -435,6 +487,8 @@ UtfUtils::BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
 ///     converting them directly to code points.  It uses the `AdvanceWithBigTable` member
 ///     function to read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -447,6 +501,7 @@ UtfUtils::BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
@@ -457,13 +512,14 @@ UtfUtils::FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char3
     {
         if (*pSrc < 0x80)
         {
-            *pDst++ = *pSrc++;
+            *pDst++ = OrderUnit<BO>((char32_t) *pSrc++);
+            CountAsciiUnit();
         }
         else
         {
             if (AdvanceWithBigTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                *pDst++ = cdpt;
+                *pDst++ = OrderUnit<BO>(cdpt);
             }
             else
             {
@@ -485,6 +541,8 @@ UtfUtils::FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char3
 ///     ASCII code units using SSE intrinsics.  It uses the `AdvanceWithBigTable` member
 ///     function to read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -497,6 +555,7 @@ UtfUtils::FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char3
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
@@ -507,13 +566,13 @@ UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32
     {
         if (*pSrc < 0x80)
         {
-            ConvertAsciiWithSse(pSrc, pDst);
+            ConvertAsciiWithSse<BO>(pSrc, pDst);
         }
         else
         {
             if (AdvanceWithBigTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                *pDst++ = cdpt;
+                *pDst++ = OrderUnit<BO>(cdpt);
             }
             else
             {
@@ -526,13 +585,14 @@ UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32
     {
         if (*pSrc < 0x80)
         {
-            *pDst++ = *pSrc++;
+            *pDst++ = OrderUnit<BO>((char32_t) *pSrc++);
+            CountAsciiUnit();
         }
         else
         {
             if (AdvanceWithBigTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                *pDst++ = cdpt;
+                *pDst++ = OrderUnit<BO>(cdpt);
             }
             else
             {
@@ -553,6 +613,8 @@ UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32
 ///     the DFA without any optimizations using the `AdvanceWithBigTable` member function to
 ///     read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -565,6 +627,7 @@ UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
@@ -575,7 +638,7 @@ UtfUtils::BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
     {
         if (AdvanceWithBigTable(pSrc, pSrcEnd, cdpt) != ERR)
         {
-            GetCodeUnits(cdpt, pDst);
+            GetCodeUnits<BO>(cdpt, pDst);
         }
         else
         {
@@ -596,6 +659,8 @@ UtfUtils::BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
 ///     converting them directly to code points.  It uses the `AdvanceWithBigTable` member
 ///     function to read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -608,6 +673,7 @@ UtfUtils::BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
@@ -618,13 +684,14 @@ UtfUtils::FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char1
     {
         if (*pSrc < 0x80)
         {
-            *pDst++ = *pSrc++;
+            *pDst++ = OrderUnit<BO>((char16_t) *pSrc++);
+            CountAsciiUnit();
         }
         else
         {
             if (AdvanceWithBigTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                GetCodeUnits(cdpt, pDst);
+                GetCodeUnits<BO>(cdpt, pDst);
             }
             else
             {
@@ -646,6 +713,8 @@ UtfUtils::FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char1
 ///     ASCII code units using SSE intrinsics.  It uses the `AdvanceWithBigTable` member
 ///     function to read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -658,6 +727,7 @@ UtfUtils::FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char1
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
@@ -668,13 +738,13 @@ UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16
     {
         if (*pSrc < 0x80)
         {
-            ConvertAsciiWithSse(pSrc, pDst);
+            ConvertAsciiWithSse<BO>(pSrc, pDst);
         }
         else
         {
             if (AdvanceWithBigTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                GetCodeUnits(cdpt, pDst);
+                GetCodeUnits<BO>(cdpt, pDst);
             }
             else
             {
@@ -687,13 +757,14 @@ UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16
     {
         if (*pSrc < 0x80)
         {
-            *pDst++ = *pSrc++;
+            *pDst++ = OrderUnit<BO>((char16_t) *pSrc++);
+            CountAsciiUnit();
         }
         else
         {
             if (AdvanceWithBigTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                GetCodeUnits(cdpt, pDst);
+                GetCodeUnits<BO>(cdpt, pDst);
             }
             else
             {
@@ -714,6 +785,8 @@ UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16
 ///     the DFA without any optimizations using the `AdvanceWithSmallTable` member function to
 ///     read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -726,6 +799,7 @@ UtfUtils::SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
@@ -736,7 +810,7 @@ UtfUtils::BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, ch
     {
         if (AdvanceWithSmallTable(pSrc, pSrcEnd, cdpt) != ERR)
         {
-            *pDst++ = cdpt;
+            *pDst++ = OrderUnit<BO>(cdpt);
         }
         else
         {
@@ -757,6 +831,8 @@ UtfUtils::BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, ch
 ///     converting them directly to code points.  It uses the `AdvanceWithSmallTable` member
 ///     function to read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -769,6 +845,7 @@ UtfUtils::BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, ch
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
@@ -779,13 +856,14 @@ UtfUtils::FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, cha
     {
         if (*pSrc < 0x80)
         {
-            *pDst++ = *pSrc++;
+            *pDst++ = OrderUnit<BO>((char32_t) *pSrc++);
+            CountAsciiUnit();
         }
         else
         {
             if (AdvanceWithSmallTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                *pDst++ = cdpt;
+                *pDst++ = OrderUnit<BO>(cdpt);
             }
             else
             {
@@ -807,6 +885,8 @@ UtfUtils::FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, cha
 ///     ASCII code units using SSE intrinsics.  It uses the `AdvanceWithSmallTable` member
 ///     function to read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -819,6 +899,7 @@ UtfUtils::FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, cha
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
@@ -829,13 +910,13 @@ UtfUtils::SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
     {
         if (*pSrc < 0x80)
         {
-            ConvertAsciiWithSse(pSrc, pDst);
+            ConvertAsciiWithSse<BO>(pSrc, pDst);
         }
         else
         {
             if (AdvanceWithSmallTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                *pDst++ = cdpt;
+                *pDst++ = OrderUnit<BO>(cdpt);
             }
             else
             {
@@ -848,13 +929,14 @@ UtfUtils::SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
     {
         if (*pSrc < 0x80)
         {
-            *pDst++ = *pSrc++;
+            *pDst++ = OrderUnit<BO>((char32_t) *pSrc++);
+            CountAsciiUnit();
         }
         else
         {
             if (AdvanceWithSmallTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                *pDst++ = cdpt;
+                *pDst++ = OrderUnit<BO>(cdpt);
             }
             else
             {
@@ -875,6 +957,8 @@ UtfUtils::SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
 ///     the DFA without any optimizations using the `AdvanceWithSmallTable` member function to
 ///     read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -887,6 +971,7 @@ UtfUtils::SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
@@ -897,7 +982,7 @@ UtfUtils::BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, ch
     {
         if (AdvanceWithSmallTable(pSrc, pSrcEnd, cdpt) != ERR)
         {
-            GetCodeUnits(cdpt, pDst);
+            GetCodeUnits<BO>(cdpt, pDst);
         }
         else
         {
@@ -918,6 +1003,8 @@ UtfUtils::BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, ch
 ///     converting them directly to code points.  It uses the `AdvanceWithSmallTable` member
 ///     function to read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -930,6 +1017,7 @@ UtfUtils::BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, ch
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
@@ -940,13 +1028,14 @@ UtfUtils::FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, cha
     {
         if (*pSrc < 0x80)
         {
-            *pDst++ = *pSrc++;
+            *pDst++ = OrderUnit<BO>((char16_t) *pSrc++);
+            CountAsciiUnit();
         }
         else
         {
             if (AdvanceWithSmallTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                GetCodeUnits(cdpt, pDst);
+                GetCodeUnits<BO>(cdpt, pDst);
             }
             else
             {
@@ -968,6 +1057,8 @@ UtfUtils::FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, cha
 ///     ASCII code units using SSE intrinsics.  It uses the `AdvanceWithSmallTable` member
 ///     function to read and convert input.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -980,6 +1071,7 @@ UtfUtils::FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, cha
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_ALIGN_FN std::ptrdiff_t
 UtfUtils::SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
@@ -990,13 +1082,13 @@ UtfUtils::SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
     {
         if (*pSrc < 0x80)
         {
-            ConvertAsciiWithSse(pSrc, pDst);
+            ConvertAsciiWithSse<BO>(pSrc, pDst);
         }
         else
         {
             if (AdvanceWithSmallTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                GetCodeUnits(cdpt, pDst);
+                GetCodeUnits<BO>(cdpt, pDst);
             }
             else
             {
@@ -1009,13 +1101,14 @@ UtfUtils::SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char
     {
         if (*pSrc < 0x80)
         {
-            *pDst++ = *pSrc++;
+            *pDst++ = OrderUnit<BO>((char16_t) *pSrc++);
+            CountAsciiUnit();
         }
         else
         {
             if (AdvanceWithSmallTable(pSrc, pSrcEnd, cdpt) != ERR)
             {
-                GetCodeUnits(cdpt, pDst);
+                GetCodeUnits<BO>(cdpt, pDst);
             }
             else
             {
@@ -1109,19 +1202,545 @@ UtfUtils::ConvertWithTrace(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t
     return pDst - pDstOrig;
 }
 
+//--------------------------------------------------------------------------------------------------
+/// \brief  Determines the probable encoding of a sequence of octets.
+///
+/// \details
+///     This static member function first looks for a byte order mark (BOM) at the start of
+///     the input range.  If there is none, it scans a bounded prefix of the input (at most
+///     `smSniffLength` octets) with SSE intrinsics, counting the octets having the high bit
+///     set and the zero octets found at each position modulo four.  Those counts identify
+///     pure ASCII, as well as the zero-octet patterns typical of UTF-32LE/BE and UTF-16LE/BE.
+///     If the prefix contains non-ASCII octets but no zero octets, the DFA is run over the
+///     prefix to determine whether it is valid UTF-8.
+///
+///     The zero-octet heuristics depend on the text containing a reasonable proportion of
+///     code points below U+0100; UTF-16 text without a BOM that consists mostly of other
+///     scripts is reported as `UnknownEncoding`.
+///
+/// \param pSrc
+///     A non-null pointer defining the beginning of the octet input range.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the octet input range.
+///
+/// \returns
+///     An `EncodingInfo` object holding the detected encoding and the length of its BOM, which
+///     is zero if no BOM was found.
+//--------------------------------------------------------------------------------------------------
+//
+UtfUtils::EncodingInfo
+UtfUtils::DetectEncoding(char8_t const* pSrc, char8_t const* pSrcEnd) noexcept
+{
+    ptrdiff_t   size = pSrcEnd - pSrc;
+
+    //- Look for a BOM.  The UTF-32LE BOM begins with the UTF-16LE BOM, so the UTF-32 BOMs
+    //  must be checked first (which means a UTF-16LE BOM followed by U+0000 is reported as
+    //  UTF-32LE; that ambiguity is inherent in the BOMs themselves).
+    //
+    if (size >= 3  &&  pSrc[0] == 0xEF  &&  pSrc[1] == 0xBB  &&  pSrc[2] == 0xBF)
+    {
+        return { Utf8, 3 };
+    }
+    else if (size >= 4  &&  pSrc[0] == 0xFF  &&  pSrc[1] == 0xFE  &&  pSrc[2] == 0  &&  pSrc[3] == 0)
+    {
+        return { Utf32LE, 4 };
+    }
+    else if (size >= 4  &&  pSrc[0] == 0  &&  pSrc[1] == 0  &&  pSrc[2] == 0xFE  &&  pSrc[3] == 0xFF)
+    {
+        return { Utf32BE, 4 };
+    }
+    else if (size >= 2  &&  pSrc[0] == 0xFF  &&  pSrc[1] == 0xFE)
+    {
+        return { Utf16LE, 2 };
+    }
+    else if (size >= 2  &&  pSrc[0] == 0xFE  &&  pSrc[1] == 0xFF)
+    {
+        return { Utf16BE, 2 };
+    }
+
+    //- No BOM, so sniff the prefix.  Each 16-octet block contributes the number of octets
+    //  with the high bit set, and the number of zero octets at each position modulo four.
+    //
+    char8_t const*  pScanEnd = pSrc + ((size < smSniffLength) ? size : smSniffLength);
+    char8_t const*  pNext    = pSrc;
+    __m128i         chunk, zero;
+    int32_t         high, zmask;
+    uint32_t        highCount = 0;
+    uint32_t        zeroCount[4] = { 0, 0, 0, 0 };
+
+    zero = _mm_set1_epi8(0);
+
+    while (pNext < (pScanEnd - sizeof(__m128i)))
+    {
+        chunk = _mm_loadu_si128((__m128i const*) pNext);                //- Load 16 octets
+        high  = _mm_movemask_epi8(chunk);                               //- Octets with high bit set
+        zmask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, zero));         //- Octets equal to zero
+
+        highCount    += GetBitCount(high);
+        zeroCount[0] += GetBitCount(zmask & 0x1111);
+        zeroCount[1] += GetBitCount(zmask & 0x2222);
+        zeroCount[2] += GetBitCount(zmask & 0x4444);
+        zeroCount[3] += GetBitCount(zmask & 0x8888);
+        pNext        += sizeof(__m128i);
+    }
+
+    for (;  pNext < pScanEnd;  ++pNext)
+    {
+        highCount += (*pNext >> 7);
+        zeroCount[(pNext - pSrc) & 3] += (*pNext == 0);
+    }
+
+    uint32_t    units32   = (uint32_t) ((pScanEnd - pSrc) / 4);
+    uint32_t    units16   = (uint32_t) ((pScanEnd - pSrc) / 2);
+    uint32_t    evenZeros = zeroCount[0] + zeroCount[2];
+    uint32_t    oddZeros  = zeroCount[1] + zeroCount[3];
+
+    if (evenZeros + oddZeros == 0)
+    {
+        if (highCount == 0)
+        {
+            return { Ascii, 0 };
+        }
+        return { IsValidUtf8Prefix(pSrc, pScanEnd, pScanEnd == pSrcEnd) ? Utf8 : UnknownEncoding, 0 };
+    }
+
+    //- UTF-32 always has a zero in its most-significant octet, and for BMP code points a zero
+    //  in the next octet as well.  UTF-16 text from Latin scripts has a zero in every unit's
+    //  most-significant octet, which is odd-positioned for LE and even-positioned for BE.
+    //
+    if (units32 != 0  &&  zeroCount[3] >= units32  &&  2*zeroCount[2] >= units32)
+    {
+        return { Utf32LE, 0 };
+    }
+    else if (units32 != 0  &&  zeroCount[0] >= units32  &&  2*zeroCount[1] >= units32)
+    {
+        return { Utf32BE, 0 };
+    }
+    else if (4*oddZeros >= units16  &&  oddZeros > 2*evenZeros)
+    {
+        return { Utf16LE, 0 };
+    }
+    else if (4*evenZeros >= units16  &&  evenZeros > 2*oddZeros)
+    {
+        return { Utf16BE, 0 };
+    }
+
+    return { UnknownEncoding, 0 };
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Converts a sequence of code units in a detected encoding to a sequence of UTF-32
+///         code points.
+///
+/// \details
+///     This static member function calls `DetectEncoding` to identify the encoding of the input
+///     range, skips any BOM, and then dispatches to the appropriate converter: `SseConvert` for
+///     ASCII and UTF-8, or a UTF-16/UTF-32 decoder of the detected byte order.  Input whose
+///     encoding could not be determined is treated as UTF-8, and so fails unless it is valid.
+///     Since `DetectEncoding` only examines a bounded prefix, no separate pass over the full
+///     input is required; the chosen converter validates the entire input as it goes.
+///
+/// \param pSrc
+///     A non-null pointer defining the beginning of the code unit input range.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the code unit input range.
+/// \param pDst
+///     A non-null pointer defining the beginning of the code point output range.
+///
+/// \returns
+///     If successful, the number of UTF-32 code points written; otherwise -1 is returned to
+///     indicate an error was encountered.
+//--------------------------------------------------------------------------------------------------
+//
+std::ptrdiff_t
+UtfUtils::AutoConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
+{
+    EncodingInfo    info = DetectEncoding(pSrc, pSrcEnd);
+
+    pSrc += info.mBomLength;
+
+    switch (info.mEncoding)
+    {
+        case Utf16LE:   return ConvertFromUtf16<LittleEndian>(pSrc, pSrcEnd, pDst);
+        case Utf16BE:   return ConvertFromUtf16<BigEndian>(pSrc, pSrcEnd, pDst);
+        case Utf32LE:   return ConvertFromUtf32<LittleEndian>(pSrc, pSrcEnd, pDst);
+        case Utf32BE:   return ConvertFromUtf32<BigEndian>(pSrc, pSrcEnd, pDst);
+        default:        return SseConvert(pSrc, pSrcEnd, pDst);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Converts a sequence of code units in a detected encoding to a sequence of UTF-16
+///         code units.
+///
+/// \details
+///     This static member function calls `DetectEncoding` to identify the encoding of the input
+///     range, skips any BOM, and then dispatches to the appropriate converter: `SseConvert` for
+///     ASCII and UTF-8, or a UTF-16/UTF-32 decoder of the detected byte order.  Input whose
+///     encoding could not be determined is treated as UTF-8, and so fails unless it is valid.
+///
+/// \param pSrc
+///     A non-null pointer defining the beginning of the code unit input range.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the code unit input range.
+/// \param pDst
+///     A non-null pointer defining the beginning of the code unit output range.
+///
+/// \returns
+///     If successful, the number of UTF-16 code units written; otherwise -1 is returned to
+///     indicate an error was encountered.
+//--------------------------------------------------------------------------------------------------
+//
+std::ptrdiff_t
+UtfUtils::AutoConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
+{
+    EncodingInfo    info = DetectEncoding(pSrc, pSrcEnd);
+
+    pSrc += info.mBomLength;
+
+    switch (info.mEncoding)
+    {
+        case Utf16LE:   return ConvertFromUtf16<LittleEndian>(pSrc, pSrcEnd, pDst);
+        case Utf16BE:   return ConvertFromUtf16<BigEndian>(pSrc, pSrcEnd, pDst);
+        case Utf32LE:   return ConvertFromUtf32<LittleEndian>(pSrc, pSrcEnd, pDst);
+        case Utf32BE:   return ConvertFromUtf32<BigEndian>(pSrc, pSrcEnd, pDst);
+        default:        return SseConvert(pSrc, pSrcEnd, pDst);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Determines whether a prefix of the input is valid UTF-8.
+///
+/// \details
+///     The octets are run through the DFA tables directly, rather than through
+///     `AdvanceWithSmallTable`, so that sniffing the input does not update the hot-path
+///     counters; only the conversion that follows is counted.  If the prefix is not the whole
+///     input, it may end partway through a sequence; in that case the final (possibly
+///     incomplete) sequence is not examined.
+///
+/// \param pSrc
+///     A non-null pointer defining the beginning of the code unit input range.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the code unit input range.
+/// \param isComplete
+///     `true` if the range is the whole input, `false` if it is a prefix.
+///
+/// \returns
+///     Boolean value `true` if no invalid sequence was found.
+//--------------------------------------------------------------------------------------------------
+//
+bool
+UtfUtils::IsValidUtf8Prefix(char8_t const* pSrc, char8_t const* pSrcEnd, bool isComplete) noexcept
+{
+    int32_t     curr;   //- The current DFA state
+
+    if (!isComplete)
+    {
+        char8_t const*  pLast = pSrcEnd;
+
+        for (int32_t i = 0;  i < 3  &&  pLast > pSrc  &&  (pLast[-1] & 0xC0) == 0x80;  ++i)
+        {
+            --pLast;
+        }
+        if (pLast > pSrc  &&  pLast[-1] >= 0xC0)
+        {
+            pSrcEnd = pLast - 1;
+        }
+    }
+
+    while (pSrc < pSrcEnd)
+    {
+        curr = smTables.maTransitions[smTables.maOctetCategory[*pSrc++]];
+
+        while (curr > ERR  &&  pSrc < pSrcEnd)
+        {
+            curr = smTables.maTransitions[curr + smTables.maOctetCategory[*pSrc++]];
+        }
+        if (curr != END)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Converts a sequence of UTF-16 code units to a sequence of UTF-32 code points.
+///
+/// \tparam BO
+///     The byte order of the UTF-16 code units in the input range.
+/// \param pSrc
+///     A non-null pointer defining the beginning of the input range, as octets.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the input range, as octets.
+/// \param pDst
+///     A non-null pointer defining the beginning of the code point output range.
+///
+/// \returns
+///     If successful, the number of UTF-32 code points written; otherwise -1 is returned to
+///     indicate an error was encountered.
+//--------------------------------------------------------------------------------------------------
+//
+template<UtfUtils::ByteOrder BO>
+std::ptrdiff_t
+UtfUtils::ConvertFromUtf16(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
+{
+    char32_t*   pDstOrig = pDst;
+    char32_t    cdpt;
+
+    while (pSrc < pSrcEnd)
+    {
+        if (DecodeUtf16<BO>(pSrc, pSrcEnd, cdpt))
+        {
+            *pDst++ = cdpt;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+
+    return pDst - pDstOrig;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Converts a sequence of UTF-16 code units to a sequence of native UTF-16 code units.
+///
+/// \tparam BO
+///     The byte order of the UTF-16 code units in the input range.
+/// \param pSrc
+///     A non-null pointer defining the beginning of the input range, as octets.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the input range, as octets.
+/// \param pDst
+///     A non-null pointer defining the beginning of the code unit output range.
+///
+/// \returns
+///     If successful, the number of UTF-16 code units written; otherwise -1 is returned to
+///     indicate an error was encountered.
+//--------------------------------------------------------------------------------------------------
+//
+template<UtfUtils::ByteOrder BO>
+std::ptrdiff_t
+UtfUtils::ConvertFromUtf16(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
+{
+    char16_t*   pDstOrig = pDst;
+    char32_t    cdpt;
+
+    while (pSrc < pSrcEnd)
+    {
+        if (DecodeUtf16<BO>(pSrc, pSrcEnd, cdpt))
+        {
+            GetCodeUnits(cdpt, pDst);
+        }
+        else
+        {
+            return -1;
+        }
+    }
+
+    return pDst - pDstOrig;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Converts a sequence of UTF-32 code points to a sequence of native UTF-32 code points.
+///
+/// \tparam BO
+///     The byte order of the UTF-32 code points in the input range.
+/// \param pSrc
+///     A non-null pointer defining the beginning of the input range, as octets.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the input range, as octets.
+/// \param pDst
+///     A non-null pointer defining the beginning of the code point output range.
+///
+/// \returns
+///     If successful, the number of UTF-32 code points written; otherwise -1 is returned to
+///     indicate an error was encountered.
+//--------------------------------------------------------------------------------------------------
+//
+template<UtfUtils::ByteOrder BO>
+std::ptrdiff_t
+UtfUtils::ConvertFromUtf32(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
+{
+    char32_t*   pDstOrig = pDst;
+    char32_t    cdpt;
+
+    while (pSrc < pSrcEnd)
+    {
+        if (DecodeUtf32<BO>(pSrc, pSrcEnd, cdpt))
+        {
+            *pDst++ = cdpt;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+
+    return pDst - pDstOrig;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Converts a sequence of UTF-32 code points to a sequence of native UTF-16 code units.
+///
+/// \tparam BO
+///     The byte order of the UTF-32 code points in the input range.
+/// \param pSrc
+///     A non-null pointer defining the beginning of the input range, as octets.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the input range, as octets.
+/// \param pDst
+///     A non-null pointer defining the beginning of the code unit output range.
+///
+/// \returns
+///     If successful, the number of UTF-16 code units written; otherwise -1 is returned to
+///     indicate an error was encountered.
+//--------------------------------------------------------------------------------------------------
+//
+template<UtfUtils::ByteOrder BO>
+std::ptrdiff_t
+UtfUtils::ConvertFromUtf32(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
+{
+    char16_t*   pDstOrig = pDst;
+    char32_t    cdpt;
+
+    while (pSrc < pSrcEnd)
+    {
+        if (DecodeUtf32<BO>(pSrc, pSrcEnd, cdpt))
+        {
+            GetCodeUnits(cdpt, pDst);
+        }
+        else
+        {
+            return -1;
+        }
+    }
+
+    return pDst - pDstOrig;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Decodes one UTF-16 code point (one code unit or a surrogate pair) from octets.
+///
+/// \tparam BO
+///     The byte order of the UTF-16 code units in the input range.
+/// \param pSrc
+///     A reference to a non-null pointer defining the start of the input range; on success it
+///     is advanced past the code units consumed.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the input range.
+/// \param cdpt
+///     A mutable reference to a char32_t variable which will receive the code point.
+///
+/// \returns
+///     Boolean value `true` on success; `false` for a truncated code unit, a truncated
+///     surrogate pair, or an unpaired surrogate.
+//--------------------------------------------------------------------------------------------------
+//
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE bool
+UtfUtils::DecodeUtf16(char8_t const*& pSrc, char8_t const* pSrcEnd, char32_t& cdpt) noexcept
+{
+    char32_t    unit, next;
+
+    if (pSrcEnd - pSrc < 2)
+    {
+        return false;
+    }
+
+    unit = (BO == LittleEndian) ? (pSrc[0] | (pSrc[1] << 8)) : ((pSrc[0] << 8) | pSrc[1]);
+
+    if (unit < 0xD800  ||  unit > 0xDFFF)
+    {
+        cdpt  = unit;
+        pSrc += 2;
+        return true;
+    }
+    else if (unit > 0xDBFF  ||  pSrcEnd - pSrc < 4)
+    {
+        return false;
+    }
+
+    next = (BO == LittleEndian) ? (pSrc[2] | (pSrc[3] << 8)) : ((pSrc[2] << 8) | pSrc[3]);
+
+    if (next < 0xDC00  ||  next > 0xDFFF)
+    {
+        return false;
+    }
+
+    cdpt  = 0x10000 + ((unit - 0xD800) << 10) + (next - 0xDC00);
+    pSrc += 4;
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Decodes one UTF-32 code point from octets.
+///
+/// \tparam BO
+///     The byte order of the UTF-32 code points in the input range.
+/// \param pSrc
+///     A reference to a non-null pointer defining the start of the input range; on success it
+///     is advanced past the code point consumed.
+/// \param pSrcEnd
+///     A non-null past-the-end pointer defining the end of the input range.
+/// \param cdpt
+///     A mutable reference to a char32_t variable which will receive the code point.
+///
+/// \returns
+///     Boolean value `true` on success; `false` for a truncated code point, a surrogate, or
+///     a value greater than U+10FFFF.
+//--------------------------------------------------------------------------------------------------
+//
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE bool
+UtfUtils::DecodeUtf32(char8_t const*& pSrc, char8_t const* pSrcEnd, char32_t& cdpt) noexcept
+{
+    char32_t    unit;
+
+    if (pSrcEnd - pSrc < 4)
+    {
+        return false;
+    }
+
+    if (BO == LittleEndian)
+    {
+        unit = pSrc[0] | (pSrc[1] << 8) | (pSrc[2] << 16) | ((char32_t) pSrc[3] << 24);
+    }
+    else
+    {
+        unit = ((char32_t) pSrc[0] << 24) | (pSrc[1] << 16) | (pSrc[2] << 8) | pSrc[3];
+    }
+
+    if (unit > 0x10FFFF  ||  (unit >= 0xD800  &&  unit <= 0xDFFF))
+    {
+        return false;
+    }
+
+    cdpt  = unit;
+    pSrc += 4;
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of ASCII UTF-8 code units to a sequence of UTF-32 code points.
 ///
 /// \details
 ///     This static member function uses SSE intrinsics to convert a register of ASCII code
-///     units to four registers of equivalent UTF-32 code units.
+///     units to four registers of equivalent UTF-32 code units.  Big-endian output is produced
+///     in-register by reversing the operand order of the unpack instructions, so that the zero
+///     bytes are interleaved ahead of each ASCII octet rather than after it.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A reference to a non-null pointer defining the start of the code unit input range.
 /// \param pDst
 ///     A reference to a non-null pointer defining the start of the code point output range.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_FORCE_INLINE void
 UtfUtils::ConvertAsciiWithSse(char8_t const*& pSrc, char32_t*& pDst) noexcept
 {
@@ -1131,18 +1750,36 @@ UtfUtils::ConvertAsciiWithSse(char8_t const*& pSrc, char32_t*& pDst) noexcept
     zero  = _mm_set1_epi8(0);                           //- Zero out the interleave register
     chunk = _mm_loadu_si128((__m128i const*) pSrc);     //- Load a register with 8-bit bytes
     mask  = _mm_movemask_epi8(chunk);                   //- Determine which octets have high bit set
+    CountSseBlock(mask);
 
-    half = _mm_unpacklo_epi8(chunk, zero);              //- Unpack bytes 0-7 into 16-bit words
-    qrtr = _mm_unpacklo_epi16(half, zero);              //- Unpack words 0-3 into 32-bit dwords
-    _mm_storeu_si128((__m128i*) pDst, qrtr);            //- Write to memory
-    qrtr = _mm_unpackhi_epi16(half, zero);              //- Unpack words 4-7 into 32-bit dwords
-    _mm_storeu_si128((__m128i*) (pDst + 4), qrtr);      //- Write to memory
-
-    half = _mm_unpackhi_epi8(chunk, zero);              //- Unpack bytes 8-15 into 16-bit words
-    qrtr = _mm_unpacklo_epi16(half, zero);              //- Unpack words 8-11 into 32-bit dwords
-    _mm_storeu_si128((__m128i*) (pDst + 8), qrtr);      //- Write to memory
-    qrtr = _mm_unpackhi_epi16(half, zero);              //- Unpack words 12-15 into 32-bit dwords
-    _mm_storeu_si128((__m128i*) (pDst + 12), qrtr);     //- Write to memory
+    if (BO == LittleEndian)
+    {
+        half = _mm_unpacklo_epi8(chunk, zero);          //- Unpack bytes 0-7 into 16-bit words
+        qrtr = _mm_unpacklo_epi16(half, zero);          //- Unpack words 0-3 into 32-bit dwords
+        _mm_storeu_si128((__m128i*) pDst, qrtr);        //- Write to memory
+        qrtr = _mm_unpackhi_epi16(half, zero);          //- Unpack words 4-7 into 32-bit dwords
+        _mm_storeu_si128((__m128i*) (pDst + 4), qrtr);  //- Write to memory
+
+        half = _mm_unpackhi_epi8(chunk, zero);          //- Unpack bytes 8-15 into 16-bit words
+        qrtr = _mm_unpacklo_epi16(half, zero);          //- Unpack words 8-11 into 32-bit dwords
+        _mm_storeu_si128((__m128i*) (pDst + 8), qrtr);  //- Write to memory
+        qrtr = _mm_unpackhi_epi16(half, zero);          //- Unpack words 12-15 into 32-bit dwords
+        _mm_storeu_si128((__m128i*) (pDst + 12), qrtr); //- Write to memory
+    }
+    else
+    {
+        half = _mm_unpacklo_epi8(zero, chunk);          //- Unpack bytes 0-7 into BE 16-bit words
+        qrtr = _mm_unpacklo_epi16(zero, half);          //- Unpack words 0-3 into BE 32-bit dwords
+        _mm_storeu_si128((__m128i*) pDst, qrtr);        //- Write to memory
+        qrtr = _mm_unpackhi_epi16(zero, half);          //- Unpack words 4-7 into BE 32-bit dwords
+        _mm_storeu_si128((__m128i*) (pDst + 4), qrtr);  //- Write to memory
+
+        half = _mm_unpackhi_epi8(zero, chunk);          //- Unpack bytes 8-15 into BE 16-bit words
+        qrtr = _mm_unpacklo_epi16(zero, half);          //- Unpack words 8-11 into BE 32-bit dwords
+        _mm_storeu_si128((__m128i*) (pDst + 8), qrtr);  //- Write to memory
+        qrtr = _mm_unpackhi_epi16(zero, half);          //- Unpack words 12-15 into BE 32-bit dwords
+        _mm_storeu_si128((__m128i*) (pDst + 12), qrtr); //- Write to memory
+    }
 
     //- If no bits were set in the mask, then all 16 code units were ASCII, and therefore
     //  both pointers are advanced by 16.
@@ -1168,14 +1805,18 @@ UtfUtils::ConvertAsciiWithSse(char8_t const*& pSrc, char32_t*& pDst) noexcept
 ///
 /// \details
 ///     This static member function uses SSE intrinsics to convert a register of ASCII code
-///     units to two registers of equivalent UTF-16 code units.
+///     units to two registers of equivalent UTF-16 code units.  Big-endian output is produced
+///     in-register by reversing the operand order of the unpack instructions.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A reference to a non-null pointer defining the start of the code unit input range.
 /// \param pDst
 ///     A reference to a non-null pointer defining the start of the code unit output range.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_FORCE_INLINE void
 UtfUtils::ConvertAsciiWithSse(char8_t const*& pSrc, char16_t*& pDst) noexcept
 {
@@ -1184,12 +1825,24 @@ UtfUtils::ConvertAsciiWithSse(char8_t const*& pSrc, char16_t*& pDst) noexcept
 
     chunk = _mm_loadu_si128((__m128i const*) pSrc);     //- Load the register with 8-bit bytes
     mask  = _mm_movemask_epi8(chunk);                   //- Determine which octets have high bit set
+    CountSseBlock(mask);
+
+    if (BO == LittleEndian)
+    {
+        half = _mm_unpacklo_epi8(chunk, _mm_set1_epi8(0));  //- Unpack lower half into 16-bit words
+        _mm_storeu_si128((__m128i*) pDst, half);            //- Write to memory
 
-    half = _mm_unpacklo_epi8(chunk, _mm_set1_epi8(0));  //- Unpack lower half into 16-bit words
-    _mm_storeu_si128((__m128i*) pDst, half);            //- Write to memory
+        half = _mm_unpackhi_epi8(chunk, _mm_set1_epi8(0));  //- Unpack upper half into 16-bit words
+        _mm_storeu_si128((__m128i*) (pDst + 8), half);      //- Write to memory
+    }
+    else
+    {
+        half = _mm_unpacklo_epi8(_mm_set1_epi8(0), chunk);  //- Unpack lower half into BE 16-bit words
+        _mm_storeu_si128((__m128i*) pDst, half);            //- Write to memory
 
-    half = _mm_unpackhi_epi8(chunk, _mm_set1_epi8(0));  //- Unpack upper half into 16-bit words
-    _mm_storeu_si128((__m128i*) (pDst + 8), half);      //- Write to memory
+        half = _mm_unpackhi_epi8(_mm_set1_epi8(0), chunk);  //- Unpack upper half into BE 16-bit words
+        _mm_storeu_si128((__m128i*) (pDst + 8), half);      //- Write to memory
+    }
 
     //- If no bits were set in the mask, then all 16 code units were ASCII, and therefore
     //  both pointers are advanced by 16.
@@ -1247,6 +1900,35 @@ UtfUtils::ConvertAsciiWithSse(char8_t const*& pSrc, char16_t*& pDst) noexcept
 
 #endif
 
+//--------------------------------------------------------------------------------------------------
+/// \brief  Returns the number of 1-bits in an integer.
+///
+/// \param x
+///     An `int32_t` value whose number of set bits is to be determined; typically the result
+///     of a `movemask` operation.
+///
+/// \returns
+///     the number of set bits, as a `uint32_t`.
+//--------------------------------------------------------------------------------------------------
+//
+#if defined KEWB_PLATFORM_LINUX  &&  (defined KEWB_COMPILER_CLANG  ||  defined KEWB_COMPILER_GCC)
+
+    KEWB_FORCE_INLINE uint32_t
+    UtfUtils::GetBitCount(int32_t x) noexcept
+    {
+        return (uint32_t) __builtin_popcount((unsigned int) x);
+    }
+
+#elif defined KEWB_PLATFORM_WINDOWS  &&  defined KEWB_COMPILER_MSVC
+
+    KEWB_FORCE_INLINE uint32_t
+    UtfUtils::GetBitCount(int32_t x) noexcept
+    {
+        return (uint32_t) __popcnt((unsigned int) x);
+    }
+
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /// \brief  Prints state information for tracing versions of converters.
 ///
@@ -1271,4 +1953,32 @@ UtfUtils::PrintStateData(State curr, CharClass type, uint32_t unit, State next)
             smClassNames[type], unitValue, smStateNames[nextState]);
 }
 
+//- Explicit instantiations of the converters for both output byte orders.
+//
+template std::ptrdiff_t UtfUtils::BasicBigTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::BasicBigTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::FastBigTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::FastBigTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::SseBigTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::SseBigTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::BasicSmallTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::BasicSmallTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::FastSmallTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::FastSmallTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::SseSmallTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+template std::ptrdiff_t UtfUtils::SseSmallTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char32_t*) noexcept;
+
+template std::ptrdiff_t UtfUtils::BasicBigTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::BasicBigTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::FastBigTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::FastBigTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::SseBigTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::SseBigTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::BasicSmallTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::BasicSmallTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::FastSmallTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::FastSmallTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::SseSmallTableConvert<UtfUtils::LittleEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+template std::ptrdiff_t UtfUtils::SseSmallTableConvert<UtfUtils::BigEndian>(char8_t const*, char8_t const*, char16_t*) noexcept;
+
 }   //- Namespace uu
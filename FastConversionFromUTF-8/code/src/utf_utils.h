@@ -9,7 +9,7 @@
 #ifndef KEWB_UNICODE_UTILS_H_DEFINED
 #define KEWB_UNICODE_UTILS_H_DEFINED
 
-//#include <cstdint>
+#include <cstdint>
 #include <string>
 
 //- Detect the compiler; only Clang, GCC, and Visual C++ are currently supported.
@@ -83,9 +83,10 @@ namespace uu {
 ///     mechanism for reporting/handling errors.  No checking is done for null pointers; it
 ///     is assumed that the input and output pointers sensibly point to buffers that exist.
 ///
-///     Finally, please note that this was developed and tested on x64/x86 hardware, and so
-///     there is an implicit assumption that UTF-32 code points and UTF-16 code units are
-///     little endian.
+///     Finally, please note that this was developed and tested on x64/x86 hardware.  By
+///     default, UTF-32 code points and UTF-16 code units are written in little-endian (native)
+///     byte order; each conversion member function also accepts a `ByteOrder` template
+///     argument which may be used to request big-endian output instead.
 //--------------------------------------------------------------------------------------------------
 //
 class UtfUtils
@@ -94,49 +95,119 @@ class UtfUtils
     using char8_t   = unsigned char;
     using ptrdiff_t = std::ptrdiff_t;
 
+    //- Byte order of the UTF-32 code points and UTF-16 code units written by the conversion
+    //  member functions.
+    //
+    enum ByteOrder : uint8_t
+    {
+        LittleEndian = 0,
+        BigEndian    = 1,
+    };
+
   public:
     static  bool        GetCodePoint(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t& cdpt) noexcept;
 
     static  uint32_t    GetCodeUnits(char32_t cdpt, char8_t*& pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  uint32_t    GetCodeUnits(char32_t cdpt, char16_t*& pDst) noexcept;
 
     //- Conversion to UTF-32/UTF-16 using fastest typical (lookup/computation on first code unit).
     //  These member functions are wrappers to the '*BigTableConvert' and '*SmallTableConvert'
     //  member functions declared further down.
     //
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   BasicConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   FastConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   SseConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
 
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   BasicConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   FastConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   SseConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
 
     //- Conversion to UTF-32/UTF-16 using pre-computed first code unit lookup table.
     //
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
 
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   BasicBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   FastBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   SseBigTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
 
     //- Conversion to UTF-32/UTF-16 using small lookup table and masking operations on first code unit.
     //
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
 
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   BasicSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   FastSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
+    template<ByteOrder BO = LittleEndian>
     static  ptrdiff_t   SseSmallTableConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
 
+    //- Encoding detection (BOM check plus a bounded SSE scan of the input prefix), and
+    //  conversion from the detected encoding to native UTF-32/UTF-16.
+    //
+    enum Encoding : uint8_t
+    {
+        UnknownEncoding = 0,
+        Ascii           = 1,
+        Utf8            = 2,
+        Utf16LE         = 3,
+        Utf16BE         = 4,
+        Utf32LE         = 5,
+        Utf32BE         = 6,
+    };
+
+    struct EncodingInfo
+    {
+        Encoding        mEncoding;      //- The detected (or BOM-declared) encoding
+        std::uint32_t   mBomLength;     //- Length of the BOM in octets, or zero if none
+    };
+
+    static  EncodingInfo    DetectEncoding(char8_t const* pSrc, char8_t const* pSrcEnd) noexcept;
+
+    static  ptrdiff_t   AutoConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    static  ptrdiff_t   AutoConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
+
     //- Conversion that traces path through DFA, writing to stdout.
     //
     static  ptrdiff_t   ConvertWithTrace(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
     static  ptrdiff_t   ConvertWithTrace(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
 
+    //- Hot-path counters gathered by the conversion member functions.  Counting only takes
+    //  place when the library is compiled with KEWB_UTF_UTILS_COLLECT_STATS defined; otherwise
+    //  the counters remain zero and the bookkeeping compiles away.  Counters are per-thread.
+    //
+    struct ConversionStats
+    {
+        std::uint64_t   mSseBlocks;         //- Register loads performed by ConvertAsciiWithSse
+        std::uint64_t   mSsePartialBlocks;  //- SSE blocks with a non-zero movemask (non-ASCII seen)
+        std::uint64_t   mScalarAsciiUnits;  //- ASCII code units converted one at a time
+        std::uint64_t   maDfaCodePoints[4]; //- Code points decoded by the DFA, by sequence length
+        std::uint64_t   mErrors;            //- Invalid or truncated sequences encountered
+    };
+
+    static  bool            CollectingStats() noexcept;
+    static  ConversionStats GetStats() noexcept;
+    static  void            ResetStats() noexcept;
+
   private:
     enum CharClass : uint8_t
     {
@@ -193,20 +264,52 @@ class UtfUtils
     };
 
   private:
+    static  constexpr ptrdiff_t smSniffLength = 4096;
+
     static  LookupTables const  smTables;
     static  char const*         smClassNames[12];
     static  char const*         smStateNames[9];
 
+    static  thread_local ConversionStats    smStats;
+
   private:
     static  int32_t AdvanceWithBigTable(char8_t const*& pSrc, char8_t const* pSrcEnd, char32_t& cdpt) noexcept;
     static  int32_t AdvanceWithSmallTable(char8_t const*& pSrc, char8_t const* pSrcEnd, char32_t& cdpt) noexcept;
     static  State   AdvanceWithTrace(char8_t const*& pSrc, char8_t const* pSrcEnd, char32_t& cdpt) noexcept;
 
+    template<ByteOrder BO>
     static  void    ConvertAsciiWithSse(char8_t const*& pSrc, char32_t*& pDst) noexcept;
+    template<ByteOrder BO>
     static  void    ConvertAsciiWithSse(char8_t const*& pSrc, char16_t*& pDst) noexcept;
     static  int32_t GetTrailingZeros(int32_t x) noexcept;
+    static  uint32_t    GetBitCount(int32_t x) noexcept;
+
+    static  bool    IsValidUtf8Prefix(char8_t const* pSrc, char8_t const* pSrcEnd, bool isComplete) noexcept;
+
+    template<ByteOrder BO>
+    static  bool    DecodeUtf16(char8_t const*& pSrc, char8_t const* pSrcEnd, char32_t& cdpt) noexcept;
+    template<ByteOrder BO>
+    static  bool    DecodeUtf32(char8_t const*& pSrc, char8_t const* pSrcEnd, char32_t& cdpt) noexcept;
+
+    template<ByteOrder BO>
+    static  ptrdiff_t   ConvertFromUtf16(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    template<ByteOrder BO>
+    static  ptrdiff_t   ConvertFromUtf16(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
+    template<ByteOrder BO>
+    static  ptrdiff_t   ConvertFromUtf32(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept;
+    template<ByteOrder BO>
+    static  ptrdiff_t   ConvertFromUtf32(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept;
 
     static  void    PrintStateData(State curr, CharClass type, uint32_t unit, State next);
+
+    template<ByteOrder BO>
+    static  char32_t    OrderUnit(char32_t unit) noexcept;
+    template<ByteOrder BO>
+    static  char16_t    OrderUnit(char16_t unit) noexcept;
+
+    static  void    CountAsciiUnit() noexcept;
+    static  void    CountSseBlock(int32_t mask) noexcept;
+    static  void    CountSequence(ptrdiff_t length, int32_t state) noexcept;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -284,6 +387,8 @@ UtfUtils::GetCodeUnits(char32_t cdpt, char8_t*& pDst) noexcept
 ///     Note that the conversion performed by this member function is "unsafe", in that it does
 ///     not check for invalid/illegal values of the input code point.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param cdpt
 ///     A the source code unit.
 /// \param pDst
@@ -293,18 +398,19 @@ UtfUtils::GetCodeUnits(char32_t cdpt, char8_t*& pDst) noexcept
 ///     The number of UTF-16 code units resulting from the conversion of `cdpt`.
 //--------------------------------------------------------------------------------------------------
 //
+template<UtfUtils::ByteOrder BO>
 KEWB_FORCE_INLINE std::uint32_t
 UtfUtils::GetCodeUnits(char32_t cdpt, char16_t*& pDst) noexcept
 {
     if (cdpt < 0x10000)
     {
-        *pDst++ = (char16_t) cdpt;
+        *pDst++ = OrderUnit<BO>((char16_t) cdpt);
         return 1;
     }
     else
     {
-        *pDst++ = (char16_t)(0xD7C0 + (cdpt >> 10));
-        *pDst++ = (char16_t)(0xDC00 + (cdpt & 0x3FF));
+        *pDst++ = OrderUnit<BO>((char16_t)(0xD7C0 + (cdpt >> 10)));
+        *pDst++ = OrderUnit<BO>((char16_t)(0xDC00 + (cdpt & 0x3FF)));
         return 2;
     }
 }
@@ -312,6 +418,8 @@ UtfUtils::GetCodeUnits(char32_t cdpt, char16_t*& pDst) noexcept
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of UTF-8 code units to a sequence of UTF-32 code points.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -324,15 +432,18 @@ UtfUtils::GetCodeUnits(char32_t cdpt, char16_t*& pDst) noexcept
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
-KEWB_FORCE_INLINE ptrdiff_t
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE std::ptrdiff_t
 UtfUtils::BasicConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
-    return BasicBigTableConvert(pSrc, pSrcEnd, pDst);
+    return BasicBigTableConvert<BO>(pSrc, pSrcEnd, pDst);
 }
 
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of UTF-8 code units to a sequence of UTF-32 code points.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -345,15 +456,18 @@ UtfUtils::BasicConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pD
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
-KEWB_FORCE_INLINE ptrdiff_t
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE std::ptrdiff_t
 UtfUtils::FastConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
-    return FastBigTableConvert(pSrc, pSrcEnd, pDst);
+    return FastBigTableConvert<BO>(pSrc, pSrcEnd, pDst);
 }
 
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of UTF-8 code units to a sequence of UTF-32 code points.
 ///
+/// \tparam BO
+///     The byte order of the UTF-32 code points written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -366,15 +480,18 @@ UtfUtils::FastConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDs
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
-KEWB_FORCE_INLINE ptrdiff_t
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE std::ptrdiff_t
 UtfUtils::SseConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst) noexcept
 {
-    return SseBigTableConvert(pSrc, pSrcEnd, pDst);
+    return SseBigTableConvert<BO>(pSrc, pSrcEnd, pDst);
 }
 
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of UTF-8 code units to a sequence of UTF-16 code units.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -387,15 +504,18 @@ UtfUtils::SseConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char32_t* pDst
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
-KEWB_FORCE_INLINE ptrdiff_t
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE std::ptrdiff_t
 UtfUtils::BasicConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
-    return BasicBigTableConvert(pSrc, pSrcEnd, pDst);
+    return BasicBigTableConvert<BO>(pSrc, pSrcEnd, pDst);
 }
 
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of UTF-8 code units to a sequence of UTF-16 code units.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -408,15 +528,18 @@ UtfUtils::BasicConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pD
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
-KEWB_FORCE_INLINE ptrdiff_t
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE std::ptrdiff_t
 UtfUtils::FastConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
-    return FastSmallTableConvert(pSrc, pSrcEnd, pDst);
+    return FastSmallTableConvert<BO>(pSrc, pSrcEnd, pDst);
 }
 
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of UTF-8 code units to a sequence of UTF-16 code units.
 ///
+/// \tparam BO
+///     The byte order of the UTF-16 code units written to the output range.
 /// \param pSrc
 ///     A non-null pointer defining the beginning of the code unit input range.
 /// \param pSrcEnd
@@ -429,12 +552,89 @@ UtfUtils::FastConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDs
 ///     indicate an error was encountered.
 //--------------------------------------------------------------------------------------------------
 //
-KEWB_FORCE_INLINE ptrdiff_t
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE std::ptrdiff_t
 UtfUtils::SseConvert(char8_t const* pSrc, char8_t const* pSrcEnd, char16_t* pDst) noexcept
 {
-    return SseBigTableConvert(pSrc, pSrcEnd, pDst);
+    return SseBigTableConvert<BO>(pSrc, pSrcEnd, pDst);
 }
 
+//--------------------------------------------------------------------------------------------------
+/// \brief  Records the conversion of a single ASCII code unit outside of the SSE path.
+//--------------------------------------------------------------------------------------------------
+//
+#if defined KEWB_UTF_UTILS_COLLECT_STATS
+
+    KEWB_FORCE_INLINE void
+    UtfUtils::CountAsciiUnit() noexcept
+    {
+        ++smStats.mScalarAsciiUnits;
+    }
+
+#else
+
+    KEWB_FORCE_INLINE void
+    UtfUtils::CountAsciiUnit() noexcept
+    {}
+
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Records one pass through `ConvertAsciiWithSse`.
+///
+/// \param mask
+///     The `movemask` result for the register; non-zero means a non-ASCII octet was present.
+//--------------------------------------------------------------------------------------------------
+//
+#if defined KEWB_UTF_UTILS_COLLECT_STATS
+
+    KEWB_FORCE_INLINE void
+    UtfUtils::CountSseBlock(int32_t mask) noexcept
+    {
+        ++smStats.mSseBlocks;
+        smStats.mSsePartialBlocks += (mask != 0);
+    }
+
+#else
+
+    KEWB_FORCE_INLINE void
+    UtfUtils::CountSseBlock(int32_t) noexcept
+    {}
+
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Records one traversal of the DFA.
+///
+/// \param length
+///     The number of code units consumed by the traversal.
+/// \param state
+///     The final DFA state; `ERR` indicates an invalid or truncated sequence.
+//--------------------------------------------------------------------------------------------------
+//
+#if defined KEWB_UTF_UTILS_COLLECT_STATS
+
+    KEWB_FORCE_INLINE void
+    UtfUtils::CountSequence(ptrdiff_t length, int32_t state) noexcept
+    {
+        if (state == ERR)
+        {
+            ++smStats.mErrors;
+        }
+        else
+        {
+            ++smStats.maDfaCodePoints[(length - 1) & 3];
+        }
+    }
+
+#else
+
+    KEWB_FORCE_INLINE void
+    UtfUtils::CountSequence(ptrdiff_t, int32_t) noexcept
+    {}
+
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /// \brief  Converts a sequence of UTF-8 code units to a UTF-32 code point.
 ///
@@ -463,6 +663,8 @@ UtfUtils::AdvanceWithBigTable(char8_t const*& pSrc, char8_t const* const pSrcEnd
     int32_t         type;   //- The current code unit's character class
     int32_t         curr;   //- The current DFA state
 
+    char8_t const*  pOrig = pSrc;   //- The first code unit, for statistics
+
     info = smTables.maFirstUnitTable[*pSrc++];              //- Look up the first code unit descriptor
     cdpt = info.mFirstOctet;                                //- From it, get the initial code point value
     curr = info.mNextState;                                 //- From it, get the second state
@@ -478,9 +680,11 @@ UtfUtils::AdvanceWithBigTable(char8_t const*& pSrc, char8_t const* const pSrcEnd
         }
         else
         {
+            CountSequence(pSrc - pOrig, ERR);
             return ERR;
         }
     }
+    CountSequence(pSrc - pOrig, curr);
     return curr;
 }
 
@@ -511,6 +715,8 @@ UtfUtils::AdvanceWithSmallTable(char8_t const*& pSrc, char8_t const* const pSrcE
     int32_t     type;   //- The current code unit's character class
     int32_t     curr;   //- The current DFA state
 
+    char8_t const*  pOrig = pSrc;   //- The first code unit, for statistics
+
     unit = *pSrc++;                                         //- Cache the first code unit
     type = smTables.maOctetCategory[unit];                  //- Get the first code unit's character class
     cdpt = smTables.maFirstOctetMask[type] & unit;          //- Apply the first octet mask 
@@ -527,9 +733,11 @@ UtfUtils::AdvanceWithSmallTable(char8_t const*& pSrc, char8_t const* const pSrcE
         }
         else
         {
+            CountSequence(pSrc - pOrig, ERR);
             return ERR;
         }
     }
+    CountSequence(pSrc - pOrig, curr);
     return curr;
 }
 
@@ -587,5 +795,65 @@ UtfUtils::AdvanceWithTrace(char8_t const*& pSrc, char8_t const* pSrcEnd, char32_
     return next;
 }
 
+//--------------------------------------------------------------------------------------------------
+/// \brief  Places a UTF-32 code point into the requested output byte order.
+///
+/// \tparam BO
+///     The byte order of the result.
+/// \param unit
+///     The code point, in native (little-endian) byte order.
+///
+/// \returns
+///     `unit` unchanged for little-endian output; otherwise `unit` with its bytes reversed.
+//--------------------------------------------------------------------------------------------------
+//
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE char32_t
+UtfUtils::OrderUnit(char32_t unit) noexcept
+{
+    if (BO == LittleEndian)
+    {
+        return unit;
+    }
+    else
+    {
+#if defined KEWB_COMPILER_MSVC
+        return (char32_t) _byteswap_ulong((unsigned long) unit);
+#else
+        return (char32_t) __builtin_bswap32((uint32_t) unit);
+#endif
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/// \brief  Places a UTF-16 code unit into the requested output byte order.
+///
+/// \tparam BO
+///     The byte order of the result.
+/// \param unit
+///     The code unit, in native (little-endian) byte order.
+///
+/// \returns
+///     `unit` unchanged for little-endian output; otherwise `unit` with its bytes reversed.
+//--------------------------------------------------------------------------------------------------
+//
+template<UtfUtils::ByteOrder BO>
+KEWB_FORCE_INLINE char16_t
+UtfUtils::OrderUnit(char16_t unit) noexcept
+{
+    if (BO == LittleEndian)
+    {
+        return unit;
+    }
+    else
+    {
+#if defined KEWB_COMPILER_MSVC
+        return (char16_t) _byteswap_ushort((unsigned short) unit);
+#else
+        return (char16_t) __builtin_bswap16((uint16_t) unit);
+#endif
+    }
+}
+
 }       //- namespace uu
 #endif  //- KEWB_UNICODE_UTILS_H_DEFINED
@@ -0,0 +1,598 @@
+//==================================================================================================
+//  File:       fuzz_conversions.cpp
+//
+//  Summary:    Fuzzing / differential-testing harness for the UtfUtils converters.  Every input
+//              is fed to all of the UtfUtils conversion member functions, whose error decisions
+//              and outputs are checked against each other and against the reference decoders.
+//
+//              When built with KEWB_UTF_UTILS_LIBFUZZER defined, this file provides only the
+//              libFuzzer entry point (LLVMFuzzerTestOneInput).  Otherwise it also provides a
+//              standalone driver that generates random and mutated inputs, so that it can be
+//              run offline without any fuzzing engine (or used as an AFL target via -af).
+//==================================================================================================
+//
+#include "test_main.h"
+
+#include <map>
+#include <random>
+
+using namespace std;
+using namespace uu;
+
+using Conv32 = ptrdiff_t (*)(char8_t const*, char8_t const*, char32_t*);
+using Conv16 = ptrdiff_t (*)(char8_t const*, char8_t const*, char16_t*);
+
+namespace {
+
+struct Named32
+{
+    char const* mName;
+    Conv32      mLittle;
+    Conv32      mBig;
+};
+
+struct Named16
+{
+    char const* mName;
+    Conv16      mLittle;
+    Conv16      mBig;
+};
+
+Named32 const   sConverters32[] =
+{
+    { "BasicBigTableConvert",   UtfUtils::BasicBigTableConvert<UtfUtils::LittleEndian>,   UtfUtils::BasicBigTableConvert<UtfUtils::BigEndian>   },
+    { "FastBigTableConvert",    UtfUtils::FastBigTableConvert<UtfUtils::LittleEndian>,    UtfUtils::FastBigTableConvert<UtfUtils::BigEndian>    },
+    { "SseBigTableConvert",     UtfUtils::SseBigTableConvert<UtfUtils::LittleEndian>,     UtfUtils::SseBigTableConvert<UtfUtils::BigEndian>     },
+    { "BasicSmallTableConvert", UtfUtils::BasicSmallTableConvert<UtfUtils::LittleEndian>, UtfUtils::BasicSmallTableConvert<UtfUtils::BigEndian> },
+    { "FastSmallTableConvert",  UtfUtils::FastSmallTableConvert<UtfUtils::LittleEndian>,  UtfUtils::FastSmallTableConvert<UtfUtils::BigEndian>  },
+    { "SseSmallTableConvert",   UtfUtils::SseSmallTableConvert<UtfUtils::LittleEndian>,   UtfUtils::SseSmallTableConvert<UtfUtils::BigEndian>   },
+};
+
+Named16 const   sConverters16[] =
+{
+    { "BasicBigTableConvert",   UtfUtils::BasicBigTableConvert<UtfUtils::LittleEndian>,   UtfUtils::BasicBigTableConvert<UtfUtils::BigEndian>   },
+    { "FastBigTableConvert",    UtfUtils::FastBigTableConvert<UtfUtils::LittleEndian>,    UtfUtils::FastBigTableConvert<UtfUtils::BigEndian>    },
+    { "SseBigTableConvert",     UtfUtils::SseBigTableConvert<UtfUtils::LittleEndian>,     UtfUtils::SseBigTableConvert<UtfUtils::BigEndian>     },
+    { "BasicSmallTableConvert", UtfUtils::BasicSmallTableConvert<UtfUtils::LittleEndian>, UtfUtils::BasicSmallTableConvert<UtfUtils::BigEndian> },
+    { "FastSmallTableConvert",  UtfUtils::FastSmallTableConvert<UtfUtils::LittleEndian>,  UtfUtils::FastSmallTableConvert<UtfUtils::BigEndian>  },
+    { "SseSmallTableConvert",   UtfUtils::SseSmallTableConvert<UtfUtils::LittleEndian>,   UtfUtils::SseSmallTableConvert<UtfUtils::BigEndian>   },
+};
+
+uint8_t const*      sCurrData = nullptr;
+size_t              sCurrSize = 0;
+map<string, size_t> sDefects;
+
+//--------------
+//
+void
+PrintInput()
+{
+    printf("    input (%zu octets):", sCurrSize);
+
+    for (size_t i = 0;  i < sCurrSize  &&  i < 256;  ++i)
+    {
+        printf("%s%02X", (i % 16) ? " " : "\n    ", sCurrData[i]);
+    }
+    printf("%s\n", (sCurrSize > 256) ? "\n    ..." : "");
+    fflush(stdout);
+}
+
+//- A disagreement between a UtfUtils converter and LLVM ConvertUTF (or between UtfUtils
+//  converters) is fatal, so that a fuzzing engine records the input.
+//
+[[noreturn]] void
+Fail(char const* what, char const* name)
+{
+    printf("\nerror: %s (%s)\n", what, name);
+    PrintInput();
+    abort();
+}
+
+//- A disagreement between one of the other reference decoders and LLVM ConvertUTF, once the
+//  UtfUtils converters have agreed with LLVM, is a defect in that reference.  These are
+//  tallied, and the first input exhibiting each one is printed.
+//
+void
+NoteDefect(char const* what, char const* name)
+{
+    if (sDefects[name]++ == 0)
+    {
+        printf("\nnote: %s (%s)\n", what, name);
+        PrintInput();
+    }
+}
+
+//--------------
+//
+template<class CharT>
+void
+CheckReference(char const* name, ptrdiff_t expLen, CharT const* pExp, ptrdiff_t len, CharT const* pDst)
+{
+    if (len != expLen  ||  (len > 0  &&  memcmp(pExp, pDst, len * sizeof(CharT)) != 0))
+    {
+        NoteDefect("reference result differs from LLVM ConvertUTF", name);
+    }
+}
+
+//--------------
+//
+template<class CharT>
+CharT
+SwapUnit(CharT unit)
+{
+    CharT   swap = 0;
+
+    for (size_t j = 0;  j < sizeof(CharT);  ++j)
+    {
+        swap = (CharT) ((swap << 8) | ((unit >> (8 * j)) & 0xFF));
+    }
+    return swap;
+}
+
+//--------------
+//
+template<class CharT>
+ptrdiff_t
+IconvConvert(char const* toCode, char8_t const* pSrc, size_t srcLen, CharT* pDst, size_t dstLen)
+{
+    iconv_t     desc    = iconv_open(toCode, "UTF-8");
+    char*       pSrcBuf = (char*) pSrc;
+    char*       pDstBuf = (char*) pDst;
+    size_t      dstLeft = dstLen * sizeof(CharT);
+
+    if (desc == (iconv_t)(-1))
+    {
+        Fail("iconv_open() failed", toCode);
+    }
+
+    size_t  rc = iconv(desc, &pSrcBuf, &srcLen, &pDstBuf, &dstLeft);
+
+    iconv_close(desc);
+    return (rc == (size_t)(-1)) ? -1 : (CharT*) pDstBuf - pDst;
+}
+
+//--------------
+//
+template<class CharT>
+ptrdiff_t
+BoostConvert(char8_t const* pSrc, char8_t const* pSrcEnd, CharT* pDst)
+{
+    using iter = typename conditional<sizeof(CharT) == 4,
+                                      boost::text::utf8::to_utf32_iterator<char8_t const*>,
+                                      boost::text::utf8::to_utf16_iterator<char8_t const*>>::type;
+
+    return copy(iter(pSrc, pSrc, pSrcEnd), iter(pSrc, pSrcEnd, pSrcEnd), pDst) - pDst;
+}
+
+//--------------
+//
+template<class CharT>
+void
+CheckEqual(char const* name, ptrdiff_t expLen, CharT const* pExp, ptrdiff_t len, CharT const* pDst)
+{
+    if (len != expLen)
+    {
+        Fail("result length or validity differs from LLVM ConvertUTF", name);
+    }
+    if (len > 0  &&  memcmp(pExp, pDst, len * sizeof(CharT)) != 0)
+    {
+        Fail("result differs from LLVM ConvertUTF", name);
+    }
+}
+
+//- AutoConvert strips a UTF-8 BOM, so it must produce the reference result less its leading
+//  U+FEFF.  Input sniffed as UTF-16/UTF-32 is checked separately by CheckDetection().
+//
+template<class CharT>
+void
+CheckAutoConvert(char8_t const* pSrc, char8_t const* pSrcEnd, ptrdiff_t refLen, CharT const* pRef, CharT* pDst)
+{
+    UtfUtils::EncodingInfo  info = UtfUtils::DetectEncoding(pSrc, pSrcEnd);
+
+    if (info.mEncoding >= UtfUtils::Utf16LE)
+    {
+        return;
+    }
+    if (info.mBomLength != 0  &&  refLen > 0)
+    {
+        ++pRef;
+        --refLen;
+    }
+    CheckEqual("AutoConvert", refLen, pRef, UtfUtils::AutoConvert(pSrc, pSrcEnd, pDst), pDst);
+}
+
+//--------------
+//
+void
+CheckUtf32(char8_t const* pSrc, char8_t const* pSrcEnd)
+{
+    size_t          srcLen = pSrcEnd - pSrc;
+    u32string       ref(srcLen + 32, 0);
+    u32string       dst(srcLen + 32, 0);
+    UTF8 const*     pLlvmSrc = pSrc;
+    UTF32*          pLlvmDst = (UTF32*) &ref[0];
+
+    //- LLVM in strict mode is the arbiter of validity.
+    //
+    ConversionResult    res = ConvertUTF8toUTF32(&pLlvmSrc, pSrcEnd, &pLlvmDst,
+                                                 pLlvmDst + ref.size(), strictConversion);
+    ptrdiff_t           refLen = (res == conversionOK) ? pLlvmDst - (UTF32*) &ref[0] : -1;
+
+    //- Every UtfUtils converter, in both byte orders, must agree with it.
+    //
+    for (Named32 const& conv : sConverters32)
+    {
+        CheckEqual(conv.mName, refLen, &ref[0], conv.mLittle(pSrc, pSrcEnd, &dst[0]), &dst[0]);
+
+        ptrdiff_t   len = conv.mBig(pSrc, pSrcEnd, &dst[0]);
+
+        for (ptrdiff_t i = 0;  i < len;  ++i)
+        {
+            dst[i] = SwapUnit(dst[i]);
+        }
+        CheckEqual(conv.mName, refLen, &ref[0], len, &dst[0]);
+    }
+
+    CheckAutoConvert(pSrc, pSrcEnd, refLen, &ref[0], &dst[0]);
+
+    //- iconv and AV also report errors, so check their decisions before their outputs.  The
+    //  other references do not report errors, so only their outputs for valid input are
+    //  compared.
+    //
+    ptrdiff_t   len = IconvConvert("UTF-32LE", pSrc, srcLen, &dst[0], dst.size());
+
+    if ((len < 0) != (refLen < 0))
+    {
+        NoteDefect("validity decision differs from LLVM ConvertUTF", "iconv UTF-32LE");
+    }
+    else if (refLen >= 0)
+    {
+        CheckReference("iconv UTF-32LE", refLen, &ref[0], len, &dst[0]);
+    }
+
+    len = (ptrdiff_t) utf8_to_wchar((char const*) pSrc, srcLen, (int32_t*) &dst[0], dst.size(), 0);
+
+    if (srcLen != 0  &&  (len == 0) != (refLen < 0))
+    {
+        NoteDefect("validity decision differs from LLVM ConvertUTF", "av utf8_to_wchar");
+    }
+    else if (refLen >= 0)
+    {
+        CheckReference("av utf8_to_wchar", refLen, &ref[0], len, &dst[0]);
+    }
+
+    if (refLen >= 0)
+    {
+        CheckReference("hoehrmann", refLen, &ref[0], toUtf32(pSrc, srcLen, &dst[0]), &dst[0]);
+        CheckReference("Boost.Text", refLen, &ref[0], BoostConvert(pSrc, pSrcEnd, &dst[0]), &dst[0]);
+    }
+}
+
+//--------------
+//
+void
+CheckUtf16(char8_t const* pSrc, char8_t const* pSrcEnd)
+{
+    size_t          srcLen = pSrcEnd - pSrc;
+    u16string       ref(srcLen + 32, 0);
+    u16string       dst(srcLen + 32, 0);
+    UTF8 const*     pLlvmSrc = pSrc;
+    UTF16*          pLlvmDst = (UTF16*) &ref[0];
+
+    ConversionResult    res = ConvertUTF8toUTF16(&pLlvmSrc, pSrcEnd, &pLlvmDst,
+                                                 pLlvmDst + ref.size(), strictConversion);
+    ptrdiff_t           refLen = (res == conversionOK) ? pLlvmDst - (UTF16*) &ref[0] : -1;
+
+    for (Named16 const& conv : sConverters16)
+    {
+        CheckEqual(conv.mName, refLen, &ref[0], conv.mLittle(pSrc, pSrcEnd, &dst[0]), &dst[0]);
+
+        ptrdiff_t   len = conv.mBig(pSrc, pSrcEnd, &dst[0]);
+
+        for (ptrdiff_t i = 0;  i < len;  ++i)
+        {
+            dst[i] = SwapUnit(dst[i]);
+        }
+        CheckEqual(conv.mName, refLen, &ref[0], len, &dst[0]);
+    }
+
+    CheckAutoConvert(pSrc, pSrcEnd, refLen, &ref[0], &dst[0]);
+
+    ptrdiff_t   len = IconvConvert("UTF-16LE", pSrc, srcLen, &dst[0], dst.size());
+
+    if ((len < 0) != (refLen < 0))
+    {
+        NoteDefect("validity decision differs from LLVM ConvertUTF", "iconv UTF-16LE");
+    }
+    else if (refLen >= 0)
+    {
+        CheckReference("iconv UTF-16LE", refLen, &ref[0], len, &dst[0]);
+    }
+
+    if (refLen >= 0)
+    {
+        CheckReference("hoehrmann", refLen, &ref[0], toUtf16(pSrc, srcLen, &dst[0]), &dst[0]);
+        CheckReference("Boost.Text", refLen, &ref[0], BoostConvert(pSrc, pSrcEnd, &dst[0]), &dst[0]);
+    }
+}
+
+//--------------
+//
+template<class CharT>
+string
+EncodeWithBom(u32string const& src, bool bigEndian)
+{
+    string  octets;
+
+    auto    put = [&](char32_t unit)
+    {
+        for (size_t j = 0;  j < sizeof(CharT);  ++j)
+        {
+            size_t  shift = bigEndian ? (8 * (sizeof(CharT) - 1 - j)) : (8 * j);
+            octets.push_back((char) ((unit >> shift) & 0xFF));
+        }
+    };
+
+    put(0xFEFF);
+    for (char32_t cdpt : src)
+    {
+        if (sizeof(CharT) == 2  &&  cdpt >= 0x10000)
+        {
+            put(0xD7C0 + (cdpt >> 10));
+            put(0xDC00 + (cdpt & 0x3FF));
+        }
+        else
+        {
+            put(cdpt);
+        }
+    }
+    return octets;
+}
+
+//--------------
+//
+void
+CheckDetection(char8_t const* pSrc, char8_t const* pSrcEnd)
+{
+    UtfUtils::EncodingInfo  info = UtfUtils::DetectEncoding(pSrc, pSrcEnd);
+
+    if (info.mEncoding == UtfUtils::Ascii)
+    {
+        for (char8_t const* p = pSrc;  p < pSrcEnd  &&  p < pSrc + 4096;  ++p)
+        {
+            if (*p >= 0x80)
+            {
+                Fail("non-ASCII input detected as ASCII", "DetectEncoding");
+            }
+        }
+    }
+
+    //- For valid input, re-encode the code points as UTF-16/UTF-32 with a BOM in each byte
+    //  order; AutoConvert must recover the original code points from all of them.  The one
+    //  exception is UTF-16LE starting with U+0000, whose BOM is indistinguishable from the
+    //  UTF-32LE BOM.
+    //
+    u32string   cdpts((pSrcEnd - pSrc) + 32, 0);
+    ptrdiff_t   len = UtfUtils::SseConvert(pSrc, pSrcEnd, &cdpts[0]);
+
+    if (len < 0)
+    {
+        return;
+    }
+    cdpts.resize(len);
+
+    string const    encoded[] =
+    {
+        EncodeWithBom<char16_t>(cdpts, false),
+        EncodeWithBom<char16_t>(cdpts, true),
+        EncodeWithBom<char32_t>(cdpts, false),
+        EncodeWithBom<char32_t>(cdpts, true),
+    };
+
+    for (string const& src : encoded)
+    {
+        char8_t const*  pEnc = (char8_t const*) src.data();
+        u32string       dst(src.size(), 0);
+
+        if (&src == &encoded[0]  &&  len > 0  &&  cdpts[0] == 0)
+        {
+            continue;
+        }
+        if (UtfUtils::AutoConvert(pEnc, pEnc + src.size(), &dst[0]) != len  ||
+            memcmp(&dst[0], cdpts.data(), len * sizeof(char32_t)) != 0)
+        {
+            Fail("round trip through UTF-16/UTF-32 input differs", "AutoConvert");
+        }
+    }
+}
+
+}   //- anonymous namespace
+
+//--------------
+//
+extern "C" int
+LLVMFuzzerTestOneInput(uint8_t const* pData, size_t size)
+{
+    char8_t const*  pSrc = (char8_t const*) pData;
+
+    sCurrData = pData;
+    sCurrSize = size;
+
+    CheckUtf32(pSrc, pSrc + size);
+    CheckUtf16(pSrc, pSrc + size);
+    CheckDetection(pSrc, pSrc + size);
+
+    return 0;
+}
+
+#ifndef KEWB_UTF_UTILS_LIBFUZZER
+
+namespace {
+
+//- Octet sequences that exercise the DFA's edge cases; mutations splice these into inputs.
+//
+vector<string> const    sInteresting =
+{
+    "\xC0\xAF", "\xC1\xBF", "\xC2\x80", "\xDF\xBF", "\xE0\x80\xAF", "\xE0\x9F\xBF", "\xE0\xA0\x80",
+    "\xED\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xEF\xBF\xBF", "\xF0\x8F\xBF\xBF",
+    "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF8\x88\x80\x80\x80",
+    "\xFE", "\xFF", "\x80", "\xBF", "\xEF\xBB\xBF", "\xFF\xFE", "\xFE\xFF", string("\0\0", 2),
+    "\xCE\xBA\xE1\xBD\xB9\xCF\x83\xCE\xBC\xCE\xB5", "\xE6\x97\xA5\xE6\x9C\xAC", "\xF0\x9D\x84\x9E",
+};
+
+//--------------
+//
+string
+MakeRandomInput(mt19937_64& rng, vector<string> const& corpus)
+{
+    uniform_int_distribution<size_t>    pick(0, 1u << 20);
+    string                              data;
+
+    //- Start from a slice of a corpus file, an ASCII run (to reach the SSE paths), or
+    //  nothing at all.
+    //
+    size_t  start = pick(rng) % 4;
+
+    if (start == 0  &&  !corpus.empty())
+    {
+        string const&   file = corpus[pick(rng) % corpus.size()];
+        size_t          from = pick(rng) % (file.size() + 1);
+
+        data = file.substr(from, 1 + pick(rng) % 512);
+    }
+    else if (start <= 1)
+    {
+        data.assign(pick(rng) % 80, 'a' + (char) (pick(rng) % 26));
+    }
+
+    //- Then apply a handful of mutations.
+    //
+    size_t  count = 1 + pick(rng) % 8;
+
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        size_t  pos = data.empty() ? 0 : pick(rng) % (data.size() + 1);
+
+        switch (pick(rng) % 6)
+        {
+            case 0:     //- Insert an interesting sequence
+                data.insert(pos, sInteresting[pick(rng) % sInteresting.size()]);
+                break;
+            case 1:     //- Insert random octets
+                data.insert(pos, string(1 + pick(rng) % 4, (char) pick(rng)));
+                break;
+            case 2:     //- Overwrite one octet
+                if (pos < data.size()) data[pos] = (char) pick(rng);
+                break;
+            case 3:     //- Flip one bit
+                if (pos < data.size()) data[pos] ^= (char) (1 << (pick(rng) % 8));
+                break;
+            case 4:     //- Truncate
+                data.resize(pos);
+                break;
+            default:    //- Insert an ASCII run
+                data.insert(pos, string(pick(rng) % 40, ' '));
+                break;
+        }
+    }
+    return data;
+}
+
+//--------------
+//
+void
+PrintUsage()
+{
+    printf("usage: utf_utils_fuzz [-n count] [-s seed] [-dd data_dir] [file ...]\n"
+           "       utf_utils_fuzz -af\n"
+           "    -n    number of generated inputs to check (default 100000)\n"
+           "    -s    random seed (default 1)\n"
+           "    -dd   directory containing the test_data files to use as a mutation corpus\n"
+           "    -af   read a single input from stdin (for use as an AFL target)\n"
+           "    files are checked as-is, before any generated inputs\n");
+}
+
+}   //- anonymous namespace
+
+//--------------
+//
+int
+main(int argc, char* argv[])
+{
+    size_t          count = 100000;
+    uint64_t        seed  = 1;
+    string          dataDir;
+    vector<string>  inputs;
+    vector<string>  corpus;
+
+    for (int i = 1;  i < argc;  ++i)
+    {
+        string  arg(argv[i]);
+
+        if (arg == "-n"  &&  i + 1 < argc)
+        {
+            count = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-s"  &&  i + 1 < argc)
+        {
+            seed = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-dd"  &&  i + 1 < argc)
+        {
+            dataDir = argv[++i];
+        }
+        else if (arg == "-af")
+        {
+            string  data((istreambuf_iterator<char>(cin)), istreambuf_iterator<char>());
+            return LLVMFuzzerTestOneInput((uint8_t const*) data.data(), data.size());
+        }
+        else if (arg[0] == '-')
+        {
+            PrintUsage();
+            return -1;
+        }
+        else
+        {
+            inputs.push_back(arg);
+        }
+    }
+
+    for (string const& file : inputs)
+    {
+        string  data = LoadFile(file);
+        LLVMFuzzerTestOneInput((uint8_t const*) data.data(), data.size());
+    }
+
+    if (!dataDir.empty())
+    {
+        file_list   files;
+
+        MakeFileList(files);
+        for (string const& file : files)
+        {
+            corpus.push_back(LoadFile(MakeFilePath(dataDir, file)));
+        }
+    }
+
+    mt19937_64     rng(seed);
+
+    printf("checking %zu generated inputs (seed %llu, %zu corpus files)...\n",
+           count, (unsigned long long) seed, corpus.size());
+
+    for (size_t i = 0;  i < count;  ++i)
+    {
+        string  data = MakeRandomInput(rng, corpus);
+        LLVMFuzzerTestOneInput((uint8_t const*) data.data(), data.size());
+    }
+
+    printf("    ... no errors found\n");
+
+    for (auto const& defect : sDefects)
+    {
+        printf("    reference %s disagreed with LLVM ConvertUTF on %zu inputs\n",
+               defect.first.c_str(), defect.second);
+    }
+    return 0;
+}
+
+#endif  //- KEWB_UTF_UTILS_LIBFUZZER
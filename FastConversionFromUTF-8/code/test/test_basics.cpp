@@ -138,3 +138,281 @@ TestRoundTripping()
     if (errors == 0) printf("    ... no errors found\n");
 }
 
+
+//--------------
+//
+void
+TestStats()
+{
+    string      sample{u8R"(ASCII runs, then 'kosme' : "κόσμε", then 日本語 and 𝄞 to finish.)"};
+    char8_t*    pSrc = (char8_t*) &sample[0];
+    u32string   dst(sample.size(), '0');
+
+    printf("\ntesting hot-path statistics...\n");
+
+    if (!UtfUtils::CollectingStats())
+    {
+        printf("    ... skipped (build with KEWB_UTF_UTILS_COLLECT_STATS to enable)\n");
+        return;
+    }
+
+    UtfUtils::ResetStats();
+    UtfUtils::SseConvert(pSrc, pSrc + sample.size(), &dst[0]);
+
+    UtfUtils::ConversionStats   stats = UtfUtils::GetStats();
+
+    printf("    SSE blocks: %llu (%llu partial),  scalar ASCII: %llu,  errors: %llu\n",
+           (unsigned long long) stats.mSseBlocks, (unsigned long long) stats.mSsePartialBlocks,
+           (unsigned long long) stats.mScalarAsciiUnits, (unsigned long long) stats.mErrors);
+    printf("    DFA code points by length: %llu / %llu / %llu / %llu\n",
+           (unsigned long long) stats.maDfaCodePoints[0], (unsigned long long) stats.maDfaCodePoints[1],
+           (unsigned long long) stats.maDfaCodePoints[2], (unsigned long long) stats.maDfaCodePoints[3]);
+
+    //- AutoConvert sniffs the input before dispatching to SseConvert; the sniff must not be
+    //  counted, so its counters must match those of the direct call exactly.
+    //
+    UtfUtils::ResetStats();
+    UtfUtils::AutoConvert(pSrc, pSrc + sample.size(), &dst[0]);
+
+    UtfUtils::ConversionStats   autoStats = UtfUtils::GetStats();
+    bool                        sameStats = true;
+
+    sameStats = sameStats  &&  autoStats.mSseBlocks == stats.mSseBlocks;
+    sameStats = sameStats  &&  autoStats.mSsePartialBlocks == stats.mSsePartialBlocks;
+    sameStats = sameStats  &&  autoStats.mScalarAsciiUnits == stats.mScalarAsciiUnits;
+    sameStats = sameStats  &&  autoStats.mErrors == stats.mErrors;
+
+    for (int i = 0;  i < 4;  ++i)
+    {
+        sameStats = sameStats  &&  autoStats.maDfaCodePoints[i] == stats.maDfaCodePoints[i];
+    }
+
+    if (stats.maDfaCodePoints[1] != 5  ||  stats.maDfaCodePoints[2] != 3  ||
+        stats.maDfaCodePoints[3] != 1  ||  stats.mErrors != 0)
+    {
+        printf("error: unexpected DFA statistics\n");
+    }
+    else if (!sameStats)
+    {
+        printf("error: AutoConvert statistics differ from those of SseConvert\n");
+    }
+    else
+    {
+        printf("    ... no errors found\n");
+    }
+}
+
+//--------------
+//
+template<class CharT>
+bool
+CheckByteOrder(char const* name, string const& sample,
+               ptrdiff_t (*leConv)(char8_t const*, char8_t const*, CharT*),
+               ptrdiff_t (*beConv)(char8_t const*, char8_t const*, CharT*))
+{
+    char8_t const*          pSrc = (char8_t const*) sample.data();
+    basic_string<CharT>     le(sample.size() + 16, 0);
+    basic_string<CharT>     be(sample.size() + 16, 0);
+    ptrdiff_t               leLen = leConv(pSrc, pSrc + sample.size(), &le[0]);
+    ptrdiff_t               beLen = beConv(pSrc, pSrc + sample.size(), &be[0]);
+    bool                    same  = (leLen == beLen  &&  leLen > 0);
+
+    for (ptrdiff_t i = 0;  same  &&  i < leLen;  ++i)
+    {
+        CharT   unit = le[i];
+        CharT   swap = 0;
+
+        for (size_t j = 0;  j < sizeof(CharT);  ++j)
+        {
+            swap = (CharT) ((swap << 8) | ((unit >> (8 * j)) & 0xFF));
+        }
+        same = (swap == be[i]);
+    }
+
+    if (!same)
+    {
+        printf("error: big-endian output of %s differs from little-endian\n", name);
+    }
+    return same;
+}
+
+void
+TestByteOrder()
+{
+    string  sample{u8R"(A long run of plain ASCII text, then 'kosme' : "κόσμε", then another )"
+                   u8R"(long run of ASCII text, followed by 日本語 and 𝄞 and a final ASCII tail.)"};
+    bool    good = true;
+
+    printf("\ntesting big-endian output against little-endian output...\n");
+
+    good &= CheckByteOrder<char32_t>("BasicBigTableConvert32", sample,
+                UtfUtils::BasicBigTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::BasicBigTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char32_t>("FastBigTableConvert32", sample,
+                UtfUtils::FastBigTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::FastBigTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char32_t>("SseBigTableConvert32", sample,
+                UtfUtils::SseBigTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::SseBigTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char32_t>("BasicSmallTableConvert32", sample,
+                UtfUtils::BasicSmallTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::BasicSmallTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char32_t>("FastSmallTableConvert32", sample,
+                UtfUtils::FastSmallTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::FastSmallTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char32_t>("SseSmallTableConvert32", sample,
+                UtfUtils::SseSmallTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::SseSmallTableConvert<UtfUtils::BigEndian>);
+
+    good &= CheckByteOrder<char16_t>("BasicBigTableConvert16", sample,
+                UtfUtils::BasicBigTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::BasicBigTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char16_t>("FastBigTableConvert16", sample,
+                UtfUtils::FastBigTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::FastBigTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char16_t>("SseBigTableConvert16", sample,
+                UtfUtils::SseBigTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::SseBigTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char16_t>("BasicSmallTableConvert16", sample,
+                UtfUtils::BasicSmallTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::BasicSmallTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char16_t>("FastSmallTableConvert16", sample,
+                UtfUtils::FastSmallTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::FastSmallTableConvert<UtfUtils::BigEndian>);
+    good &= CheckByteOrder<char16_t>("SseSmallTableConvert16", sample,
+                UtfUtils::SseSmallTableConvert<UtfUtils::LittleEndian>,
+                UtfUtils::SseSmallTableConvert<UtfUtils::BigEndian>);
+
+    if (good)
+    {
+        printf("    ... no errors found\n");
+    }
+}
+
+//--------------
+//
+template<class CharT>
+string
+EncodeAs(u32string const& src, bool bigEndian, bool withBom)
+{
+    basic_string<CharT>     units;
+    string                  octets;
+
+    if (withBom)
+    {
+        units.push_back((CharT) 0xFEFF);
+    }
+    for (char32_t cdpt : src)
+    {
+        if (sizeof(CharT) == 2  &&  cdpt >= 0x10000)
+        {
+            units.push_back((CharT) (0xD7C0 + (cdpt >> 10)));
+            units.push_back((CharT) (0xDC00 + (cdpt & 0x3FF)));
+        }
+        else
+        {
+            units.push_back((CharT) cdpt);
+        }
+    }
+    for (CharT unit : units)
+    {
+        for (size_t j = 0;  j < sizeof(CharT);  ++j)
+        {
+            size_t  shift = bigEndian ? (8 * (sizeof(CharT) - 1 - j)) : (8 * j);
+            octets.push_back((char) ((unit >> shift) & 0xFF));
+        }
+    }
+    return octets;
+}
+
+void
+TestDetectEncoding()
+{
+    using enc = UtfUtils::Encoding;
+
+    string      ascii{"Plain ASCII text which is long enough to cover a few SSE registers."};
+    string      sample{u8R"(Mostly Latin text, with 'kosme' : "κόσμε", 日本語 and 𝄞 mixed in.)"};
+    char8_t*    pSmp = (char8_t*) &sample[0];
+    u32string   utf32(sample.size(), 0);
+    u16string   utf16(sample.size(), 0);
+    bool        good = true;
+
+    printf("\ntesting encoding detection and automatic conversion...\n");
+
+    utf32.resize(UtfUtils::SseConvert(pSmp, pSmp + sample.size(), &utf32[0]));
+    utf16.resize(UtfUtils::SseConvert(pSmp, pSmp + sample.size(), &utf16[0]));
+
+    vector<tuple<char const*, string, enc, uint32_t>>   cases =
+    {
+        make_tuple("ASCII",             ascii,                                  enc::Ascii,   0u),
+        make_tuple("UTF-8",             sample,                                 enc::Utf8,    0u),
+        make_tuple("UTF-8 + BOM",       "\xEF\xBB\xBF" + sample,                enc::Utf8,    3u),
+        make_tuple("UTF-16LE",          EncodeAs<char16_t>(utf32, false, false), enc::Utf16LE, 0u),
+        make_tuple("UTF-16BE",          EncodeAs<char16_t>(utf32, true,  false), enc::Utf16BE, 0u),
+        make_tuple("UTF-16LE + BOM",    EncodeAs<char16_t>(utf32, false, true),  enc::Utf16LE, 2u),
+        make_tuple("UTF-16BE + BOM",    EncodeAs<char16_t>(utf32, true,  true),  enc::Utf16BE, 2u),
+        make_tuple("UTF-32LE",          EncodeAs<char32_t>(utf32, false, false), enc::Utf32LE, 0u),
+        make_tuple("UTF-32BE",          EncodeAs<char32_t>(utf32, true,  false), enc::Utf32BE, 0u),
+        make_tuple("UTF-32LE + BOM",    EncodeAs<char32_t>(utf32, false, true),  enc::Utf32LE, 4u),
+        make_tuple("UTF-32BE + BOM",    EncodeAs<char32_t>(utf32, true,  true),  enc::Utf32BE, 4u),
+    };
+
+    for (auto const& test : cases)
+    {
+        string const&           src  = get<1>(test);
+        char8_t const*          pSrc = (char8_t const*) src.data();
+        UtfUtils::EncodingInfo  info = UtfUtils::DetectEncoding(pSrc, pSrc + src.size());
+
+        if (info.mEncoding != get<2>(test)  ||  info.mBomLength != get<3>(test))
+        {
+            printf("error: %s detected as encoding %d with BOM length %u\n", get<0>(test),
+                   (int) info.mEncoding, (unsigned) info.mBomLength);
+            good = false;
+            continue;
+        }
+        if (info.mEncoding == enc::Ascii)
+        {
+            continue;
+        }
+
+        u32string   dst32(src.size(), 0);
+        u16string   dst16(src.size(), 0);
+
+        dst32.resize(max<ptrdiff_t>(0, UtfUtils::AutoConvert(pSrc, pSrc + src.size(), &dst32[0])));
+        dst16.resize(max<ptrdiff_t>(0, UtfUtils::AutoConvert(pSrc, pSrc + src.size(), &dst16[0])));
+
+        if (dst32 != utf32  ||  dst16 != utf16)
+        {
+            printf("error: automatic conversion of %s differs from SseConvert()\n", get<0>(test));
+            good = false;
+        }
+    }
+
+    //- Malformed UTF-16/UTF-32 must be rejected.
+    //
+    vector<string>  bad =
+    {
+        string("\xFF\xFE" "A\0" "\x00\xD8" "B\0", 8),       //- UTF-16LE, unpaired high surrogate
+        string("\xFE\xFF" "\xDC\x00" "\0A", 6),             //- UTF-16BE, unpaired low surrogate
+        string("\xFF\xFE" "A\0" "B", 5),                    //- UTF-16LE, truncated code unit
+        string("\xFF\xFE\0\0" "\x00\x00\x11\x00", 8),       //- UTF-32LE, value above U+10FFFF
+        string("\0\0\xFE\xFF" "\x00\x00\xD8\x00", 8),       //- UTF-32BE, surrogate value
+    };
+
+    for (string const& src : bad)
+    {
+        char8_t const*  pSrc = (char8_t const*) src.data();
+        u32string       dst(src.size(), 0);
+
+        if (UtfUtils::AutoConvert(pSrc, pSrc + src.size(), &dst[0]) != -1)
+        {
+            printf("error: malformed input was not rejected by AutoConvert()\n");
+            good = false;
+        }
+    }
+
+    if (good)
+    {
+        printf("    ... no errors found\n");
+    }
+}
@@ -0,0 +1,311 @@
+#include "test_main.h"
+
+#if defined KEWB_PLATFORM_LINUX
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+using namespace std;
+using namespace uu;
+
+namespace {
+
+using ColdFn32 = ptrdiff_t (*)(char8_t const*, char8_t const*, char32_t*);
+using ColdFn16 = ptrdiff_t (*)(char8_t const*, char8_t const*, char16_t*);
+
+//--------------------------------------------------------------------------------------------------
+//  Class:      L1dMissCounter
+//
+//  Summary:    Counts user-space L1 data cache read misses for the calling thread, using the
+//              Linux perf_event_open() interface.  If the counter cannot be opened (no kernel
+//              support, perf_event_paranoid too strict, running in a VM without a PMU, or a
+//              non-Linux platform), valid() returns false and all reads return zero.
+//--------------------------------------------------------------------------------------------------
+//
+class L1dMissCounter
+{
+  public:
+    L1dMissCounter();
+    ~L1dMissCounter();
+
+    bool        valid() const       { return m_fd >= 0; }
+    char const* reason() const      { return m_reason.c_str(); }
+
+    void        start();
+    uint64_t    stop();
+
+  private:
+    int         m_fd;
+    string      m_reason;
+};
+
+#if defined KEWB_PLATFORM_LINUX
+
+L1dMissCounter::L1dMissCounter()
+:   m_fd(-1)
+{
+    perf_event_attr     attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HW_CACHE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_L1D
+                        | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                        | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    m_fd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+    if (m_fd < 0)
+    {
+        m_reason = strerror(errno);
+    }
+}
+
+L1dMissCounter::~L1dMissCounter()
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+}
+
+void
+L1dMissCounter::start()
+{
+    if (m_fd >= 0)
+    {
+        ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+uint64_t
+L1dMissCounter::stop()
+{
+    uint64_t    count = 0;
+
+    if (m_fd >= 0)
+    {
+        ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+
+        if (read(m_fd, &count, sizeof(count)) != (ssize_t) sizeof(count))
+        {
+            count = 0;
+        }
+    }
+    return count;
+}
+
+#else
+
+L1dMissCounter::L1dMissCounter()
+:   m_fd(-1)
+,   m_reason("perf_event_open() is only available on Linux")
+{}
+
+L1dMissCounter::~L1dMissCounter()
+{}
+
+void
+L1dMissCounter::start()
+{}
+
+uint64_t
+L1dMissCounter::stop()
+{
+    return 0;
+}
+
+#endif
+
+//--------------------------------------------------------------------------------------------------
+//  Class:      CachePolluter
+//
+//  Summary:    A cache-polluting workload.  Each call to pollute() reads and writes one byte in
+//              every cache line of a buffer of the configured size, which (for a buffer larger
+//              than the cache level of interest) evicts the converters' lookup tables and code
+//              data along with everything else.  A size of zero makes pollute() a no-op, which
+//              gives the hot-cache baseline.
+//--------------------------------------------------------------------------------------------------
+//
+class CachePolluter
+{
+  public:
+    explicit CachePolluter(size_t bytes) : m_buf(bytes, 0), m_sum(0) {}
+
+    void        pollute();
+    uint64_t    checksum() const    { return m_sum; }
+
+  private:
+    vector<uint8_t>     m_buf;
+    uint64_t            m_sum;
+};
+
+void
+CachePolluter::pollute()
+{
+    for (size_t i = 0;  i < m_buf.size();  i += 64)
+    {
+        m_sum   += m_buf[i];
+        m_buf[i] = (uint8_t) m_sum;
+    }
+}
+
+//--------------
+//
+struct ColdResult
+{
+    double  mNanosPerCall;
+    double  mMissesPerCall;
+};
+
+//- Converts `chunks` one at a time, polluting the cache before each conversion, and measures
+//  only the conversions themselves.
+//
+template<class CharT, class FnT>
+ColdResult
+TimeColdCalls(FnT fn, vector<string> const& chunks, size_t reps, CachePolluter& polluter,
+              L1dMissCounter& counter)
+{
+    using clock = chrono::steady_clock;
+
+    basic_string<CharT>     dst;
+    int64_t                 nanos  = 0;
+    uint64_t                misses = 0;
+    size_t                  calls  = 0;
+
+    for (size_t r = 0;  r < reps;  ++r)
+    {
+        string const&   chunk = chunks[r % chunks.size()];
+        char8_t const*  pSrc  = (char8_t const*) chunk.data();
+
+        dst.resize(chunk.size() + 16);
+        polluter.pollute();
+
+        counter.start();
+        clock::time_point   start = clock::now();
+        fn(pSrc, pSrc + chunk.size(), &dst[0]);
+        clock::time_point   finish = clock::now();
+        misses += counter.stop();
+
+        nanos += chrono::duration_cast<chrono::nanoseconds>(finish - start).count();
+        ++calls;
+    }
+
+    return ColdResult{ (double) nanos / calls, (double) misses / calls };
+}
+
+//- Splits the input into chunks of at most `chunkLen` octets, breaking only at code point
+//  boundaries so that every chunk is valid UTF-8 on its own.
+//
+vector<string>
+MakeChunks(string const& src, size_t chunkLen)
+{
+    vector<string>  chunks;
+    size_t          from = 0;
+
+    while (from < src.size())
+    {
+        size_t  to = min(from + chunkLen, src.size());
+
+        while (to < src.size()  &&  to > from + 1  &&  (((uchar) src[to]) & 0xC0) == 0x80)
+        {
+            --to;
+        }
+        chunks.emplace_back(src, from, to - from);
+        from = to;
+    }
+    return chunks;
+}
+
+}   //- anonymous namespace
+
+//--------------------------------------------------------------------------------------------------
+//  Compares the big- and small-table converters under cache-cold conditions.  Each input file is
+//  split into chunks of `chunkLen` octets; each timed call converts one chunk, and (in the cold
+//  columns) is preceded by a pass over a `pollKB` KB pollution buffer.  The same measurement is
+//  then repeated without pollution, for comparison with the hot-cache numbers from -tct.
+//
+void
+TestColdCache(string const& dataDir, file_list const& files, size_t pollKB, size_t chunkLen, size_t reps)
+{
+    struct Named32 { char const* mName; ColdFn32 mFn; };
+    struct Named16 { char const* mName; ColdFn16 mFn; };
+
+    Named32 const   conv32[] =
+    {
+        { "kewb-basic-small-table", UtfUtils::BasicSmallTableConvert },
+        { "kewb-basic-big-table",   UtfUtils::BasicBigTableConvert   },
+        { "kewb-fast-small-table",  UtfUtils::FastSmallTableConvert  },
+        { "kewb-fast-big-table",    UtfUtils::FastBigTableConvert    },
+        { "kewb-sse-small-table",   UtfUtils::SseSmallTableConvert   },
+        { "kewb-sse-big-table",     UtfUtils::SseBigTableConvert     },
+    };
+    Named16 const   conv16[] =
+    {
+        { "kewb-basic-small-table", UtfUtils::BasicSmallTableConvert },
+        { "kewb-basic-big-table",   UtfUtils::BasicBigTableConvert   },
+        { "kewb-fast-small-table",  UtfUtils::FastSmallTableConvert  },
+        { "kewb-fast-big-table",    UtfUtils::FastBigTableConvert    },
+        { "kewb-sse-small-table",   UtfUtils::SseSmallTableConvert   },
+        { "kewb-sse-big-table",     UtfUtils::SseBigTableConvert     },
+    };
+
+    L1dMissCounter  counter;
+    CachePolluter   cold(pollKB * 1024);
+    CachePolluter   hot(0);
+
+    printf("\n******  Cache-Cold Lookup Table Comparison  ******\n");
+    printf("\npollution buffer: %zu KB,  chunk length: %zu octets,  calls per converter: %zu\n",
+           pollKB, chunkLen, reps);
+
+    if (!counter.valid())
+    {
+        printf("L1D miss counter unavailable (%s); reporting times only\n", counter.reason());
+    }
+
+    for (auto const& fname : files)
+    {
+        string          src(LoadFile(MakeFilePath(dataDir, fname)));
+        vector<string>  chunks;
+
+        if (src.size() == 0)
+        {
+            printf("\nfile '%s' is non-existent or empty\n", fname.c_str());
+            continue;
+        }
+        chunks = MakeChunks(src, max<size_t>(chunkLen, 4));
+
+        printf("\nfor file: '%s' (%zu chunks)\n", fname.c_str(), chunks.size());
+        printf("    %-8s %-24s %14s %14s %14s %14s\n", "output", "converter",
+               "cold ns/call", "cold L1D/call", "hot ns/call", "hot L1D/call");
+
+        for (auto const& conv : conv32)
+        {
+            ColdResult  c = TimeColdCalls<char32_t>(conv.mFn, chunks, reps, cold, counter);
+            ColdResult  h = TimeColdCalls<char32_t>(conv.mFn, chunks, reps, hot, counter);
+
+            printf("    %-8s %-24s %14.0f %14.1f %14.0f %14.1f\n", "UTF-32", conv.mName,
+                   c.mNanosPerCall, c.mMissesPerCall, h.mNanosPerCall, h.mMissesPerCall);
+        }
+        for (auto const& conv : conv16)
+        {
+            ColdResult  c = TimeColdCalls<char16_t>(conv.mFn, chunks, reps, cold, counter);
+            ColdResult  h = TimeColdCalls<char16_t>(conv.mFn, chunks, reps, hot, counter);
+
+            printf("    %-8s %-24s %14.0f %14.1f %14.0f %14.1f\n", "UTF-16", conv.mName,
+                   c.mNanosPerCall, c.mMissesPerCall, h.mNanosPerCall, h.mMissesPerCall);
+        }
+        fflush(stdout);
+    }
+
+    //- Print the checksum so that the pollution workload cannot be optimized away.
+    //
+    printf("\n(pollution checksum %llu)\n", (unsigned long long) cold.checksum());
+}
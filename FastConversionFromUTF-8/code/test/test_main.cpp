@@ -2,98 +2,8 @@
 
 using namespace std;
 
-#if defined KEWB_PLATFORM_LINUX
-    #define KEWB_PATH_SEP   '/'
-#elif defined KEWB_PLATFORM_WINDOWS
-    #define KEWB_PATH_SEP   '\\'
-#endif
-
-
 //--------------
 //
-vector<string>
-LoadFileLines(string const& filename)
-{
-    string          line;
-    vector<string>  lines;
-    ifstream        in(filename, ios::in | ios::binary);
-
-    lines.reserve(1000);
-
-    if (in)
-    {
-        while (!in.eof())
-        {
-            getline(in, line);
-            if (line.size() > 0)
-            {
-                lines.push_back(line);
-            }
-        }
-        in.close();
-    }
-    return lines;
-}
-
-string
-LoadFile(string const& filename)
-{
-    string      line;
-    ifstream    in(filename, ios::in | ios::binary);
-
-    if (in)
-    {
-        in.seekg(0, ios_base::end);
-        line.resize((size_t) in.tellg());   //- Cast is there to make 32-bit Windows happy
-        in.seekg(0, ios_base::beg);
-        in.read(&line[0], line.size());
-        in.close();
-    }
-    return line;
-}
-
-string
-MakeFilePath(std::string const& dir, std::string const& filename)
-{
-    string  path;
-
-    if (dir.size() > 0)
-    {
-        path.assign(dir);
-
-        if (path.back() != KEWB_PATH_SEP)
-        {
-            path.append(1u, KEWB_PATH_SEP);
-        }
-    }
-    path.append(filename);
-
-    return path;
-}
-
-void
-MakeFileList(file_list& files)
-{
-    files.clear();
-
-    files.emplace_back("english_wiki.txt");
-    files.emplace_back("chinese_wiki.txt");
-    files.emplace_back("hindi_wiki.txt");
-    files.emplace_back("japanese_wiki.txt");
-    files.emplace_back("korean_wiki.txt");
-    files.emplace_back("portuguese_wiki.txt");
-    files.emplace_back("russian_wiki.txt");
-    files.emplace_back("swedish_wiki.txt");
-    files.emplace_back("stress_test_0.txt");
-    files.emplace_back("stress_test_1.txt");
-    files.emplace_back("stress_test_2.txt");
-    files.emplace_back("hindi_wiki_in_english.txt");
-    files.emplace_back("hindi_wiki_in_russian.txt");
-    files.emplace_back("kermit.txt");
-    files.emplace_back("z1_kosme.txt");
-    files.emplace_back("z1_ascii.txt");
-}
-
 void
 PrintHelp()
 {
@@ -104,6 +14,10 @@ PrintHelp()
     printf("  -t16            Run UTF-8 to UTF-16 conversion tests\n");
     printf("  -t32            Run UTF-8 to UTF-32 conversion tests\n");
     printf("  -tct            Run big -vs- small lookup table comparison tests\n");
+    printf("  -tcc            Run big -vs- small lookup table comparison tests with cold caches\n");
+    printf("  -pk <KB>        Size of the cache-polluting buffer used by -tcc (default 1024)\n");
+    printf("  -cl <octets>    Length of the input chunk converted per call by -tcc (default 4096)\n");
+    printf("  -cr <calls>     Number of calls per converter made by -tcc (default 2000)\n");
     printf("  -tm             Run miscellaneous conformance tests\n");
 }
 
@@ -118,6 +32,10 @@ int main(int argc, char* argv[])
     bool        test32     = false;
     bool        test16     = false;
     bool        testTblCmp = false;
+    bool        testCold   = false;
+    size_t      pollKB     = 1024;
+    size_t      chunkLen   = 4096;
+    size_t      coldReps   = 2000;
     file_list   files;
 
     for (int i = 1;  i < argc;  ++i)
@@ -154,6 +72,31 @@ int main(int argc, char* argv[])
         {
             testTblCmp = true;
         }
+        else if (arg == "-tcc")
+        {
+            testCold = true;
+        }
+        else if (arg == "-pk")
+        {
+            if (++i < argc)
+            {
+                pollKB = (size_t) std::max(atoi(argv[i]), 0);
+            }
+        }
+        else if (arg == "-cl")
+        {
+            if (++i < argc)
+            {
+                chunkLen = (size_t) std::max(atoi(argv[i]), 1);
+            }
+        }
+        else if (arg == "-cr")
+        {
+            if (++i < argc)
+            {
+                coldReps = (size_t) std::max(atoi(argv[i]), 1);
+            }
+        }
         else if (arg == "-h")
         {
             PrintHelp();
@@ -161,16 +104,19 @@ int main(int argc, char* argv[])
         }
     }
 
-    testAll = !testMisc && !test32 && !test16;
+    testAll = !testMisc && !test32 && !test16 && !testCold;
 
     if (testAll || testMisc)
     {
         TestTrace();
         TestBadSequences();
         TestRoundTripping();
+        TestStats();
+        TestByteOrder();
+        TestDetectEncoding();
     }
 
-    if (testAll || test32 || test16)
+    if (testAll || test32 || test16 || testCold)
     {
         MakeFileList(files);
     }
@@ -184,6 +130,11 @@ int main(int argc, char* argv[])
     {
         TestFiles16(dataDir, repShift, files, testTblCmp);
     }
+
+    if (testCold)
+    {
+        TestColdCache(dataDir, files, pollKB, chunkLen, coldReps);
+    }
     return 0;
 }
 
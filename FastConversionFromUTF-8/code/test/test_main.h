@@ -46,7 +46,11 @@ void            MakeFileList(file_list& files);
 void    TestTrace();
 void    TestBadSequences();
 void    TestRoundTripping();
+void    TestStats();
+void    TestByteOrder();
+void    TestDetectEncoding();
 void    TestFiles16(std::string const& dataDir, size_t repShift, file_list const& files, bool tblCmp);
 void    TestFiles32(std::string const& dataDir, size_t repShift, file_list const& files, bool tblCmp);
+void    TestColdCache(std::string const& dataDir, file_list const& files, size_t pollKB, size_t chunkLen, size_t reps);
 
 #endif  //- TEST_MAIN_H_DEFINED